@@ -0,0 +1,93 @@
+/**
+ * @file bench_adaa.cpp
+ * @author Piotr Zapart
+ * @brief Guitar booster aliasing with and without the ADAA waveshaper
+ * 			Plain and ADAA shaper at 1x, 2x, 4x and 8x oversampling, drive 0.8,
+ * 			a 2.5kHz sine with the octave off and a 1.2kHz sine with the octave on.
+ * 			Prints the aliasing (energy outside the harmonics relative to the total)
+ * 			and the time per audio block.
+ * 			Checks:
+ * 				- ADAA aliases less than the plain shaper at the same factor
+ * 				- ADAA at 2x aliases less than the plain shaper at 4x
+ * 				- ADAA at 1x is not worse than the plain shaper at 2x (+1dB)
+ *
+ * 			usage: bench_adaa [audio blocks, default 5000]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "effect_guitarBooster_F32.h"
+
+#define REC_BLOCKS		(200)		// analysed record, after the same number of settling blocks
+#define REC_LEN			(REC_BLOCKS * AUDIO_BLOCK_SAMPLES)
+#define FACTORS			(4)
+
+static const uint8_t factors[FACTORS] = {1, 2, 4, 8};
+static float32_t rec[REC_LEN];
+
+/**
+ * @brief sine through the booster, returns the aliasing in dB, time per block in ns
+ */
+static double run(bool adaa, uint8_t f, bool octave, float32_t f0, uint32_t blocks, double *ns)
+{
+	AudioEffectGuitarBooster_F32 *fx = new AudioEffectGuitarBooster_F32;
+	fx->bypass_setFade(1);
+	fx->bypass_set(false);
+	fx->octave_set(octave);
+	fx->drive_normalized(0.8f);
+	fx->tone(1.0f);
+	fx->oversample(f);
+	fx->adaa_set(adaa);
+	float32_t in[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0;
+	uint64_t t = 0, t0;
+	blocks = max(blocks, (uint32_t)(2 * REC_BLOCKS));
+	for (uint32_t b = 0; b < blocks; b++)
+	{
+		host_sine(in, AUDIO_BLOCK_SAMPLES, f0, 0.4f, ph);
+		host_feed(*fx, 0, in);
+		host_feed(*fx, 1, in);
+		t0 = host_time_ns();
+		fx->update();
+		t += host_time_ns() - t0;
+		audio_block_f32_t *out = fx->host_output(0);
+		fx->host_output(1);
+		if (out && b >= REC_BLOCKS && b < 2 * REC_BLOCKS)
+			memcpy(&rec[(b - REC_BLOCKS) * AUDIO_BLOCK_SAMPLES], out->data, sizeof(in));
+	}
+	*ns = (double)t / blocks;
+	delete fx;
+	return host_alias_dB(rec, REC_LEN, f0);
+}
+
+static void compare(float32_t f, bool octave, uint32_t blocks)
+{
+	const float32_t f0 = host_bin_freq(f, REC_LEN);
+	double plain[FACTORS], adaa[FACTORS], ns;
+	printf("  %.1fHz, octave %s\n", f0, octave ? "on" : "off");
+	for (uint8_t a = 0; a < 2; a++)
+	{
+		for (uint8_t i = 0; i < FACTORS; i++)
+		{
+			double *res = a ? adaa : plain;
+			res[i] = run(a, factors[i], octave, f0, blocks, &ns);
+			printf("    %s %ux  alias %6.1f dB  %6.0f ns/block\n", a ? "ADAA " : "plain", factors[i], res[i], ns);
+		}
+	}
+	for (uint8_t i = 0; i < FACTORS; i++)
+		HOST_CHECK(adaa[i] < plain[i], "%.0fHz %ux: ADAA %.1f dB, plain %.1f dB", f, factors[i], adaa[i], plain[i]);
+	HOST_CHECK(adaa[1] < plain[2], "%.0fHz: ADAA 2x %.1f dB, plain 4x %.1f dB", f, adaa[1], plain[2]);
+	HOST_CHECK(adaa[0] < plain[1] + 1.0, "%.0fHz: ADAA 1x %.1f dB, plain 2x %.1f dB", f, adaa[0], plain[1]);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t blocks = argc > 1 ? atoi(argv[1]) : 5000;
+	printf("bench_adaa: %u blocks\n", blocks);
+	compare(2500.0f, false, blocks);
+	compare(1200.0f, true, blocks);
+	return host_result("bench_adaa");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file bench_chain.cpp
+ * @author Piotr Zapart
+ * @brief AudioEffectChain_F32 vs. the same effects connected with patch cords
+ * 			booster -> tone stack -> delay -> plate reverb, run as a chain and
+ * 			as a patch cord graph on the host block pool. Prints the time per
+ * 			audio block, the max. number of audio blocks in use and the chain's
+ * 			per stage usage. The outputs of both have to be identical.
+ * 			There is no measured saving for a linear rig: these effects already
+ * 			process the received blocks in place and transmit them, so the patch
+ * 			cord graph uses the same 2 audio blocks and about the same time as the
+ * 			chain. The check below only confirms the chain costs no extra blocks,
+ * 			its use is the runtime reordering and per stage usage.
+ *
+ * 			usage: bench_chain [audio blocks, default 20000]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "effect_chain_F32.h"
+#include "effect_guitarBooster_F32.h"
+#include "filter_tonestackStereo_F32.h"
+#include "effect_delaystereo_F32.h"
+#include "effect_platereverb_F32.h"
+
+class Rig
+{
+public:
+	Rig()
+	{
+		boost.bypass_set(false);
+		tone.setModel(TONESTACK_MESA);
+		tone.bypass_set(false);
+		dly.bypass_set(false);
+		dly.mix(0.4f);
+		reverb.bypass_set(false);
+		reverb.mix(0.3f);
+	}
+	AudioEffectGuitarBooster_F32 boost;
+	AudioFilterToneStackStereo_F32 tone;
+	AudioEffectDelayStereo_F32 dly;
+	AudioEffectPlateReverb_F32 reverb;
+};
+
+static const char *stage_name[] = {"booster", "tone stack", "delay", "plate reverb"};
+
+int main(int argc, char **argv)
+{
+	uint32_t blocks = argc > 1 ? atoi(argv[1]) : 20000;
+	printf("bench_chain: %u blocks\n", blocks);
+
+	Rig *a = new Rig, *b = new Rig;
+	AudioEffectChain_F32 chain;
+	chain.add(a->boost);
+	chain.add(a->tone);
+	chain.add(a->dly);
+	chain.add(a->reverb);
+	AudioConnection_F32 c0(b->boost, 0, b->tone, 0);
+	AudioConnection_F32 c1(b->boost, 1, b->tone, 1);
+	AudioConnection_F32 c2(b->tone, 0, b->dly, 0);
+	AudioConnection_F32 c3(b->tone, 1, b->dly, 1);
+	AudioConnection_F32 c4(b->dly, 0, b->reverb, 0);
+	AudioConnection_F32 c5(b->dly, 1, b->reverb, 1);
+	// the chain stages are not connected, update() is called explicitly instead of update_all()
+	AudioStream_F32 *graph[] = {&b->boost, &b->tone, &b->dly, &b->reverb};
+
+	float32_t inL[AUDIO_BLOCK_SAMPLES], inR[AUDIO_BLOCK_SAMPLES];
+	double phL = 0.0, phR = 0.0;
+	uint64_t t0, t_chain = 0, t_graph = 0;
+	uint32_t blocks_chain = 0, blocks_graph = 0, mismatch = 0, missing = 0;
+
+	for (uint32_t blk = 0; blk < blocks; blk++)
+	{
+		if (blk == 100) chain.stage_usageMaxReset();	// skip the cold start
+		host_sine(inL, AUDIO_BLOCK_SAMPLES, 110.0f, 0.5f, phL);
+		host_sine(inR, AUDIO_BLOCK_SAMPLES, 165.0f, 0.3f, phR);
+
+		AudioStream_F32::host_blocksMaxReset();
+		uint32_t used = AudioStream_F32::host_blocksUsed();
+		host_feed(chain, 0, inL);
+		host_feed(chain, 1, inR);
+		t0 = host_time_ns();
+		chain.update();
+		t_chain += host_time_ns() - t0;
+		if (AudioStream_F32::host_blocksMax() - used > blocks_chain) blocks_chain = AudioStream_F32::host_blocksMax() - used;
+		float32_t outL[AUDIO_BLOCK_SAMPLES], outR[AUDIO_BLOCK_SAMPLES];
+		audio_block_f32_t *oL = chain.host_output(0), *oR = chain.host_output(1);
+		if (!oL || !oR) { missing++; continue; }
+		memcpy(outL, oL->data, sizeof(outL));
+		memcpy(outR, oR->data, sizeof(outR));
+
+		AudioStream_F32::host_blocksMaxReset();
+		used = AudioStream_F32::host_blocksUsed();
+		host_feed(b->boost, 0, inL);
+		host_feed(b->boost, 1, inR);
+		t0 = host_time_ns();
+		for (uint32_t s = 0; s < 4; s++) graph[s]->update();
+		t_graph += host_time_ns() - t0;
+		if (AudioStream_F32::host_blocksMax() - used > blocks_graph) blocks_graph = AudioStream_F32::host_blocksMax() - used;
+		oL = b->reverb.host_output(0);
+		oR = b->reverb.host_output(1);
+		if (!oL || !oR) { missing++; continue; }
+		mismatch += memcmp(outL, oL->data, sizeof(outL)) != 0 || memcmp(outR, oR->data, sizeof(outR)) != 0;
+	}
+	printf("  chain        %7.0f ns/block, max. %u audio blocks\n", (double)t_chain / blocks, blocks_chain);
+	printf("  patch cords  %7.0f ns/block, max. %u audio blocks\n", (double)t_graph / blocks, blocks_graph);
+	for (uint8_t s = 0; s < chain.stages(); s++)
+		printf("    stage %u %-14s %5.2f%% (max. %5.2f%%)\n", s, stage_name[s], chain.stage_usage(s), chain.stage_usageMax(s));
+	HOST_CHECK(missing == 0, "%u blocks without output", missing);
+	HOST_CHECK(mismatch == 0, "%u output blocks differ", mismatch);
+	// in place effects on both sides: same block count, no saving expected
+	HOST_CHECK(blocks_chain == blocks_graph, "audio blocks differ, chain %u, patch cords %u", blocks_chain, blocks_graph);
+
+	return host_result("bench_chain");
+}
@@ -0,0 +1,113 @@
+/**
+ * @file bench_hermite.cpp
+ * @author Piotr Zapart
+ * @brief AudioBasicDelay::getTapHermite() read throughput
+ * 			Reference is the previous implementation with four modulo wrapped
+ * 			reads, compared with the guard area (compare based wrap) and the
+ * 			power of two (mask based wrap) modes. Results have to be bit exact.
+ *
+ * 			usage: bench_hermite [million reads, default 20]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "basic_delay.h"
+
+#define DELAY_SIZE		(32768)		// already a power of two, both modes use the same length
+#define READS_BLOCK		(4096)
+
+/**
+ * @brief previous getTapHermite(), each sample index wrapped with a modulo
+ */
+static inline float hermite_modulo(const float *bf, int32_t idx, int32_t size, float delay)
+{
+	int32_t delay_integral   = static_cast<int32_t>(delay);
+	float   delay_fractional = delay - static_cast<float>(delay_integral);
+
+	int32_t     t     = (idx + delay_integral + size);
+	const float     xm1   = bf[(t - 1) % size];
+	const float     x0    = bf[(t) % size];
+	const float     x1    = bf[(t + 1) % size];
+	const float     x2    = bf[(t + 2) % size];
+	const float c     = (x1 - xm1) * 0.5f;
+	const float v     = x0 - x1;
+	const float w     = c + v;
+	const float a     = w + v + (x2 - x0) * 0.5f;
+	const float b_neg = w + a;
+	const float f     = delay_fractional;
+	return (((a * f) - b_neg) * f + c) * f + x0;
+}
+
+static volatile float sink;
+
+int main(int argc, char **argv)
+{
+	uint32_t reads = (argc > 1 ? atoi(argv[1]) : 20) * 1000000u;
+	reads = (reads / READS_BLOCK + 1) * READS_BLOCK;
+	printf("bench_hermite: %u reads, delay size %u\n", reads, DELAY_SIZE);
+
+	AudioBasicDelay dly, dly_p2;
+	HOST_CHECK(dly.init(DELAY_SIZE, false, false), "alloc");
+	HOST_CHECK(dly_p2.init(DELAY_SIZE, false, true), "alloc pow2");
+	HOST_CHECK(dly_p2.isPow2() && dly_p2.getSize() == DELAY_SIZE, "pow2 size %u", dly_p2.getSize());
+
+	// random content, write index moved away from 0 to exercise both wrap directions
+	float32_t blk[AUDIO_BLOCK_SAMPLES];
+	const uint32_t blocks = DELAY_SIZE / AUDIO_BLOCK_SAMPLES + 7;
+	for (uint32_t b = 0; b < blocks; b++)
+	{
+		for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) blk[i] = (float32_t)rand() / RAND_MAX - 0.5f;
+		dly.writeBlock(blk, AUDIO_BLOCK_SAMPLES);
+		dly_p2.writeBlock(blk, AUDIO_BLOCK_SAMPLES);
+	}
+	const int32_t idx = (blocks * AUDIO_BLOCK_SAMPLES) % DELAY_SIZE;
+	const float *bf = dly.getBuffer();
+	volatile int32_t size_rt = dly.getSize();	// runtime value, no constant folded modulo
+	const int32_t size = size_rt;
+
+	// modulated read positions: slow sweep over the whole range + fast wobble
+	static float pos[READS_BLOCK];
+	for (uint32_t i = 0; i < READS_BLOCK; i++)
+	{
+		float p = (DELAY_SIZE - 3) * (0.5f + 0.49f * sinf(i * 0.0015f)) + 20.0f * sinf(i * 0.37f);
+		if (p < 0.0f) p = 0.0f;
+		pos[i] = p;
+	}
+	pos[0] = 0.0f;
+	pos[1] = DELAY_SIZE - 1.5f;
+
+	uint32_t mismatch = 0, mismatch_p2 = 0;
+	for (uint32_t i = 0; i < READS_BLOCK; i++)
+	{
+		float ref = hermite_modulo(bf, idx, size, pos[i]);
+		mismatch += dly.getTapHermite(pos[i]) != ref;
+		mismatch_p2 += dly_p2.getTapHermite(pos[i]) != ref;
+	}
+	HOST_CHECK(mismatch == 0, "guard mode: %u reads differ from the reference", mismatch);
+	HOST_CHECK(mismatch_p2 == 0, "pow2 mode: %u reads differ from the reference", mismatch_p2);
+
+	uint64_t t0, t_mod, t_guard, t_p2;
+	float acc = 0.0f;
+	t0 = host_time_ns();
+	for (uint32_t n = 0; n < reads; n += READS_BLOCK)
+		for (uint32_t i = 0; i < READS_BLOCK; i++) acc += hermite_modulo(bf, idx, size, pos[i]);
+	t_mod = host_time_ns() - t0;
+	t0 = host_time_ns();
+	for (uint32_t n = 0; n < reads; n += READS_BLOCK)
+		for (uint32_t i = 0; i < READS_BLOCK; i++) acc += dly.getTapHermite(pos[i]);
+	t_guard = host_time_ns() - t0;
+	t0 = host_time_ns();
+	for (uint32_t n = 0; n < reads; n += READS_BLOCK)
+		for (uint32_t i = 0; i < READS_BLOCK; i++) acc += dly_p2.getTapHermite(pos[i]);
+	t_p2 = host_time_ns() - t0;
+	sink = acc;
+
+	printf("  modulo (reference) %6.2f ns/read\n", (double)t_mod / reads);
+	printf("  guard              %6.2f ns/read  x%.2f\n", (double)t_guard / reads, (double)t_mod / t_guard);
+	printf("  pow2 mask          %6.2f ns/read  x%.2f\n", (double)t_p2 / reads, (double)t_mod / t_p2);
+
+	return host_result("bench_hermite");
+}
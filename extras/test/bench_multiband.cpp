@@ -0,0 +1,125 @@
+/**
+ * @file bench_multiband.cpp
+ * @author Piotr Zapart
+ * @brief AudioEffectCompressorMultibandStereo_F32 per band CPU load
+ * 			3 and 4 bands, time per audio block and the band_usage() readouts
+ * 			(split + compressor per band) with a loud two tone signal.
+ * 			Sanity checks:
+ * 				- ratio 1 in all bands: sine gain flat within 0.05dB (crossovers
+ * 				  sum to an allpass)
+ * 				- loud low tone: only the lowest band compresses
+ * 				- the band usages add up to no more than the measured block time
+ *
+ * 			usage: bench_multiband [audio blocks, default 20000]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "effect_compressorMultibandStereo_F32.h"
+
+static const float32_t flat_f[] = {50.0f, 150.0f, 400.0f, 1000.0f, 2500.0f, 6000.0f, 12000.0f};
+
+/**
+ * @brief steady state sine gain in dB, ratio 1 in all bands
+ */
+static float32_t sine_gain_dB(uint8_t bands, float32_t f)
+{
+	AudioEffectCompressorMultibandStereo_F32 fx(bands);
+	for (uint8_t b = 0; b < bands; b++) fx.ratio(b, 1.0f);
+	fx.bypass_setFade(0);
+	fx.bypass_set(false);
+	float32_t l[AUDIO_BLOCK_SAMPLES], r[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0, e_in = 0.0, e_out = 0.0;
+	for (uint32_t blk = 0; blk < 800; blk++)
+	{
+		host_sine(l, AUDIO_BLOCK_SAMPLES, f, 0.25f, ph);
+		memcpy(r, l, sizeof(l));
+		if (blk >= 400)
+			for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) e_in += l[i] * l[i];
+		fx.process(l, r, AUDIO_BLOCK_SAMPLES);
+		if (blk >= 400)
+			for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) e_out += l[i] * l[i];
+	}
+	return 10.0f * log10f(e_out / e_in);
+}
+
+static void run(uint8_t bands, uint32_t blocks)
+{
+	float32_t g, g_min = 100.0f, g_max = -100.0f;
+	for (uint32_t i = 0; i < sizeof(flat_f) / sizeof(flat_f[0]); i++)
+	{
+		g = sine_gain_dB(bands, flat_f[i]);
+		if (g < g_min) g_min = g;
+		if (g > g_max) g_max = g;
+	}
+	HOST_CHECK(fabsf(g_min) < 0.05f && fabsf(g_max) < 0.05f, "%u bands: ratio 1 gain %.3f...%.3f dB", bands, g_min, g_max);
+
+	AudioEffectCompressorMultibandStereo_F32 fx(bands);
+	for (uint8_t b = 0; b < bands; b++)
+	{
+		fx.threshold(b, -30.0f);
+		fx.ratio(b, 4.0f);
+	}
+	fx.bypass_setFade(0);
+	fx.bypass_set(false);
+
+	// loud low tone only
+	float32_t inL[AUDIO_BLOCK_SAMPLES], inR[AUDIO_BLOCK_SAMPLES], tmp[AUDIO_BLOCK_SAMPLES];
+	double phL = 0.0, phR = 0.0;
+	for (uint32_t blk = 0; blk < 400; blk++)
+	{
+		host_sine(inL, AUDIO_BLOCK_SAMPLES, 60.0f, 0.5f, phL);
+		memcpy(inR, inL, sizeof(inL));
+		fx.process(inL, inR, AUDIO_BLOCK_SAMPLES);
+	}
+	HOST_CHECK(fx.gain_reduction_dB(0) < -6.0f, "%u bands: low band gain reduction %.2f dB", bands, fx.gain_reduction_dB(0));
+	for (uint8_t b = 1; b < bands; b++)
+		HOST_CHECK(fx.gain_reduction_dB(b) > -0.5f, "%u bands: band %u gain reduction %.2f dB", bands, b, fx.gain_reduction_dB(b));
+
+	// timing, low + high tone
+	double usage[COMPRESSOR_MB_MAX_BANDS] = {0.0};
+	uint64_t t = 0, t0;
+	phL = phR = 0.0;
+	for (uint32_t blk = 0; blk < blocks; blk++)
+	{
+		if (blk == 100) fx.band_usageMaxReset();	// skip the cold start
+		host_sine(inL, AUDIO_BLOCK_SAMPLES, 80.0f, 0.5f, phL);
+		host_sine(tmp, AUDIO_BLOCK_SAMPLES, 3000.0f, 0.3f, phR);
+		for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+		{
+			inR[i] = inL[i] - tmp[i];
+			inL[i] += tmp[i];
+		}
+		host_feed(fx, 0, inL);
+		host_feed(fx, 1, inR);
+		t0 = host_time_ns();
+		fx.update();
+		t += host_time_ns() - t0;
+		fx.host_output(0);
+		fx.host_output(1);
+		for (uint8_t b = 0; b < bands; b++) usage[b] += fx.band_usage(b);
+	}
+	// block time in percent of the audio block period, same as the usage readouts
+	float32_t usage_block = (double)t / blocks * 1e-7 * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES;
+	float32_t usage_sum = 0.0f;
+	printf("  %u bands  %7.0f ns/block  %5.2f%%\n", bands, (double)t / blocks, usage_block);
+	for (uint8_t b = 0; b < bands; b++)
+	{
+		usage_sum += usage[b] / blocks;
+		printf("    band %u  %5.2f%% (max. %5.2f%%)  gain reduction %6.2f dB\n",
+			b, usage[b] / blocks, fx.band_usageMax(b), fx.gain_reduction_dB(b));
+	}
+	HOST_CHECK(usage_sum <= usage_block * 1.05f + 0.1f, "%u bands: band usage sum %.2f%% > block %.2f%%", bands, usage_sum, usage_block);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t blocks = argc > 1 ? atoi(argv[1]) : 20000;
+	printf("bench_multiband: %u blocks\n", blocks);
+	run(3, blocks);
+	run(4, blocks);
+	return host_result("bench_multiband");
+}
@@ -0,0 +1,161 @@
+/**
+ * @file bench_oversampler.cpp
+ * @author Piotr Zapart
+ * @brief AudioBasicOversampler aliasing and time per oversampling factor
+ * 			For the factors 1, 2, 4 and 8:
+ * 				- oversampler alone: a 4.9kHz sine hard clipped at the high rate,
+ * 				  aliasing (energy outside the harmonics), time per up + down block
+ * 				- guitar booster: the same measurement through the whole effect
+ * 			Checks:
+ * 				- the aliasing goes down with each factor step
+ * 				- round trip gain flat within 0.01dB up to 15kHz
+ * 				- images of the upsampler below -75dB
+ *
+ * 			usage: bench_oversampler [audio blocks, default 20000]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "basic_oversampler.h"
+#include "effect_guitarBooster_F32.h"
+
+#define REC_BLOCKS		(200)		// analysed record, after the same number of settling blocks
+#define REC_LEN			(REC_BLOCKS * AUDIO_BLOCK_SAMPLES)
+#define TEST_F			(4900.0f)
+
+static const uint8_t factors[] = {1, 2, 4, 8};
+static const float32_t pass_f[] = {1000.0f, 10000.0f, 15000.0f};
+static float32_t rec[REC_LEN];
+static float32_t os_buf[OVERSAMPLE_MAX_FACTOR * REC_LEN];
+static AudioBasicOversampler<1> os;
+
+/**
+ * @brief hard clipped sine through the oversampler, returns the aliasing in dB
+ */
+static double os_alias_dB(uint8_t f, float32_t f0)
+{
+	float32_t blk[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0;
+	os.factor(f);
+	for (uint32_t b = 0; b < 2 * REC_BLOCKS; b++)
+	{
+		host_sine(blk, AUDIO_BLOCK_SAMPLES, f0, 0.9f, ph);
+		float32_t *p = os.up(blk, AUDIO_BLOCK_SAMPLES);
+		for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES * f; i++) p[i] = constrain(p[i] * 4.0f, -1.0f, 1.0f);
+		os.down(blk, AUDIO_BLOCK_SAMPLES);
+		if (b >= REC_BLOCKS) memcpy(&rec[(b - REC_BLOCKS) * AUDIO_BLOCK_SAMPLES], blk, sizeof(blk));
+	}
+	return host_alias_dB(rec, REC_LEN, f0);
+}
+
+/**
+ * @brief up + down round trip, returns the gain in dB at fr and the image level of the
+ * 		upsampled signal at fs - fr in dB
+ */
+static void os_passband(uint8_t f, float32_t fr, double *gain_dB, double *image_dB)
+{
+	float32_t blk[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0;
+	os.factor(f);
+	for (uint32_t b = 0; b < 2 * REC_BLOCKS; b++)
+	{
+		host_sine(blk, AUDIO_BLOCK_SAMPLES, fr, 0.5f, ph);
+		float32_t *p = os.up(blk, AUDIO_BLOCK_SAMPLES);
+		if (b >= REC_BLOCKS) memcpy(&os_buf[(b - REC_BLOCKS) * AUDIO_BLOCK_SAMPLES * f], p, AUDIO_BLOCK_SAMPLES * f * sizeof(float32_t));
+		os.down(blk, AUDIO_BLOCK_SAMPLES);
+		if (b >= REC_BLOCKS) memcpy(&rec[(b - REC_BLOCKS) * AUDIO_BLOCK_SAMPLES], blk, sizeof(blk));
+	}
+	*gain_dB = 20.0 * log10(host_dft(rec, REC_LEN, fr) / 0.5);
+	*image_dB = 20.0 * log10(host_dft(os_buf, REC_LEN * f, AUDIO_SAMPLE_RATE_EXACT - fr, AUDIO_SAMPLE_RATE_EXACT * f) / 0.5 + 1e-12);
+}
+
+static double os_time(uint8_t f, uint32_t blocks)
+{
+	float32_t blk[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0;
+	uint64_t t = 0, t0;
+	os.factor(f);
+	for (uint32_t b = 0; b < blocks; b++)
+	{
+		host_sine(blk, AUDIO_BLOCK_SAMPLES, 220.0f, 0.5f, ph);
+		t0 = host_time_ns();
+		os.up(blk, AUDIO_BLOCK_SAMPLES);
+		os.down(blk, AUDIO_BLOCK_SAMPLES);
+		t += host_time_ns() - t0;
+	}
+	return (double)t / blocks;
+}
+
+/**
+ * @brief sine through the booster, aliasing in dB and time per block
+ */
+static double booster_alias_dB(uint8_t f, float32_t f0, uint32_t blocks, double *ns)
+{
+	AudioEffectGuitarBooster_F32 *fx = new AudioEffectGuitarBooster_F32;
+	fx->bypass_setFade(1);
+	fx->bypass_set(false);
+	fx->drive_normalized(0.8f);
+	fx->tone(1.0f);
+	fx->oversample(f);
+	float32_t in[AUDIO_BLOCK_SAMPLES];
+	double ph = 0.0;
+	uint64_t t = 0, t0;
+	for (uint32_t b = 0; b < max(blocks, (uint32_t)(2 * REC_BLOCKS)); b++)
+	{
+		host_sine(in, AUDIO_BLOCK_SAMPLES, f0, 0.4f, ph);
+		host_feed(*fx, 0, in);
+		host_feed(*fx, 1, in);
+		t0 = host_time_ns();
+		fx->update();
+		t += host_time_ns() - t0;
+		audio_block_f32_t *out = fx->host_output(0);
+		fx->host_output(1);
+		if (out && b >= REC_BLOCKS && b < 2 * REC_BLOCKS)
+			memcpy(&rec[(b - REC_BLOCKS) * AUDIO_BLOCK_SAMPLES], out->data, sizeof(in));
+	}
+	*ns = (double)t / max(blocks, (uint32_t)(2 * REC_BLOCKS));
+	delete fx;
+	return host_alias_dB(rec, REC_LEN, f0);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t blocks = argc > 1 ? atoi(argv[1]) : 20000;
+	const float32_t f0 = host_bin_freq(TEST_F, REC_LEN);
+	double a, a_last = 0.0, ns, g, im;
+	printf("bench_oversampler: %u blocks, %.1fHz sine\n", blocks, f0);
+
+	printf("  oversampler, hard clip\n");
+	for (uint8_t i = 0; i < sizeof(factors); i++)
+	{
+		a = os_alias_dB(factors[i], f0);
+		ns = os_time(factors[i], blocks);
+		printf("    %ux  alias %6.1f dB  %6.0f ns/block (up + down)\n", factors[i], a, ns);
+		if (i) HOST_CHECK(a < a_last, "oversampler %ux: alias %.1f dB, %ux %.1f dB", factors[i], a, factors[i - 1], a_last);
+		a_last = a;
+	}
+	for (uint8_t i = 1; i < sizeof(factors); i++)
+	{
+		for (uint8_t j = 0; j < sizeof(pass_f) / sizeof(pass_f[0]); j++)
+		{
+			float32_t fr = pass_f[j];
+			os_passband(factors[i], host_bin_freq(fr, REC_LEN), &g, &im);
+			printf("    %ux  %5.0fHz gain %8.4f dB  image %6.1f dB\n", factors[i], fr, g, im);
+			HOST_CHECK(fabs(g) < 0.01, "oversampler %ux: gain %.4f dB at %.0fHz", factors[i], g, fr);
+			HOST_CHECK(im < -75.0, "oversampler %ux: image %.1f dB at %.0fHz", factors[i], im, fr);
+		}
+	}
+
+	printf("  guitar booster\n");
+	for (uint8_t i = 0; i < sizeof(factors); i++)
+	{
+		a = booster_alias_dB(factors[i], f0, blocks, &ns);
+		printf("    %ux  alias %6.1f dB  %6.0f ns/block\n", factors[i], a, ns);
+		if (i) HOST_CHECK(a < a_last, "booster %ux: alias %.1f dB, %ux %.1f dB", factors[i], a, factors[i - 1], a_last);
+		a_last = a;
+	}
+	return host_result("bench_oversampler");
+}
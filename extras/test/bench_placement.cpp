@@ -0,0 +1,129 @@
+/**
+ * @file bench_placement.cpp
+ * @author Piotr Zapart
+ * @brief Effects placed with new(ARENA_x) in each of the arena pools
+ * 			The phaser, IR cabsim and plate reverb are created in the RAM1, RAM2
+ * 			and PSRAM pools, checked for the placement and alignment and timed
+ * 			with the state in the cache (hot) and after evicting the cache before
+ * 			every block (cold). On the host all pools are the same memory, the
+ * 			hot/cold difference stands in for the placement cost on the target:
+ * 			DTCM is never cached, state in OCRAM/PSRAM pays for the cache misses.
+ * 			Objects are deleted with AudioBasicMemArena::destroy().
+ *
+ * 			usage: bench_placement [audio blocks, default 5000]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "basic_memArena.h"
+#include "effect_phaserStereo_F32.h"
+#include "filter_ir_cabsim_F32.h"
+#include "effect_platereverb_F32.h"
+
+#define EVICT_BYTES		(32u * 1024u * 1024u)	// larger than the host caches
+
+static uint8_t pool_mem[ARENA_POOLS][512 * 1024] __attribute__((aligned(ARENA_ALIGN)));
+static uint8_t *evict_buf;
+static volatile uint32_t evict_sink;
+static const char *pool_name[] = {"RAM1", "RAM2", "PSRAM"};
+
+static void cache_evict()
+{
+	uint32_t acc = 0;
+	for (uint32_t i = 0; i < EVICT_BYTES; i += 64)
+	{
+		evict_buf[i]++;
+		acc += evict_buf[i];
+	}
+	evict_sink = acc;
+}
+
+/**
+ * @brief mean block time in ns, optionally with the cache evicted before each block
+ */
+static double run(AudioStream_F32 &fx, uint32_t blocks, bool cold)
+{
+	float32_t inL[AUDIO_BLOCK_SAMPLES], inR[AUDIO_BLOCK_SAMPLES];
+	double phL = 0.0, phR = 0.0;
+	uint64_t t = 0, t0;
+	for (uint32_t blk = 0; blk < blocks; blk++)
+	{
+		host_sine(inL, AUDIO_BLOCK_SAMPLES, 220.0f, 0.5f, phL);
+		host_sine(inR, AUDIO_BLOCK_SAMPLES, 330.0f, 0.5f, phR);
+		host_feed(fx, 0, inL);
+		host_feed(fx, 1, inR);
+		if (cold) cache_evict();
+		t0 = host_time_ns();
+		fx.update();
+		t += host_time_ns() - t0;
+		fx.host_output(0);
+		fx.host_output(1);
+	}
+	return (double)t / blocks;
+}
+
+/**
+ * @brief create the effect in the pool, check the placement, time it and destroy it
+ */
+template <class T>
+static void place(const char *name, arena_pool_t pool, uint32_t blocks, void (*setup)(T &))
+{
+	arena_mark_t m = AudioBasicMemArena::mark();
+	T *fx = new(pool) T;
+	HOST_CHECK(fx != NULL, "%s: allocation failed", name);
+	if (!fx) return;
+	uint8_t *p = (uint8_t *)fx;
+	HOST_CHECK(p >= pool_mem[pool] && p + sizeof(T) <= pool_mem[pool] + sizeof(pool_mem[pool]),
+		"%s: object not in the %s pool", name, pool_name[pool]);
+	HOST_CHECK(((uintptr_t)p & (ARENA_ALIGN - 1)) == 0, "%s: object not aligned", name);
+	setup(*fx);
+	double hot = run(*fx, blocks, false);
+	double cold = run(*fx, blocks / 10, true);
+	printf("  %-14s %-5s %6u bytes  hot %7.0f ns/block  cold %7.0f ns/block  x%.2f\n",
+		name, pool_name[pool], (uint32_t)sizeof(T), hot, cold, cold / hot);
+	AudioBasicMemArena::destroy(fx);
+	AudioBasicMemArena::release(m);
+	HOST_CHECK(AudioBasicMemArena::pool_used(pool) == m.top[pool], "%s: pool not returned", name);
+}
+
+static void setup_phaser(AudioEffectPhaserStereo_F32 &fx)
+{
+	fx.bypass_set(false);
+	fx.mix(0.5f);
+	fx.feedback(0.5f);
+	fx.lfo_rate(0.5f);
+}
+
+static void setup_cabsim(AudioFilterIRCabsim_F32 &fx)
+{
+	fx.ir_load(0);
+}
+
+static void setup_plate(AudioEffectPlateReverb_F32 &fx)
+{
+	fx.bypass_set(false);
+	fx.size(0.8f);
+	fx.mix(0.5f);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t blocks = argc > 1 ? atoi(argv[1]) : 5000;
+	printf("bench_placement: %u blocks hot, %u blocks cold\n", blocks, blocks / 10);
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+		AudioBasicMemArena::pool_init((arena_pool_t)i, sizeof(pool_mem[i]), pool_mem[i]);
+	evict_buf = (uint8_t *)calloc(EVICT_BYTES, 1);
+
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+		place<AudioEffectPhaserStereo_F32>("phaser", (arena_pool_t)i, blocks, setup_phaser);
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+		place<AudioFilterIRCabsim_F32>("IR cabsim", (arena_pool_t)i, blocks, setup_cabsim);
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+		place<AudioEffectPlateReverb_F32>("plate reverb", (arena_pool_t)i, blocks, setup_plate);
+
+	free(evict_buf);
+	return host_result("bench_placement");
+}
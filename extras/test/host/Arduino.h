@@ -0,0 +1,98 @@
+/**
+ * @file Arduino.h
+ * @author Piotr Zapart
+ * @brief Host build shim of the Teensy4 core, only the parts used by the library
+ * 			Memory section attributes are empty, the interrupt control does nothing,
+ * 			the DWT cycle counter returns the host time scaled to 600MHz cycles.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <cmath>
+#include <type_traits>
+
+using std::abs;
+
+#ifndef __IMXRT1062__
+	#define __IMXRT1062__	1
+#endif
+
+#define DMAMEM
+#define EXTMEM
+#define FASTRUN
+#define FLASHMEM
+#define PROGMEM
+
+// Teensy core macros include the trailing semicolon
+#define __disable_irq()		do {} while (0);
+#define __enable_irq()		do {} while (0);
+
+#define F_CPU_ACTUAL		(600000000UL)
+uint32_t host_cycles();
+#define ARM_DWT_CYCCNT		(host_cycles())
+
+#ifndef PI
+	#define PI				3.1415926535897932384626433832795
+#endif
+#define TWO_PI				6.283185307179586476925286766559
+#define F(x)				(x)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+
+template <class A, class B>
+static inline auto min(A a, B b) -> typename std::common_type<A, B>::type { return a < b ? a : b; }
+template <class A, class B>
+static inline auto max(A a, B b) -> typename std::common_type<A, B>::type { return a > b ? a : b; }
+template <class T, class A, class B, class C, class D>
+static inline T map(T x, A in_min, B in_max, C out_min, D out_max)
+{
+	return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+static inline float pow10f(float x) { return powf(10.0f, x); }
+
+uint32_t millis();
+uint32_t micros();
+static inline void delay(uint32_t) {}
+
+// PSRAM is plain heap memory on the host
+extern uint8_t external_psram_size;
+static inline void *extmem_malloc(size_t size) { return malloc(size); }
+static inline void extmem_free(void *ptr) { free(ptr); }
+static inline void arm_dcache_flush(void *, uint32_t) {}
+static inline void arm_dcache_delete(void *, uint32_t) {}
+static inline void arm_dcache_flush_delete(void *, uint32_t) {}
+
+class Print
+{
+public:
+	template <typename... T>
+	int printf(const char *fmt, T... args) { return ::printf(fmt, args...); }
+	void print(const char *s) { fputs(s, stdout); }
+	void println(const char *s = "") { puts(s); }
+	void print(float v) { ::printf("%f", v); }
+	void println(float v) { ::printf("%f\n", v); }
+	void print(int v) { ::printf("%d", v); }
+	void println(int v) { ::printf("%d\n", v); }
+};
+
+class HostSerial : public Print
+{
+public:
+	operator bool() const { return true; }
+	void begin(uint32_t) {}
+};
+extern HostSerial Serial;
+
+#endif // _HOST_ARDUINO_H_
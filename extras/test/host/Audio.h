@@ -0,0 +1,6 @@
+#ifndef _HOST_AUDIO_H_
+#define _HOST_AUDIO_H_
+
+#include "AudioStream.h"
+
+#endif // _HOST_AUDIO_H_
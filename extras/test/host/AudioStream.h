@@ -0,0 +1,74 @@
+/**
+ * @file AudioStream.h
+ * @author Piotr Zapart
+ * @brief Host build shim of the Teensy AudioStream base class
+ * 			Objects are updated in the order of construction, same as on the target.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _HOST_AUDIOSTREAM_H_
+#define _HOST_AUDIOSTREAM_H_
+
+#include "Arduino.h"
+
+#ifndef AUDIO_BLOCK_SAMPLES
+	#define AUDIO_BLOCK_SAMPLES		128
+#endif
+#ifndef AUDIO_SAMPLE_RATE_EXACT
+	#define AUDIO_SAMPLE_RATE_EXACT	44100.0f
+#endif
+#define AUDIO_SAMPLE_RATE			AUDIO_SAMPLE_RATE_EXACT
+
+// same scale as processorUsage() on the target
+#define CYCLE_COUNTER_APPROX_PERCENT(n) (((float)((uint32_t)(n) * 6400u) * (float)(AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES)) / (float)(F_CPU_ACTUAL))
+
+typedef struct audio_block_struct
+{
+	uint8_t ref_count;
+	uint8_t reserved1;
+	uint16_t memory_pool_index;
+	int16_t data[AUDIO_BLOCK_SAMPLES];
+}audio_block_t;
+
+class AudioStream
+{
+public:
+	AudioStream(unsigned char ninput, audio_block_t **iqueue) : numInputs(ninput), inputQueue(iqueue)
+	{
+		(void)inputQueue;
+		AudioStream **p = &first_update;
+		while (*p) p = &(*p)->next_update;
+		*p = this;
+	}
+	virtual ~AudioStream()
+	{
+		AudioStream **p = &first_update;
+		while (*p && *p != this) p = &(*p)->next_update;
+		if (*p) *p = next_update;
+	}
+	virtual void update() = 0;
+	/**
+	 * @brief run one audio cycle, update() of all objects in the construction order
+	 */
+	static void update_all()
+	{
+		for (AudioStream *p = first_update; p; p = p->next_update) p->update();
+	}
+protected:
+	bool active = true;
+	unsigned char numInputs;
+private:
+	audio_block_t **inputQueue;
+	AudioStream *next_update = NULL;
+	static AudioStream *first_update;
+};
+
+class AudioConnection {};
+
+static inline void AudioNoInterrupts() {}
+static inline void AudioInterrupts() {}
+
+#endif // _HOST_AUDIOSTREAM_H_
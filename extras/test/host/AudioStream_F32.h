@@ -0,0 +1,98 @@
+/**
+ * @file AudioStream_F32.h
+ * @author Piotr Zapart
+ * @brief Host build shim of the OpenAudio AudioStream_F32 block graph
+ * 			Reference counted block pool, patch cords, transmit/receive with the
+ * 			copy on receiveWritable_f32() of a shared block, same rules as the target.
+ * 			Host only additions:
+ * 				host_input(ch, block)	- feed a block to an input of an unconnected object
+ * 				host_output(ch) 		- last block transmitted on an unconnected output
+ * 				host_blocksUsed/Max() 	- pool usage
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _HOST_AUDIOSTREAM_F32_H_
+#define _HOST_AUDIOSTREAM_F32_H_
+
+#include "AudioStream.h"
+#include "arm_math.h"
+
+#define HOST_AUDIO_POOL_BLOCKS	(64)
+#define HOST_AUDIO_MAX_OUTPUTS	(4)
+
+typedef struct audio_block_f32_struct
+{
+	unsigned char ref_count;
+	unsigned char reserved1;
+	unsigned int memory_pool_index;
+	float32_t data[AUDIO_BLOCK_SAMPLES];
+	int length;
+	int full_length;
+	float fs_Hz;
+	unsigned long id;
+}audio_block_f32_t;
+
+class AudioSettings_F32
+{
+public:
+	AudioSettings_F32(float fs_Hz=AUDIO_SAMPLE_RATE_EXACT, int block_size=AUDIO_BLOCK_SAMPLES) :
+		sample_rate_Hz(fs_Hz), audio_block_samples(block_size) {}
+	float sample_rate_Hz;
+	int audio_block_samples;
+};
+
+class AudioConnection_F32;
+
+class AudioStream_F32 : public AudioStream
+{
+public:
+	AudioStream_F32(unsigned char n_input_f32, audio_block_f32_t **iqueue) :
+		AudioStream(n_input_f32, NULL), inputQueue_f32(iqueue)
+	{
+		for (uint8_t i = 0; i < n_input_f32; i++) inputQueue_f32[i] = NULL;
+	}
+	static audio_block_f32_t *allocate_f32();
+	static void release(audio_block_f32_t *block);
+	/**
+	 * @brief feed a block to the input, the caller keeps its own reference
+	 */
+	void host_input(unsigned char ch, audio_block_f32_t *block);
+	/**
+	 * @brief last block transmitted on an unconnected output, NULL if none since the last call
+	 * 		the block stays valid until the next allocate_f32()
+	 */
+	audio_block_f32_t *host_output(unsigned char ch);
+	static uint32_t host_blocksUsed() { return blocksUsed; }
+	static uint32_t host_blocksMax() { return blocksMax; }
+	static void host_blocksMaxReset() { blocksMax = blocksUsed; }
+protected:
+	void transmit(audio_block_f32_t *block, unsigned char index=0);
+	audio_block_f32_t *receiveReadOnly_f32(unsigned int index=0);
+	audio_block_f32_t *receiveWritable_f32(unsigned int index=0);
+private:
+	friend class AudioConnection_F32;
+	audio_block_f32_t **inputQueue_f32;
+	audio_block_f32_t *outputs[HOST_AUDIO_MAX_OUTPUTS] = {};
+	AudioConnection_F32 *destination_list = NULL;
+	static uint32_t blocksUsed, blocksMax;
+};
+
+class AudioConnection_F32
+{
+public:
+	AudioConnection_F32(AudioStream_F32 &source, AudioStream_F32 &destination) :
+		AudioConnection_F32(source, 0, destination, 0) {}
+	AudioConnection_F32(AudioStream_F32 &source, unsigned char sourceOutput,
+						AudioStream_F32 &destination, unsigned char destinationInput);
+private:
+	friend class AudioStream_F32;
+	AudioStream_F32 &src;
+	AudioStream_F32 &dst;
+	unsigned char src_index, dest_index;
+	AudioConnection_F32 *next_dest = NULL;
+};
+
+#endif // _HOST_AUDIOSTREAM_F32_H_
@@ -0,0 +1,11 @@
+#ifndef _HOST_ARM_CONST_STRUCTS_H_
+#define _HOST_ARM_CONST_STRUCTS_H_
+
+#include "arm_math.h"
+
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len128;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len256;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len512;
+extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024;
+
+#endif // _HOST_ARM_CONST_STRUCTS_H_
@@ -0,0 +1,174 @@
+/**
+ * @file host_cmsis.cpp
+ * @author Piotr Zapart
+ * @brief Host build shim: reference C versions of the CMSIS-DSP functions
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <string.h>
+#include <math.h>
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len128 = {128};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len256 = {256};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len512 = {512};
+const arm_cfft_instance_f32 arm_cfft_sR_f32_len1024 = {1024};
+
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrc[i] * scale;
+}
+void arm_add_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] + pSrcB[i];
+}
+void arm_sub_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] - pSrcB[i];
+}
+void arm_mult_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrcA[i] * pSrcB[i];
+}
+void arm_offset_f32(const float32_t *pSrc, float32_t offset, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = pSrc[i] + offset;
+}
+void arm_abs_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = fabsf(pSrc[i]);
+}
+void arm_copy_f32(const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+	memmove(pDst, pSrc, blockSize * sizeof(float32_t));
+}
+void arm_fill_f32(float32_t value, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = value;
+}
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+	for (uint32_t i = 0; i < blockSize; i++) pDst[i] = (float32_t)pSrc[i] / 32768.0f;
+}
+float32_t arm_sin_f32(float32_t x) { return sinf(x); }
+float32_t arm_cos_f32(float32_t x) { return cosf(x); }
+
+// state: numTaps + blockSize - 1 samples, coefficients in time reversed order
+void arm_fir_init_f32(arm_fir_instance_f32 *S, uint16_t numTaps, const float32_t *pCoeffs, float32_t *pState, uint32_t blockSize)
+{
+	S->numTaps = numTaps;
+	S->pCoeffs = pCoeffs;
+	S->pState = pState;
+	memset(pState, 0, (numTaps + blockSize - 1) * sizeof(float32_t));
+}
+void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+	const uint32_t n = S->numTaps;
+	float32_t *st = S->pState;
+	memcpy(st + n - 1, pSrc, blockSize * sizeof(float32_t));
+	for (uint32_t i = 0; i < blockSize; i++)
+	{
+		float32_t acc = 0.0f;
+		for (uint32_t k = 0; k < n; k++) acc += st[i + k] * S->pCoeffs[n - 1 - k];
+		pDst[i] = acc;
+	}
+	memmove(st, st + blockSize, (n - 1) * sizeof(float32_t));
+}
+
+// coefficients per stage: b0, b1, b2, a1, a2 (a with the CMSIS sign), state: x1, x2, y1, y2
+void arm_biquad_cascade_df1_init_f32(arm_biquad_casd_df1_inst_f32 *S, uint8_t numStages, const float32_t *pCoeffs, float32_t *pState)
+{
+	S->numStages = numStages;
+	S->pCoeffs = pCoeffs;
+	S->pState = pState;
+	memset(pState, 0, 4 * numStages * sizeof(float32_t));
+}
+void arm_biquad_cascade_df1_f32(const arm_biquad_casd_df1_inst_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+	const float32_t *c = S->pCoeffs;
+	float32_t *st = S->pState;
+	const float32_t *in = pSrc;
+	for (uint32_t s = 0; s < S->numStages; s++)
+	{
+		float32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+		for (uint32_t i = 0; i < blockSize; i++)
+		{
+			float32_t x = in[i];
+			float32_t y = c[0] * x + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2;
+			x2 = x1; x1 = x;
+			y2 = y1; y1 = y;
+			pDst[i] = y;
+		}
+		st[0] = x1; st[1] = x2; st[2] = y1; st[3] = y2;
+		c += 5;
+		st += 4;
+		in = pDst;
+	}
+}
+
+// in place radix-2, interleaved re/im, up to 1024 points, the inverse transform is scaled by 1/N like CMSIS
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+	const uint32_t n = S->fftLen;
+	if (bitReverseFlag)
+	{
+		for (uint32_t i = 1, j = 0; i < n; i++)
+		{
+			uint32_t bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j)
+			{
+				float32_t t;
+				t = p1[2*i]; p1[2*i] = p1[2*j]; p1[2*j] = t;
+				t = p1[2*i+1]; p1[2*i+1] = p1[2*j+1]; p1[2*j+1] = t;
+			}
+		}
+	}
+	static float32_t twr[512], twi[512];	// e^(-j*2*pi*k/n), k < n/2
+	static uint32_t tw_n = 0;
+	if (tw_n != n)
+	{
+		for (uint32_t k = 0; k < n / 2; k++)
+		{
+			twr[k] = (float32_t)cos(2.0 * M_PI * k / n);
+			twi[k] = (float32_t)-sin(2.0 * M_PI * k / n);
+		}
+		tw_n = n;
+	}
+	const float32_t sgn = ifftFlag ? -1.0f : 1.0f;
+	for (uint32_t len = 2; len <= n; len <<= 1)
+	{
+		const uint32_t stride = n / len;
+		for (uint32_t i = 0; i < n; i += len)
+		{
+			for (uint32_t k = 0; k < len / 2; k++)
+			{
+				float32_t wr = twr[k * stride], wi = sgn * twi[k * stride];
+				float32_t *a = &p1[2 * (i + k)], *b = &p1[2 * (i + k + len / 2)];
+				float32_t tr = b[0] * wr - b[1] * wi;
+				float32_t ti = b[0] * wi + b[1] * wr;
+				b[0] = a[0] - tr; b[1] = a[1] - ti;
+				a[0] += tr; a[1] += ti;
+			}
+		}
+	}
+	if (ifftFlag)
+	{
+		const float32_t k = 1.0f / n;
+		for (uint32_t i = 0; i < 2 * n; i++) p1[i] *= k;
+	}
+}
+void arm_cmplx_mult_cmplx_f32(const float32_t *pSrcA, const float32_t *pSrcB, float32_t *pDst, uint32_t numSamples)
+{
+	for (uint32_t i = 0; i < numSamples; i++)
+	{
+		float32_t ar = pSrcA[2*i], ai = pSrcA[2*i+1], br = pSrcB[2*i], bi = pSrcB[2*i+1];
+		pDst[2*i] = ar * br - ai * bi;
+		pDst[2*i+1] = ar * bi + ai * br;
+	}
+}
@@ -0,0 +1,156 @@
+/**
+ * @file host_core.cpp
+ * @author Piotr Zapart
+ * @brief Host build shim: core functions, block pool and patch cords
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <chrono>
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+
+HostSerial Serial;
+uint8_t external_psram_size = 8;
+AudioStream *AudioStream::first_update = NULL;
+
+static const auto t_start = std::chrono::steady_clock::now();
+
+static uint64_t host_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_start).count();
+}
+uint32_t host_cycles() { return (uint32_t)(host_ns() * (F_CPU_ACTUAL / 1000000UL) / 1000UL); }
+uint32_t millis() { return (uint32_t)(host_ns() / 1000000UL); }
+uint32_t micros() { return (uint32_t)(host_ns() / 1000UL); }
+
+// Teensy core sine table, 257 points
+extern const int16_t AudioWaveformSine[257];
+const int16_t AudioWaveformSine[257] =
+{
+	     0,    804,   1608,   2410,   3212,   4011,   4808,   5602,   6393,   7179,   7962,   8739,
+	  9512,  10278,  11039,  11793,  12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+	 18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,  23170,  23731,  24279,  24811,
+	 25329,  25832,  26319,  26790,  27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+	 30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,  32137,  32285,  32412,  32521,
+	 32609,  32678,  32728,  32757,  32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+	 32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,  30273,  29956,  29621,  29268,
+	 28898,  28510,  28105,  27683,  27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+	 23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,  18204,  17530,  16846,  16151,
+	 15446,  14732,  14010,  13279,  12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+	  6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,      0,   -804,  -1608,  -2410,
+	 -3212,  -4011,  -4808,  -5602,  -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+	-12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+	-20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+	-27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+	-31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+	-32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+	-31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+	-27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+	-20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+	-12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,  -6393,  -5602,  -4808,  -4011,
+	 -3212,  -2410,  -1608,   -804,      0
+};
+
+static audio_block_f32_t pool[HOST_AUDIO_POOL_BLOCKS];
+uint32_t AudioStream_F32::blocksUsed = 0;
+uint32_t AudioStream_F32::blocksMax = 0;
+
+audio_block_f32_t *AudioStream_F32::allocate_f32()
+{
+	for (uint32_t i = 0; i < HOST_AUDIO_POOL_BLOCKS; i++)
+	{
+		if (pool[i].ref_count) continue;
+		audio_block_f32_t *b = &pool[i];
+		b->ref_count = 1;
+		b->memory_pool_index = i;
+		b->length = AUDIO_BLOCK_SAMPLES;
+		b->full_length = AUDIO_BLOCK_SAMPLES;
+		b->fs_Hz = AUDIO_SAMPLE_RATE_EXACT;
+		if (++blocksUsed > blocksMax) blocksMax = blocksUsed;
+		return b;
+	}
+	return NULL;
+}
+
+void AudioStream_F32::release(audio_block_f32_t *block)
+{
+	if (!block || !block->ref_count) return;
+	if (--block->ref_count == 0) blocksUsed--;
+}
+
+void AudioStream_F32::transmit(audio_block_f32_t *block, unsigned char index)
+{
+	bool connected = false;
+	if (!block) return;
+	for (AudioConnection_F32 *c = destination_list; c; c = c->next_dest)
+	{
+		if (c->src_index != index) continue;
+		connected = true;
+		if (c->dst.inputQueue_f32[c->dest_index] == NULL)
+		{
+			c->dst.inputQueue_f32[c->dest_index] = block;
+			block->ref_count++;
+		}
+	}
+	if (!connected && index < HOST_AUDIO_MAX_OUTPUTS)	// unconnected output, keep for host_output()
+	{
+		release(outputs[index]);
+		outputs[index] = block;
+		block->ref_count++;
+	}
+}
+
+audio_block_f32_t *AudioStream_F32::receiveReadOnly_f32(unsigned int index)
+{
+	if (index >= numInputs) return NULL;
+	audio_block_f32_t *b = inputQueue_f32[index];
+	inputQueue_f32[index] = NULL;
+	return b;
+}
+
+audio_block_f32_t *AudioStream_F32::receiveWritable_f32(unsigned int index)
+{
+	audio_block_f32_t *in = receiveReadOnly_f32(index);
+	if (in && in->ref_count > 1)
+	{
+		audio_block_f32_t *p = allocate_f32();
+		if (p)
+		{
+			memcpy(p->data, in->data, sizeof(p->data));
+			p->length = in->length;
+		}
+		release(in);
+		in = p;
+	}
+	return in;
+}
+
+void AudioStream_F32::host_input(unsigned char ch, audio_block_f32_t *block)
+{
+	if (ch >= numInputs || !block) return;
+	release(inputQueue_f32[ch]);
+	inputQueue_f32[ch] = block;
+	block->ref_count++;
+}
+
+audio_block_f32_t *AudioStream_F32::host_output(unsigned char ch)
+{
+	if (ch >= HOST_AUDIO_MAX_OUTPUTS) return NULL;
+	audio_block_f32_t *b = outputs[ch];
+	if (!b) return NULL;
+	outputs[ch] = NULL;
+	release(b);		// valid until the next allocation
+	return b;
+}
+
+AudioConnection_F32::AudioConnection_F32(AudioStream_F32 &source, unsigned char sourceOutput,
+										 AudioStream_F32 &destination, unsigned char destinationInput) :
+	src(source), dst(destination), src_index(sourceOutput), dest_index(destinationInput)
+{
+	AudioConnection_F32 **p = &src.destination_list;
+	while (*p) p = &(*p)->next_dest;
+	*p = this;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file host_test.h
+ * @author Piotr Zapart
+ * @brief Minimal helpers for the host tests and benchmarks
+ * 			HOST_CHECK(cond, fmt, ...) prints the failed condition and counts it,
+ * 			host_result() prints the summary, use it as the return value of main().
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _HOST_TEST_H_
+#define _HOST_TEST_H_
+
+#include <stdio.h>
+#include <chrono>
+#include "Arduino.h"
+#include "AudioStream_F32.h"
+
+static int host_checks = 0;
+static int host_failures = 0;
+
+#define HOST_CHECK(cond, ...) do { \
+	host_checks++; \
+	if (!(cond)) { \
+		host_failures++; \
+		printf("FAIL %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+		printf(__VA_ARGS__); \
+		printf("\n"); \
+	} } while (0)
+
+static inline int host_result(const char *name)
+{
+	printf("%s: %d checks, %d failed -> %s\n", name, host_checks, host_failures, host_failures ? "FAIL" : "PASS");
+	return host_failures ? 1 : 0;
+}
+
+/**
+ * @brief host time in ns, for relative timing only
+ */
+static inline uint64_t host_time_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief feed a block with the given samples (NULL = silence) to the input of a standalone object
+ */
+static inline void host_feed(AudioStream_F32 &obj, uint8_t ch, const float32_t *data)
+{
+	audio_block_f32_t *b = AudioStream_F32::allocate_f32();
+	if (!b) return;
+	if (data) memcpy(b->data, data, sizeof(b->data));
+	else memset(b->data, 0, sizeof(b->data));
+	obj.host_input(ch, b);
+	AudioStream_F32::release(b);
+}
+
+/**
+ * @brief sine generator, phase kept by the caller
+ */
+static inline void host_sine(float32_t *dst, uint32_t len, float32_t f, float32_t amp, double &phase, float32_t fs=AUDIO_SAMPLE_RATE_EXACT)
+{
+	const double dph = 2.0 * M_PI * f / fs;
+	for (uint32_t i = 0; i < len; i++)
+	{
+		dst[i] = amp * (float32_t)sin(phase);
+		phase += dph;
+		if (phase > 2.0 * M_PI) phase -= 2.0 * M_PI;
+	}
+}
+
+/**
+ * @brief frequency rounded to a DFT bin of a len samples long record,
+ * 		a sine at this frequency is periodic in the record, no window needed
+ */
+static inline float32_t host_bin_freq(float32_t f, uint32_t len, float32_t fs=AUDIO_SAMPLE_RATE_EXACT)
+{
+	return fs * roundf(f * len / fs) / len;
+}
+
+/**
+ * @brief amplitude of the frequency f in the record, single bin DFT
+ */
+static inline double host_dft(const float32_t *x, uint32_t len, float32_t f, float32_t fs=AUDIO_SAMPLE_RATE_EXACT)
+{
+	const double w = 2.0 * M_PI * f / fs;
+	double re = 0.0, im = 0.0;
+	for (uint32_t n = 0; n < len; n++)
+	{
+		re += x[n] * cos(w * n);
+		im -= x[n] * sin(w * n);
+	}
+	return sqrt(re * re + im * im) * 2.0 / len;
+}
+
+/**
+ * @brief aliasing of a nonlinearity driven with a sine at f0 (bin frequency):
+ * 		energy outside of the DC and the harmonics of f0 relative to the total energy, in dB
+ */
+static inline double host_alias_dB(const float32_t *x, uint32_t len, float32_t f0, float32_t fs=AUDIO_SAMPLE_RATE_EXACT)
+{
+	double total = 0.0, harm, a;
+	for (uint32_t n = 0; n < len; n++) total += (double)x[n] * x[n];
+	total /= len;
+	a = host_dft(x, len, 0.0f, fs) * 0.5;
+	harm = a * a;
+	for (uint32_t h = 1; h * f0 < fs * 0.5f; h++)
+	{
+		a = host_dft(x, len, h * f0, fs);
+		harm += a * a * 0.5;
+	}
+	return 10.0 * log10(max(total - harm, 1e-20) / total);
+}
+
+#endif // _HOST_TEST_H_
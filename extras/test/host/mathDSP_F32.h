@@ -0,0 +1,24 @@
+#ifndef _HOST_MATHDSP_F32_H_
+#define _HOST_MATHDSP_F32_H_
+
+#include "arm_math.h"
+
+class mathDSP_F32
+{
+public:
+	/**
+	 * @brief zero order modified Bessel function, power series
+	 */
+	float i0f(float x)
+	{
+		float sum = 1.0f, term = 1.0f, h = 0.25f * x * x;
+		for (int k = 1; k < 40 && term > 1.0e-9f * sum; k++)
+		{
+			term *= h / (float)(k * k);
+			sum += term;
+		}
+		return sum;
+	}
+};
+
+#endif // _HOST_MATHDSP_F32_H_
@@ -0,0 +1,135 @@
+/**
+ * @file test_delay_burst.cpp
+ * @author Piotr Zapart
+ * @brief AudioBasicDelay burst access with the buffer in a backing store
+ * 			A simulated slow store (fixed latency per transaction + per byte time)
+ * 			counts the transactions. The stereo delay access pattern is run on a
+ * 			delay line in RAM and on one in the store, for each storage format
+ * 			and wrap mode:
+ * 				- read data has to be bit exact with the RAM delay line
+ * 				- one block write + the guard update, max. 3 transactions
+ * 				- one read window, max. 2 transactions
+ * 				- getBurstCount() matches the transactions seen by the store
+ * 			The time spent in the store is compared with per sample access.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include <vector>
+#include "host_test.h"
+#include "basic_delay.h"
+
+#define DELAY_SIZE			(20000)		// ~0.45s, not a power of two
+#define TAPS				(4)			// same as the stereo delay
+#define WINDOW_LEN			(AUDIO_BLOCK_SAMPLES + 32)	// modulated tap, Hermite margin included
+#define TEST_BLOCKS			(600)
+#define STORE_LATENCY_NS	(200)		// per transaction
+#define STORE_BYTE_NS		(1)			// per byte
+
+class HostSlowStore : public AudioBasicDelayStore
+{
+public:
+	HostSlowStore(uint32_t bytes) : mem(bytes, 0xA5) {}	// garbage, reset() has to clear it
+	void read(uint32_t addr, void *dst, uint32_t bytes)
+	{
+		HOST_CHECK(addr + bytes <= mem.size(), "read out of range: %u + %u", addr, bytes);
+		memcpy(dst, &mem[addr], bytes);
+		reads++;
+		wait(bytes);
+	}
+	void write(uint32_t addr, const void *src, uint32_t bytes)
+	{
+		HOST_CHECK(addr + bytes <= mem.size(), "write out of range: %u + %u", addr, bytes);
+		memcpy(&mem[addr], src, bytes);
+		writes++;
+		wait(bytes);
+	}
+	uint32_t transactions() { return reads + writes; }
+	std::vector<uint8_t> mem;
+	uint32_t reads = 0, writes = 0;
+	uint64_t busy_ns = 0;
+private:
+	void wait(uint32_t bytes)
+	{
+		uint64_t t = STORE_LATENCY_NS + bytes * STORE_BYTE_NS;
+		uint64_t t0 = host_time_ns();
+		while (host_time_ns() - t0 < t) {}
+		busy_ns += t;
+	}
+};
+
+static const char *fmt_name[] = {"f32", "i16", "f16"};
+
+static void run(delay_storage_t fmt, bool pow2)
+{
+	AudioBasicDelay ram, dly;
+	ram.init(DELAY_SIZE, false, pow2, fmt);
+	HostSlowStore store((ram.getSize() + BASIC_DELAY_GUARD) * (fmt == DELAY_STORAGE_F32 ? 4 : 2));
+	dly.setStore(&store);
+	HOST_CHECK(dly.init(DELAY_SIZE, false, pow2, fmt), "init with a store");
+	HOST_CHECK(dly.getBuffer() == NULL && dly.getStore() == &store, "buffer in the store");
+	HOST_CHECK(store.mem.size() == dly.getSizeBytes(), "store size %zu, delay %u", store.mem.size(), dly.getSizeBytes());
+
+	float32_t in[AUDIO_BLOCK_SAMPLES], a[WINDOW_LEN], b[WINDOW_LEN];
+	uint32_t mismatch = 0, max_wr = 0, max_rd = 0, windows = 0;
+	bool count_ok = true;
+	double phase = 0.0;
+	store.reads = store.writes = 0;
+	store.busy_ns = 0;
+	dly.resetBurstCount();
+
+	for (uint32_t blk = 0; blk < TEST_BLOCKS; blk++)
+	{
+		host_sine(in, AUDIO_BLOCK_SAMPLES, 441.0f, 0.5f, phase);
+		for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) in[i] += 0.01f * ((float32_t)rand() / RAND_MAX - 0.5f);
+		uint32_t w0 = store.writes;
+		ram.writeBlock(in, AUDIO_BLOCK_SAMPLES);
+		dly.writeBlock(in, AUDIO_BLOCK_SAMPLES);
+		if (store.writes - w0 > max_wr) max_wr = store.writes - w0;
+
+		for (uint32_t t = 0; t < TAPS; t++)
+		{
+			// modulated taps spread over the whole buffer, windows crossing the wrap point included
+			int32_t pos = (int32_t)((ram.getSize() - WINDOW_LEN) * (t + 1) / (TAPS + 1))
+						+ (int32_t)(1000.0f * sinf(blk * 0.05f + t)) - (int32_t)(blk * 37 % 300);
+			if (t == 0) pos = ram.getSize() - WINDOW_LEN / 2 - (int32_t)(blk % 8);
+			uint32_t r0 = store.reads;
+			ram.readBlock(a, pos, WINDOW_LEN);
+			dly.readBlock(b, pos, WINDOW_LEN);
+			if (store.reads - r0 > max_rd) max_rd = store.reads - r0;
+			mismatch += memcmp(a, b, sizeof(a)) != 0;
+			windows++;
+		}
+		if (dly.getBurstCount() != store.transactions()) count_ok = false;
+	}
+	const uint32_t per_sample = AUDIO_BLOCK_SAMPLES + TAPS * WINDOW_LEN;
+	printf("  %s %-5s %5.2f transactions/block (max. write %u, read %u), %6.1f us/block in the store"
+		   ", per sample access %u transactions %6.1f us/block\n",
+		fmt_name[fmt], pow2 ? "pow2" : "", (double)store.transactions() / TEST_BLOCKS, max_wr, max_rd,
+		store.busy_ns * 1e-3 / TEST_BLOCKS, per_sample,
+		per_sample * (STORE_LATENCY_NS + (fmt == DELAY_STORAGE_F32 ? 4 : 2) * STORE_BYTE_NS) * 1e-3);
+	HOST_CHECK(mismatch == 0, "%s: %u of %u read windows differ from the RAM delay line", fmt_name[fmt], mismatch, windows);
+	HOST_CHECK(max_wr <= 3, "%s: %u transactions per block write", fmt_name[fmt], max_wr);
+	HOST_CHECK(max_rd <= 2, "%s: %u transactions per read window", fmt_name[fmt], max_rd);
+	HOST_CHECK(count_ok, "%s: burst count %u, store transactions %u", fmt_name[fmt], dly.getBurstCount(), store.transactions());
+
+	dly.reset();
+	dly.readBlock(b, dly.getSize() - 8, WINDOW_LEN);
+	uint32_t nonzero = 0;
+	for (uint32_t i = 0; i < WINDOW_LEN; i++) nonzero += b[i] != 0.0f;
+	HOST_CHECK(nonzero == 0, "%s: %u samples left after reset()", fmt_name[fmt], nonzero);
+}
+
+int main()
+{
+	printf("test_delay_burst: delay size %u, %u taps, store latency %uns + %uns/byte\n",
+		DELAY_SIZE, TAPS, STORE_LATENCY_NS, STORE_BYTE_NS);
+	for (int f = DELAY_STORAGE_F32; f <= DELAY_STORAGE_F16; f++)
+	{
+		run((delay_storage_t)f, false);
+		run((delay_storage_t)f, true);
+	}
+	return host_result("test_delay_burst");
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_denormal.cpp
+ * @author Piotr Zapart
+ * @brief Denormal handling of the recursive effects
+ * 			An impulse followed by minutes of silence is fed to the effects,
+ * 			the decaying feedback loops must not produce subnormal output and
+ * 			the per block processing time has to stay at the level measured
+ * 			with a noise input before.
+ * 			Built twice: with the FTZ guard (default) and with the guard compiled
+ * 			out (AUDIO_DENORMAL_FTZ=0), which tests the bias injection fallback.
+ * 			The effects are compiled into this file to follow the test's defines.
+ *
+ * 			usage: test_denormal [seconds of silence, default 120]
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "effect_monoToStereo_F32.cpp"
+#include "effect_platereverb_F32.cpp"
+#include "effect_reverbsc_F32.cpp"
+#include "filter_tonestackStereo_F32.cpp"
+
+#define TIME_WINDOW_SEC		(10)
+#define TIME_MAX_RATIO		(3.0f)	// max. block time in silence vs. with signal
+
+static uint32_t silence_blocks;
+static const uint32_t blocks_per_window = TIME_WINDOW_SEC * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES;
+
+static uint32_t count_subnormals(const float32_t *data)
+{
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) n += fpclassify(data[i]) == FP_SUBNORMAL;
+	return n;
+}
+
+/**
+ * @brief reference time with noise input, then an impulse and silence,
+ * 		the mean block time is compared per window
+ */
+static void run(const char *name, AudioStream_F32 &fx, uint8_t inputs, uint8_t outputs)
+{
+	float32_t buf[AUDIO_BLOCK_SAMPLES];
+	uint64_t t_win = 0, t_ref = 0, t_max = 0;
+	uint32_t subnormals = 0;
+	uint32_t blk;
+
+	for (blk = 0; blk < blocks_per_window + silence_blocks; blk++)
+	{
+		if (blk < blocks_per_window)
+			for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) buf[i] = 0.1f * ((float32_t)rand() / RAND_MAX - 0.5f);
+		else
+			memset(buf, 0, sizeof(buf));
+		if (blk == blocks_per_window) buf[0] = 1.0f;
+		for (uint8_t ch = 0; ch < inputs; ch++) host_feed(fx, ch, buf);
+		uint64_t t0 = host_time_ns();
+		fx.update();
+		t_win += host_time_ns() - t0;
+		for (uint8_t ch = 0; ch < outputs; ch++)
+		{
+			audio_block_f32_t *out = fx.host_output(ch);
+			if (out) subnormals += count_subnormals(out->data);
+		}
+		if ((blk + 1) % blocks_per_window == 0)
+		{
+			if (!t_ref) t_ref = t_win;
+			else if (t_win > t_max) t_max = t_win;
+			t_win = 0;
+		}
+	}
+	float32_t ratio = (float32_t)t_max / (float32_t)t_ref;
+	printf("  %-16s %6.0f ns/block with signal, %6.0f ns/block max. in silence (x%.2f), %u subnormal samples\n",
+		name, (double)t_ref / blocks_per_window, (double)t_max / blocks_per_window, ratio, subnormals);
+	HOST_CHECK(subnormals == 0, "%s: %u subnormal output samples", name, subnormals);
+	HOST_CHECK(ratio < TIME_MAX_RATIO, "%s: block time in silence x%.2f", name, ratio);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t seconds = argc > 1 ? atoi(argv[1]) : 120;
+	if (seconds < 2 * TIME_WINDOW_SEC) seconds = 2 * TIME_WINDOW_SEC;
+	silence_blocks = seconds * AUDIO_SAMPLE_RATE_EXACT / AUDIO_BLOCK_SAMPLES;
+	printf("test_denormal: %s, %us of silence\n", AUDIO_DENORMAL_BIAS ? "bias injection" : "FTZ guard", seconds);
+
+#if !AUDIO_DENORMAL_BIAS
+	{
+		volatile float32_t tiny = 1.0e-38f;
+		bool before = AudioBasicDenormalGuard::active();
+		{
+			AudioBasicDenormalGuard ftz;
+			HOST_CHECK(AudioBasicDenormalGuard::active(), "guard not active");
+			HOST_CHECK(tiny * 0.01f == 0.0f, "subnormal result not flushed");
+		}
+		HOST_CHECK(AudioBasicDenormalGuard::active() == before, "FPU mode not restored");
+	}
+#endif
+
+	AudioEffectMonoToStereo_F32 m2s;
+	m2s.setSpread(1.0f);
+	run("monoToStereo", m2s, 1, 2);
+
+	AudioEffectPlateReverb_F32 plate;
+	plate.size(0.95f);
+	plate.mix(1.0f);
+	plate.bypass_set(false);
+	run("plate reverb", plate, 2, 2);
+
+	AudioEffectReverbSc_F32 sc;
+	sc.feedback(0.95f);
+	sc.mix(1.0f);
+	sc.bypass_set(false);
+	run("Sc reverb", sc, 2, 2);
+
+	AudioFilterToneStackStereo_F32 ts;
+	ts.setModel(TONESTACK_BASSMAN);
+	ts.bypass_set(false);
+	run("tone stack", ts, 2, 2);
+
+	return host_result("test_denormal");
+}
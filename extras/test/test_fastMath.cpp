@@ -0,0 +1,120 @@
+/**
+ * @file test_fastMath.cpp
+ * @author Piotr Zapart
+ * @brief basic_fastMath.h approximations against double precision libm
+ * 			Checks the error bounds documented in the header:
+ * 				fast_log2f	abs. error < 1.4e-5 for 2^-32 < |x| < 2^24, < 1.7e-5 below
+ * 				fast_exp2f	rel. error < 2.8e-6
+ * 				fast_lin2dB	abs. error < 1e-4 dB in the -140...+20dB range
+ * 				fast_pow2dB	abs. error < 1e-4 dB in the -140...+20dB range
+ * 				fast_dB2lin	rel. error < 4e-6
+ * 			plus the input range handling and the block versions.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "basic_fastMath.h"
+
+#define SWEEP_POINTS	(2000000)
+
+static float32_t rnd() { return (float32_t)rand() / (float32_t)RAND_MAX; }
+
+int main()
+{
+	double err, err_max;
+	float32_t x, x_max = 0.0f;
+	printf("test_fastMath: %u points per function\n", SWEEP_POINTS);
+
+	// log2: random mantissa over the exponent range, both signs
+	double err_low = 0.0;
+	float32_t x_low = 0.0f;
+	err_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		x = ldexpf(1.0f + rnd(), (int)(rnd() * 149.0f) - 126);
+		if (x >= 16777216.0f) continue;
+		if (i & 1) x = -x;
+		err = fabs((double)fast_log2f(x) - log2(fabs((double)x)));
+		if (fabsf(x) <= ldexpf(1.0f, -32))
+		{
+			if (err > err_low) { err_low = err; x_low = x; }
+		}
+		else if (err > err_max) { err_max = err; x_max = x; }
+	}
+	printf("  fast_log2f   max. abs. error %.3g at %g, %.3g below 2^-32 at %g\n", err_max, x_max, err_low, x_low);
+	HOST_CHECK(err_max < 1.4e-5, "fast_log2f abs. error %g at %g", err_max, x_max);
+	HOST_CHECK(err_low < 1.7e-5, "fast_log2f abs. error %g at %g", err_low, x_low);
+
+	// exp2: whole argument range
+	err_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		x = -126.0f + 253.0f * rnd();
+		double ref = exp2((double)x);
+		err = fabs((double)fast_exp2f(x) - ref) / ref;
+		if (err > err_max) { err_max = err; x_max = x; }
+	}
+	printf("  fast_exp2f   max. rel. error %.3g at %g\n", err_max, x_max);
+	HOST_CHECK(err_max < 2.8e-6, "fast_exp2f rel. error %g at %g", err_max, x_max);
+
+	// lin2dB: -140...+20dB
+	err_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		x = (float32_t)pow(10.0, (-140.0 + 160.0 * rnd()) / 20.0);
+		err = fabs((double)fast_lin2dB(x) - 20.0 * log10((double)x));
+		if (err > err_max) { err_max = err; x_max = x; }
+	}
+	printf("  fast_lin2dB  max. abs. error %.3g dB at %g\n", err_max, x_max);
+	HOST_CHECK(err_max < 1e-4, "fast_lin2dB abs. error %g dB at %g", err_max, x_max);
+
+	// pow2dB: same range in power
+	err_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		x = (float32_t)pow(10.0, (-140.0 + 160.0 * rnd()) / 10.0);
+		err = fabs((double)fast_pow2dB(x) - 10.0 * log10((double)x));
+		if (err > err_max) { err_max = err; x_max = x; }
+	}
+	printf("  fast_pow2dB  max. abs. error %.3g dB at %g\n", err_max, x_max);
+	HOST_CHECK(err_max < 1e-4, "fast_pow2dB abs. error %g dB at %g", err_max, x_max);
+
+	// dB2lin: -140...+20dB
+	err_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		x = -140.0f + 160.0f * rnd();
+		double ref = pow(10.0, (double)x / 20.0);
+		err = fabs((double)fast_dB2lin(x) - ref) / ref;
+		if (err > err_max) { err_max = err; x_max = x; }
+	}
+	printf("  fast_dB2lin  max. rel. error %.3g at %gdB\n", err_max, x_max);
+	HOST_CHECK(err_max < 4e-6, "fast_dB2lin rel. error %g at %gdB", err_max, x_max);
+
+	// input ranges
+	HOST_CHECK(fast_log2f(0.0f) <= -126.9f, "log2(0) = %g", fast_log2f(0.0f));
+	HOST_CHECK(fast_log2f(1.0e-40f) <= -126.0f, "log2(subnormal) = %g", fast_log2f(1.0e-40f));
+	HOST_CHECK(fast_exp2f(-1000.0f) > 0.0f && isnormal(fast_exp2f(-1000.0f)), "exp2(-1000) = %g", fast_exp2f(-1000.0f));
+	HOST_CHECK(isfinite(fast_exp2f(1000.0f)), "exp2(1000) = %g", fast_exp2f(1000.0f));
+
+	// block versions match the scalar ones, in place too
+	float32_t a[AUDIO_BLOCK_SAMPLES], b[AUDIO_BLOCK_SAMPLES];
+	uint32_t diff = 0;
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) a[i] = 2.0f * rnd() - 1.0f;
+	fast_lin2dB_block(a, b, AUDIO_BLOCK_SAMPLES);
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) diff += b[i] != fast_lin2dB(a[i]);
+	memcpy(b, a, sizeof(a));
+	fast_log2_block(b, b, AUDIO_BLOCK_SAMPLES);
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) diff += b[i] != fast_log2f(a[i]);
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) a[i] = -100.0f * rnd();
+	fast_dB2lin_block(a, b, AUDIO_BLOCK_SAMPLES);
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) diff += b[i] != fast_dB2lin(a[i]);
+	fast_exp2_block(a, b, AUDIO_BLOCK_SAMPLES);
+	for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++) diff += b[i] != fast_exp2f(a[i]);
+	HOST_CHECK(diff == 0, "%u block results differ from the scalar functions", diff);
+
+	return host_result("test_fastMath");
+}
@@ -0,0 +1,103 @@
+/**
+ * @file test_lookahead.cpp
+ * @author Piotr Zapart
+ * @brief Lookahead switching of the compressor and the noise gate
+ * 			The lookahead is run with a loud signal, switched off, then switched
+ * 			on again or changed to another length while the effect is running.
+ * 			The first block of silence after the switch must be silent, no stale
+ * 			audio from the delay lines.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "effect_compressorStereo_F32.h"
+#include "effect_noiseGateStereo_F32.h"
+
+static float32_t loud[AUDIO_BLOCK_SAMPLES];
+
+/**
+ * @brief run n blocks of the given input (NULL = silence), returns the output peak of the last block
+ * 		sc: optional side chain on inputs 2 and 3
+ */
+static float32_t run(AudioStream_F32 &fx, const float32_t *in, uint32_t n, const float32_t *sc=NULL)
+{
+	float32_t peak = 0.0f;
+	for (uint32_t blk = 0; blk < n; blk++)
+	{
+		host_feed(fx, 0, in);
+		host_feed(fx, 1, in);
+		if (sc)
+		{
+			host_feed(fx, 2, sc);
+			host_feed(fx, 3, sc);
+		}
+		fx.update();
+		peak = 0.0f;
+		for (uint8_t ch = 0; ch < 2; ch++)
+		{
+			audio_block_f32_t *out = fx.host_output(ch);
+			if (!out) continue;
+			for (uint32_t i = 0; i < AUDIO_BLOCK_SAMPLES; i++)
+				if (fabsf(out->data[i]) > peak) peak = fabsf(out->data[i]);
+		}
+	}
+	return peak;
+}
+
+static void test_compressor()
+{
+	AudioEffectCompressorStereo_F32 comp;
+	comp.enableHPFilter(false);		// the filter would ring after the loud signal
+	comp.setThresh_dBFS(-20.0f);
+	comp.setCompressionRatio(4.0f);
+	comp.bypass_set(false);
+
+	HOST_CHECK(comp.setLookahead_ms(5.0f), "compressor: lookahead allocation");
+	HOST_CHECK(run(comp, loud, 50) > 0.1f, "compressor: no output");
+	// off -> on
+	comp.setLookahead_ms(0.0f);
+	run(comp, loud, 20);
+	comp.setLookahead_ms(5.0f);
+	float32_t p = run(comp, NULL, 1);
+	HOST_CHECK(p == 0.0f, "compressor: lookahead 0 -> 5ms, stale output peak %g", p);
+	// length change
+	run(comp, loud, 20);
+	comp.setLookahead_ms(2.0f);
+	p = run(comp, NULL, 1);
+	HOST_CHECK(p == 0.0f, "compressor: lookahead 5 -> 2ms, stale output peak %g", p);
+}
+
+static void test_gate()
+{
+	AudioEffectNoiseGateStereo_F32 gate;
+	gate.setThreshold(-60.0f);
+	gate.bypass_set(false);
+
+	// loud side chain keeps the gate open, the audio output is the delay line
+	HOST_CHECK(gate.setLookahead_ms(5.0f), "gate: lookahead allocation");
+	HOST_CHECK(run(gate, loud, 50, loud) > 0.1f, "gate: no output");
+	// off -> on
+	gate.setLookahead_ms(0.0f);
+	run(gate, loud, 20, loud);
+	gate.setLookahead_ms(5.0f);
+	float32_t p = run(gate, NULL, 1, loud);
+	HOST_CHECK(p == 0.0f, "gate: lookahead 0 -> 5ms, stale output peak %g", p);
+	// length change
+	run(gate, loud, 20, loud);
+	gate.setLookahead_ms(2.0f);
+	p = run(gate, NULL, 1, loud);
+	HOST_CHECK(p == 0.0f, "gate: lookahead 5 -> 2ms, stale output peak %g", p);
+}
+
+int main()
+{
+	double ph = 0.0;
+	host_sine(loud, AUDIO_BLOCK_SAMPLES, 1000.0f, 0.9f, ph);
+	printf("test_lookahead\n");
+	test_compressor();
+	test_gate();
+	return host_result("test_lookahead");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_waveshaper.cpp
+ * @author Piotr Zapart
+ * @brief AudioBasicWaveshaper tables against the curve formulas in basic_waveshaper.cpp
+ * 			For TUBE, DIODE and FUZZ (the BOOSTER source table is not in the tree):
+ * 				- max. deviation of process() from the double precision formula
+ * 				- slope steps at the segment joints, C1 except the FUZZ knee at 0
+ * 				- integral() against the numerically integrated formula
+ * 			TUBE: both sides have the same slope at 0.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "host_test.h"
+#include "basic_waveshaper.h"
+
+#define SWEEP_POINTS	(400001)
+#define MAX_DEVIATION	(4e-5)		// documented in basic_waveshaper.h
+
+static double tube_B;
+
+static double tube(double x)
+{
+	if (x >= 0.0) return tanh(2.0 * x) / tanh(2.0);
+	return 0.7 * tanh(tube_B * x) / tanh(tube_B);
+}
+
+static double diode_g(double u) { return u / pow(1.0 + pow(fabs(u), 2.5), 1.0 / 2.5); }
+static double diode(double x) { return diode_g(3.0 * x) / diode_g(3.0); }
+
+static double fuzz(double x)
+{
+	if (x >= 0.0) return (1.0 - exp(-5.0 * x)) / (1.0 - exp(-5.0));
+	return -0.6 * (1.0 - exp(8.0 * x / 0.6)) / (1.0 - exp(-8.0 / 0.6));
+}
+
+typedef struct
+{
+	waveshaper_curve_t c;
+	const char *name;
+	double (*f)(double);
+	bool kink_at_0;
+}curve_t;
+
+static const curve_t curves[] =
+{
+	{WAVESHAPER_TUBE, "tube", tube, false},
+	{WAVESHAPER_DIODE, "diode", diode, false},
+	{WAVESHAPER_FUZZ, "fuzz", fuzz, true},
+};
+
+static void check(const curve_t &cv)
+{
+	AudioBasicWaveshaper ws(cv.c);
+	const waveshaper_table_t *t = &waveshaper_tables[cv.c];
+	const double h = 2.0 / WAVESHAPER_SEGMENTS;
+	double err, err_max = 0.0, x_max = 0.0;
+	for (uint32_t i = 0; i < SWEEP_POINTS; i++)
+	{
+		double x = -1.0 + 2.0 * i / (SWEEP_POINTS - 1);
+		err = fabs((double)ws.process((float32_t)x) - cv.f((float32_t)x));
+		if (err > err_max) { err_max = err; x_max = x; }
+	}
+	// slope step at the joints, segment end vs. next segment start
+	double step, step_max = 0.0, step_0 = 0.0;
+	for (uint32_t k = 0; k < WAVESHAPER_SEGMENTS - 1; k++)
+	{
+		const float32_t *a = t->seg[k], *b = t->seg[k + 1];
+		step = fabs((double)a[1] + 2.0 * a[2] + 3.0 * a[3] - b[1]) / h;
+		if (k + 1 == WAVESHAPER_SEGMENTS / 2) step_0 = step;
+		else if (step > step_max) step_max = step;
+	}
+	// antiderivative, trapezoids over the formula
+	double F = 0.0, F_err = 0.0, y_last = cv.f(0.0);
+	const uint32_t n = 20000;
+	for (uint32_t i = 1; i <= n; i++)
+	{
+		double x = (double)i / n, y = cv.f(x);
+		F += (y + y_last) * 0.5 / n;
+		y_last = y;
+		err = fabs((double)ws.integral((float32_t)x) - F);
+		if (err > F_err) F_err = err;
+	}
+	F = 0.0;
+	y_last = cv.f(0.0);
+	for (uint32_t i = 1; i <= n; i++)
+	{
+		double x = -(double)i / n, y = cv.f(x);
+		F -= (y + y_last) * 0.5 / n;
+		y_last = y;
+		err = fabs((double)ws.integral((float32_t)x) - F);
+		if (err > F_err) F_err = err;
+	}
+	printf("  %-6s max. deviation %.3g at %.4f, slope step at the joints %.3g, at 0 %.3g, integral error %.3g\n",
+		cv.name, err_max, x_max, step_max, step_0, F_err);
+	HOST_CHECK(err_max < MAX_DEVIATION, "%s: deviation %g at %g", cv.name, err_max, x_max);
+	HOST_CHECK(step_max < 1e-3, "%s: slope step %g at a joint", cv.name, step_max);
+	if (cv.kink_at_0)	HOST_CHECK(step_0 > 1.0, "%s: no knee at 0, slope step %g", cv.name, step_0);
+	else				HOST_CHECK(step_0 < 1e-3, "%s: slope step %g at 0", cv.name, step_0);
+	HOST_CHECK(F_err < 1e-5, "%s: integral error %g", cv.name, F_err);
+}
+
+int main()
+{
+	// TUBE negative side: 0.7 * B / tanh(B) = 2 / tanh(2)
+	double lo = 1.0, hi = 10.0;
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		tube_B = 0.5 * (lo + hi);
+		if (0.7 * tube_B / tanh(tube_B) < 2.0 / tanh(2.0)) lo = tube_B;
+		else hi = tube_B;
+	}
+	printf("test_waveshaper: TUBE B = %.4f\n", tube_B);
+	for (uint32_t i = 0; i < sizeof(curves) / sizeof(curves[0]); i++) check(curves[i]);
+	return host_result("test_waveshaper");
+}
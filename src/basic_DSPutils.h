@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <arm_math.h>
+#include "basic_denormal.h"
+#include "AudioStream_F32.h"
 
 #define F32_TO_I32_NORM_FACTOR 	(2147483647) // which is 2^31-1
 #define I32_TO_F32_NORM_FACTOR 	(4.656612875245797e-10)   //which is 1/(2^31 - 1)
@@ -76,5 +78,19 @@ T map_sat(T x, A in_min, B in_max, C out_min, D out_max, typename std::enable_if
 	return (x - (T)in_min) * ((T)out_max - (T)out_min) / ((T)in_max - (T)in_min) + (T)out_min;
 }
 
+/**
+ * @brief Recalculate a one pole filter coefficient set for 44.1kHz
+ * 			to another sample rate, keeping the same cutoff frequency.
+ * 			For k = 1 - exp(-2*pi*fc/fs):  k' = 1 - (1-k)^(44100/fs)
+ * 
+ * @param k coefficient used at 44.1kHz (0.0f - 1.0f)
+ * @param fs new sample rate
+ * @return float32_t scaled coefficient
+ */
+static inline float32_t onepole_coeff_fs(float32_t k, float32_t fs)
+{
+	if (fs == AUDIO_SAMPLE_RATE_EXACT || k <= 0.0f || k >= 1.0f) return k;
+	return 1.0f - powf(1.0f - k, AUDIO_SAMPLE_RATE_EXACT / fs);
+}
 
 #endif // _BASIC_DSPUTILS_H_
@@ -12,22 +12,28 @@
 #define _FILTER_ALLPASS_H_
 
 #include "Arduino.h"
+#include "basic_memArena.h"
+#include "basic_denormal.h"
 template <int N>
 class AudioFilterAllpass
 {
 public:
 	AudioFilterAllpass() { bf = NULL; }
-	~AudioFilterAllpass() {	free(bf); }
+	~AudioFilterAllpass() {	AudioBasicMemArena::free(bf); }
 	/**
 	 * @brief Allocate the filter buffer in RAM
 	 * 			set the pointer to the allpass coeff
 	 * 
 	 * @param coeffPtr pointer to the allpas coeff variable
+	 * @param lenScale buffer length scaler, N is the length used at 44.1kHz, 
+	 * 			use fs/44100 for other sample rates
 	 */
-	bool init(float* coeffPtr)
+	bool init(float* coeffPtr, float lenScale=1.0f)
 	{
-		free(bf);
-		bf = (float *)malloc(N*sizeof(float)); // allocate buffer
+		AudioBasicMemArena::free(bf);
+		len = (uint32_t)((float)N * lenScale + 0.5f);
+		if (len < 1) len = 1;
+		bf = (float *)AudioBasicMemArena::alloc(len*sizeof(float), ARENA_RAM1); // allocate buffer
 		if (!bf) return false;
 		kPtr = coeffPtr;
 		reset();
@@ -39,7 +45,7 @@ public:
 	 */
 	void reset()
 	{
-		memset(bf, 0, N*sizeof(float));
+		memset(bf, 0, len*sizeof(float));
 		idx = 0;
 	}
 	/**
@@ -51,8 +57,8 @@ public:
 	float process(float in)
 	{
 		float out = bf[idx] + (*kPtr) * in;
-		bf[idx] = in - (*kPtr) * out;
-		if (++idx >= N) idx = 0;
+		bf[idx] = denormal_bias(in - (*kPtr) * out);
+		if (++idx >= len) idx = 0;
 		return out;
 	}
 	/**
@@ -74,23 +80,26 @@ public:
 	{
 		int32_t read_idx, read_idx_next; 
 		read_idx = idx - offset;
-		if (read_idx < 0) read_idx += N;
+		if (read_idx < 0) read_idx += len;
 		if (frac == 0.0f) return bf[read_idx];
 		read_idx_next = read_idx - 1;
-		if (read_idx_next < 0) read_idx_next += N;
+		if (read_idx_next < 0) read_idx_next += len;
 		return (bf[read_idx]*(1.0f-frac) + bf[read_idx_next]*frac);
 	}
 	inline void write_toOffset(float newSample, uint32_t offset)
 	{
 		int32_t write_idx;
 		write_idx = idx - offset;
-		if (write_idx < 0) write_idx += N;
+		if (write_idx < 0) write_idx += len;
 		bf[write_idx] = newSample;
-	}	
+	}
+	float* getBuffer() { return bf; }
+	uint32_t getSize() { return len; }
 private:
 	float *kPtr;
 	float *bf;
 	uint32_t idx;
+	uint32_t len = N;
 };
 
 
@@ -1,5 +1,10 @@
 #include "basic_bypassStereo_F32.h"
 
+#define BYPASS_SILENCE_REFS		(0x80)	// base reference count of the static silent block
+#define BYPASS_SILENCE_REFS_MAX	(0xF0)	// reset to the base before the 8bit count wraps
+
+static audio_block_f32_t silentBlock;
+
 bool bypass_process(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR, bypass_mode_t mode, bool state)
 {
 	bool result = false;
@@ -30,6 +35,7 @@ bool bypass_process(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR,
 			*p_blockL = NULL;
 			*p_blockR = NULL;
 			// no break - let it run through the next switch case, with input blocks as NULL it will emit silence on both channels
+			__attribute__((fallthrough));
 
 		/**
 		 * @brief PASS mode connects the input signal directly to the output
@@ -67,4 +73,62 @@ bool bypass_process(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR,
 			break;
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+void bypass_passThrough(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR, bypass_mode_t mode)
+{
+	if (mode != BYPASS_MODE_PASS)
+	{
+		if (*p_blockL) AudioStream_F32::release(*p_blockL);			// discard both input blocks
+		if (*p_blockR) AudioStream_F32::release(*p_blockR);
+		*p_blockL = NULL;
+		*p_blockR = NULL;
+	}
+	if (!*p_blockL) *p_blockL = bypass_silence();
+	if (!*p_blockR) *p_blockR = bypass_silence();
+}
+
+audio_block_f32_t* bypass_silence()
+{
+	__disable_irq();
+	if (silentBlock.ref_count < BYPASS_SILENCE_REFS)	// first use, data is zeroed as a static object
+	{
+		silentBlock.ref_count = BYPASS_SILENCE_REFS;
+		silentBlock.length = AUDIO_BLOCK_SAMPLES;
+	}
+	// unreleased references would wrap the count past 255, the next release() would
+	// then hand the static block to the pool. The references still held are
+	// released from the base count, it stays above 1 while less than 0x70 are held.
+	if (silentBlock.ref_count >= BYPASS_SILENCE_REFS_MAX) silentBlock.ref_count = BYPASS_SILENCE_REFS;
+	silentBlock.ref_count++;
+	__enable_irq();
+	return &silentBlock;
+}
+
+void bypass_xfade_f32(float32_t *wet, const float32_t *dry, float32_t g0, float32_t g1, uint32_t len)
+{
+	float32_t dg = (g1 - g0) / (float32_t)len;
+	float32_t g = g0 + dg;
+	float32_t d0, d1, d2, d3;
+	uint32_t blkCnt = len >> 2;
+	// 4 samples per loop, independent multiply-adds keep the FPU pipeline busy
+	while (blkCnt--)
+	{
+		d0 = dry[0]; d1 = dry[1]; d2 = dry[2]; d3 = dry[3];
+		wet[0] = d0 + (wet[0] - d0) * g;
+		wet[1] = d1 + (wet[1] - d1) * (g + dg);
+		wet[2] = d2 + (wet[2] - d2) * (g + 2.0f*dg);
+		wet[3] = d3 + (wet[3] - d3) * (g + 3.0f*dg);
+		g += 4.0f*dg;
+		wet += 4;
+		dry += 4;
+	}
+	blkCnt = len & 0x03;
+	while (blkCnt--)
+	{
+		d0 = *dry++;
+		*wet = d0 + (*wet - d0) * g;
+		wet++;
+		g += dg;
+	}
+}
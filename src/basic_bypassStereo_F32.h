@@ -27,5 +27,138 @@ typedef enum
  */
 bool bypass_process(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR, bypass_mode_t mode, bool state);
 
+/**
+ * @brief Read only bypass path, no audio memory is allocated
+ * 			Use with blocks received via receiveReadOnly_f32() when the effect is bypassed.
+ * 			The blocks can be transmitted untouched, missing inputs are replaced by the shared silent block.
+ * 			Release the blocks after transmitting them as usual.
+ * 
+ * @param p_blockL 	pointer to an audio_block_f32_t pointer received in the main component, channel L
+ * @param p_blockR 	pointer to an audio_block_f32_t pointer received in the main component, channel R
+ * @param mode 		BYPASS_MODE_PASS passes the input, BYPASS_MODE_OFF and BYPASS_MODE_TRAILS output silence
+ */
+void bypass_passThrough(audio_block_f32_t** p_blockL, audio_block_f32_t** p_blockR, bypass_mode_t mode);
+
+/**
+ * @brief Shared read only silent block
+ * 			Each call takes a reference, the block is released like any other one. 
+ * 			Its reference count starts high, so it is never returned to the audio memory pool.
+ * 			The count is reset to the base value before it can wrap (8 bit), which is safe
+ * 			as long as less than 112 references to the silent block are held at the same
+ * 			time (2 per stereo effect in bypass, released every audio cycle).
+ * 			Downstream components calling receiveWritable_f32() get a copy.
+ * 
+ * @return audio_block_f32_t* silent block, do not write into it
+ */
+audio_block_f32_t* bypass_silence();
+
+/**
+ * @brief Crossfade kernel, wet = dry + (wet - dry) * g
+ * 			g is ramped linearly from g0 to g1 over the block
+ * 
+ * @param wet 	processed signal, overwritten with the result
+ * @param dry 	dry signal
+ * @param g0 	wet gain at the start of the block
+ * @param g1 	wet gain at the end of the block
+ * @param len 	number of samples
+ */
+void bypass_xfade_f32(float32_t *wet, const float32_t *dry, float32_t g0, float32_t g1, uint32_t len);
+
+#define BYPASS_XFADE_BLOCKS_DEFAULT	(8)		// ~23ms at 44.1kHz, 128 samples per block
+
+/**
+ * @brief Crossfading bypass state machine
+ * 			Switching the bypass fades between the processed and the dry signal 
+ * 			over a number of audio blocks. Outside the fade the effect either
+ * 			processes the audio with no extra cost or passes the read only input blocks.
+ * 			Usage inside the update() function:
+ * 				if (bpx.passThrough()) -> pass the read only blocks, return
+ * 				receive writable blocks, bpx.storeDry(L, R, len) 
+ * 				process the audio in place
+ * 				bpx.process(L, R, len)
+ */
+class AudioBasicBypassXfade
+{
+public:
+	AudioBasicBypassXfade(bool state=true, uint16_t blocks=BYPASS_XFADE_BLOCKS_DEFAULT)
+	{
+		bp = state;
+		gain = bp ? 0.0f : 1.0f;
+		setFadeBlocks(blocks);
+	}
+	/**
+	 * @brief set the bypass state, starts the crossfade
+	 * 
+	 * @param state true = bypass (effect off)
+	 */
+	void set(bool state)
+	{
+		__disable_irq();
+		bp = state;
+		__enable_irq();
+	}
+	bool get() { return bp; }
+	bool tgl()
+	{
+		set(bp ^ 1);
+		return bp;
+	}
+	/**
+	 * @brief fade length in audio blocks, minimum 1 
+	 */
+	void setFadeBlocks(uint16_t blocks)
+	{
+		if (!blocks) blocks = 1;
+		__disable_irq();
+		step = 1.0f / (float32_t)blocks;
+		__enable_irq();
+	}
+	/**
+	 * @brief effect fully bypassed, the input blocks can be passed without processing
+	 */
+	bool passThrough() { return bp && gain == 0.0f; }
+	/**
+	 * @brief crossfade in progress
+	 */
+	bool fading() { return bp ? gain > 0.0f : gain < 1.0f; }
+	/**
+	 * @brief true if the dry signal was stored for the current block, 
+	 * 			process() will mix it in
+	 */
+	bool xfadeActive() { return xfade; }
+	/**
+	 * @brief keep a copy of the input blocks if the crossfade is running,
+	 * 			call before processing the audio in place
+	 */
+	void storeDry(const float32_t *dryL, const float32_t *dryR, uint32_t len)
+	{
+		xfade = fading();
+		if (!xfade) return;
+		memcpy(dry[0], dryL, len * sizeof(float32_t));
+		memcpy(dry[1], dryR, len * sizeof(float32_t));
+	}
+	/**
+	 * @brief mix the processed blocks with the stored dry signal,
+	 * 			advances the crossfade by one block
+	 */
+	void process(float32_t *wetL, float32_t *wetR, uint32_t len)
+	{
+		if (!xfade) return;
+		float32_t g0 = gain;
+		float32_t g1 = bp ? g0 - step : g0 + step;
+		g1 = constrain(g1, 0.0f, 1.0f);
+		bypass_xfade_f32(wetL, dry[0], g0, g1, len);
+		bypass_xfade_f32(wetR, dry[1], g0, g1, len);
+		gain = g1;
+		xfade = false;
+	}
+private:
+	float32_t dry[2][AUDIO_BLOCK_SAMPLES];
+	float32_t gain;			// wet gain, 0 = bypass
+	float32_t step;
+	bool bp;
+	bool xfade = false;
+};
+
 
 #endif // _BASIC_BYPASSSTEREO_F32_H_
@@ -5,9 +5,19 @@
 #include "basic_delay.h"
 #include "basic_lfo.h"
 #include "basic_shelvFilter.h"
+#include "basic_crossover.h"
+#include "basic_oversampler.h"
+#include "basic_waveshaper.h"
 #include "basic_pitch.h"
 #include "basic_DSPutils.h"
+#include "basic_denormal.h"
+#include "basic_fastMath.h"
+#include "basic_dynamics.h"
+#include "basic_memArena.h"
+#include "basic_memCleaner.h"
 #include "basic_tempBuffer.h"
+#include "basic_tapTempo.h"
 #include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
 
 #endif // _BASIC_COMPONENTS_H_
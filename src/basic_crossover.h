@@ -0,0 +1,160 @@
+/**
+ * @file basic_crossover.h
+ * @author Piotr Zapart
+ * @brief Stereo biquad and Linkwitz-Riley (LR4) crossover
+ * 			Both channels are processed in the same loop with shared coefficients
+ * 			(transposed direct form II, same as the CMSIS stereo df2T biquad),
+ * 			the coefficients stay in registers for the L and R samples.
+ * 			LR4 = two cascaded 2nd order Butterworth sections. The low and high
+ * 			outputs are in phase and sum to a 2nd order allpass, which is
+ * 			available to phase align the bands that did not go through the split.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_CROSSOVER_H_
+#define _BASIC_CROSSOVER_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+
+#define CROSSOVER_Q_BUTTERWORTH		(0.70710678f)
+
+class AudioBasicBiquadStereo
+{
+public:
+	typedef enum
+	{
+		BIQUAD_LOWPASS,
+		BIQUAD_HIGHPASS,
+		BIQUAD_ALLPASS
+	}biquad_type_t;
+	/**
+	 * @brief set the filter coefficients (RBJ cookbook), the filter state is kept
+	 */
+	void set(biquad_type_t type, float32_t freq, float32_t q, float32_t fs)
+	{
+		float32_t w0 = 2.0f * PI * freq / fs;
+		float32_t cosW0 = cosf(w0);
+		float32_t alpha = sinf(w0) / (2.0f * q);
+		float32_t scale = 1.0f / (1.0f + alpha);
+		float32_t c[5];
+		switch (type)
+		{
+			case BIQUAD_LOWPASS:
+				c[0] = (1.0f - cosW0) * 0.5f * scale;
+				c[1] = (1.0f - cosW0) * scale;
+				c[2] = c[0];
+				break;
+			case BIQUAD_HIGHPASS:
+				c[0] = (1.0f + cosW0) * 0.5f * scale;
+				c[1] = -(1.0f + cosW0) * scale;
+				c[2] = c[0];
+				break;
+			case BIQUAD_ALLPASS:
+			default:
+				c[0] = (1.0f - alpha) * scale;
+				c[1] = -2.0f * cosW0 * scale;
+				c[2] = 1.0f;
+				break;
+		}
+		c[3] = 2.0f * cosW0 * scale;		// feedback terms with the CMSIS sign
+		c[4] = -(1.0f - alpha) * scale;
+		__disable_irq();
+		memcpy(coef, c, sizeof(coef));
+		__enable_irq();
+	}
+	void reset()
+	{
+		zL[0] = zL[1] = zR[0] = zR[1] = 0.0f;
+	}
+	/**
+	 * @brief filter one stereo sample
+	 */
+	inline void process(float32_t &l, float32_t &r)
+	{
+		float32_t yL = coef[0] * l + zL[0];
+		float32_t yR = coef[0] * r + zR[0];
+		zL[0] = coef[1] * l + coef[3] * yL + zL[1];
+		zR[0] = coef[1] * r + coef[3] * yR + zR[1];
+		zL[1] = coef[2] * l + coef[4] * yL;
+		zR[1] = coef[2] * r + coef[4] * yR;
+		l = yL;
+		r = yR;
+	}
+	/**
+	 * @brief filter a stereo block, in place allowed
+	 */
+	void process(const float32_t *inL, const float32_t *inR, float32_t *outL, float32_t *outR, uint32_t len)
+	{
+		float32_t l, r;
+		for (uint32_t i = 0; i < len; i++)
+		{
+			l = inL[i];
+			r = inR[i];
+			process(l, r);
+			outL[i] = l;
+			outR[i] = r;
+		}
+	}
+private:
+	float32_t coef[5] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};	// b0, b1, b2, -a1, -a2
+	float32_t zL[2] = {0.0f, 0.0f};
+	float32_t zR[2] = {0.0f, 0.0f};
+};
+
+class AudioBasicCrossoverLR4
+{
+public:
+	void freq(float32_t f, float32_t fs)
+	{
+		lp1.set(AudioBasicBiquadStereo::BIQUAD_LOWPASS, f, CROSSOVER_Q_BUTTERWORTH, fs);
+		lp2.set(AudioBasicBiquadStereo::BIQUAD_LOWPASS, f, CROSSOVER_Q_BUTTERWORTH, fs);
+		hp1.set(AudioBasicBiquadStereo::BIQUAD_HIGHPASS, f, CROSSOVER_Q_BUTTERWORTH, fs);
+		hp2.set(AudioBasicBiquadStereo::BIQUAD_HIGHPASS, f, CROSSOVER_Q_BUTTERWORTH, fs);
+		ap.set(AudioBasicBiquadStereo::BIQUAD_ALLPASS, f, CROSSOVER_Q_BUTTERWORTH, fs);
+	}
+	void reset()
+	{
+		lp1.reset();
+		lp2.reset();
+		hp1.reset();
+		hp2.reset();
+		ap.reset();
+	}
+	/**
+	 * @brief split the stereo signal into the low and high band, single pass
+	 * 			the high band can be written over the input
+	 */
+	void split(const float32_t *inL, const float32_t *inR, float32_t *lowL, float32_t *lowR,
+				float32_t *highL, float32_t *highR, uint32_t len)
+	{
+		float32_t lL, lR, hL, hR;
+		for (uint32_t i = 0; i < len; i++)
+		{
+			lL = hL = inL[i];
+			lR = hR = inR[i];
+			lp1.process(lL, lR);
+			lp2.process(lL, lR);
+			hp1.process(hL, hR);
+			hp2.process(hL, hR);
+			lowL[i] = lL;
+			lowR[i] = lR;
+			highL[i] = hL;
+			highR[i] = hR;
+		}
+	}
+	/**
+	 * @brief the low + high phase response, in place
+	 */
+	void allpass(float32_t *dataL, float32_t *dataR, uint32_t len)
+	{
+		ap.process(dataL, dataR, dataL, dataR, len);
+	}
+private:
+	AudioBasicBiquadStereo lp1, lp2, hp1, hp2, ap;
+};
+
+#endif // _BASIC_CROSSOVER_H_
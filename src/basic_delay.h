@@ -12,47 +12,136 @@
 #define _BASIC_DELAY_H_
 
 #include "Arduino.h"
+#include "arm_math.h"
+#include "basic_memArena.h"
 
 
+#define BASIC_DELAY_GUARD	(4)		// samples mirrored past the end of the buffer, used by the interpolated reads
+#define BASIC_DELAY_XFER	(AUDIO_BLOCK_SAMPLES)	// backing store transfer buffer, samples
+
+typedef enum
+{
+	DELAY_STORAGE_F32,		// float, full precision
+	DELAY_STORAGE_I16,		// int16 with TPDF dither, half the memory
+	DELAY_STORAGE_F16		// IEEE754 half float, half the memory
+}delay_storage_t;
+
+/**
+ * @brief Backing store interface for the delay lines not mapped in the address space
+ * 			(SPI memory, DMA driven external RAM, simulated store in the host tests).
+ * 			Addresses are byte offsets from the start of the delay buffer, the store
+ * 			has to provide AudioBasicDelay::getSizeBytes() bytes.
+ * 			Each call is one transaction, readBlock/writeBlock issue them per burst.
+ */
+class AudioBasicDelayStore
+{
+public:
+	virtual void read(uint32_t addr, void *dst, uint32_t bytes) = 0;
+	virtual void write(uint32_t addr, const void *src, uint32_t bytes) = 0;
+};
+
 /**
  * @brief Basic delay line with buffer placed in PSRAM
- * 
- * @tparam N delay length in samples (float)
+ * 			The first BASIC_DELAY_GUARD samples are mirrored after the end of the buffer,
+ * 			interpolated reads use contiguous 4 samples without wrapping.
+ * 			Optional power of two mode rounds the size up and uses mask based wrapping.
+ * 			16bit storage formats (int16, float16) halve the memory use. Samples are
+ * 			converted in readBlock/writeBlock, the per sample access functions
+ * 			(getTap, getTapHermite, process, write_toOffset) require DELAY_STORAGE_F32.
+ * 			The buffer can be placed in an AudioBasicDelayStore, then only the burst
+ * 			access (readBlock/writeBlock) is available.
  */
-//template <int N>
 class AudioBasicDelay
 {
 public:
-	AudioBasicDelay() { bf = NULL; }
+	AudioBasicDelay() { bf = NULL; backing = NULL; xfer = NULL; }
 	~AudioBasicDelay()
 	{
-		free(bf);
+		freeBuffer();
 	}
-	bool init(uint32_t size_samples,  bool psram=false)
+	/**
+	 * @brief allocate the delay buffer
+	 * 
+	 * @param size_samples delay length in samples
+	 * @param psram place the buffer in PSRAM
+	 * @param pow2 round the size up to the next power of two, indexing uses a bit mask
+	 * 			instead of compare/modulo. Use getSize() to read the actual length.
+	 * @param storage sample format used in the buffer
+	 * @return true on success
+	 */
+	bool init(uint32_t size_samples,  bool psram=false, bool pow2=false, delay_storage_t storage=DELAY_STORAGE_F32)
 	{
-		free(bf);
+		freeBuffer();
 		use_psram = psram;
+		fmt = storage;
+		smpl_bytes = fmt == DELAY_STORAGE_F32 ? sizeof(float32_t) : sizeof(int16_t);
+		if (size_samples < BASIC_DELAY_GUARD) size_samples = BASIC_DELAY_GUARD;
+		if (pow2)
+		{
+			uint32_t s = 1;
+			while (s < size_samples) s <<= 1;
+			size_samples = s;
+			mask = s - 1;
+		}
+		else mask = 0;
 		size = size_samples;
-		if (use_psram) 	bf = (float *)extmem_malloc(size * sizeof(float)); 	// allocate buffer in PSRAM
-		else 			bf = (float *)malloc(size * sizeof(float)); 		// allocate buffer in DMARAM
-		if (!bf) return false;
 		idx = 0;
+		if (backing)
+		{
+			// transfer buffer for the 16bit conversion and reset
+			xfer = (uint8_t *)AudioBasicMemArena::alloc(BASIC_DELAY_XFER * smpl_bytes, ARENA_RAM2);
+			if (!xfer) return false;
+			reset();
+			return true;
+		}
+		uint32_t bytes = getSizeBytes();
+		bf = (float *)AudioBasicMemArena::alloc(bytes, use_psram ? ARENA_PSRAM : ARENA_RAM2);
+		if (!bf) return false;
 		reset();
 		return true;
 	}
+	/**
+	 * @brief place the buffer in a backing store, set before init()
+	 * 			NULL returns to the buffer allocated in RAM/PSRAM
+	 */
+	void setStore(AudioBasicDelayStore *store)
+	{
+		freeBuffer();
+		backing = store;
+	}
 	void reset()
 	{
-		memset(bf, 0, size * sizeof(float32_t));
-		if (use_psram) arm_dcache_flush_delete(&bf[0], size * sizeof(float32_t));
+		if (backing)
+		{
+			storeZero(0, size + BASIC_DELAY_GUARD);
+			return;
+		}
+		memset(bf, 0, getSizeBytes());
+		if (use_psram) arm_dcache_flush_delete(&bf[0], getSizeBytes());
 	}
 	void reset(uint32_t startAddr, uint32_t endAddr)
 	{
 		if (startAddr > endAddr) return;
 		if (endAddr > (uint32_t)size) endAddr = size;
-		float32_t* memPtr = &bf[0]+startAddr;
-		uint32_t l = (endAddr - startAddr) * sizeof(float32_t);
+		if (backing)
+		{
+			storeZero(startAddr, endAddr - startAddr);
+			if (startAddr < BASIC_DELAY_GUARD)
+				storeZero(size + startAddr, (endAddr < BASIC_DELAY_GUARD ? endAddr : BASIC_DELAY_GUARD) - startAddr);
+			return;
+		}
+		uint8_t* memPtr = (uint8_t *)bf + startAddr * smpl_bytes;
+		uint32_t l = (endAddr - startAddr) * smpl_bytes;
 		memset(memPtr, 0, l);
 		if (use_psram) arm_dcache_flush_delete(memPtr, l);
+		if (startAddr < BASIC_DELAY_GUARD) 	// keep the guard in sync
+		{
+			uint32_t g = endAddr < BASIC_DELAY_GUARD ? endAddr : BASIC_DELAY_GUARD;
+			memPtr = (uint8_t *)bf + (size + startAddr) * smpl_bytes;
+			l = (g - startAddr) * smpl_bytes;
+			memset(memPtr, 0, l);
+			if (use_psram) arm_dcache_flush_delete(memPtr, l);
+		}
 	}
 	/**
 	 * @brief get the tap from the delay buffer
@@ -62,33 +151,102 @@ public:
 	 */
 	inline float getTap(uint32_t offset, float frac=0.0f)
 	{
-		int32_t read_idx, read_idx_next; 
+		int32_t read_idx; 
 		read_idx = idx - offset;
-		if (read_idx < 0) read_idx += size;
+		if (mask) read_idx &= mask;
+		else if (read_idx < 0) read_idx += size;
 		if (frac == 0.0f) return bf[read_idx];
-		read_idx_next = read_idx - 1;
-		if (read_idx_next < 0) read_idx_next += size;
-		return (bf[read_idx]*(1.0f-frac) + bf[read_idx_next]*frac);
+		float prev = read_idx ? bf[read_idx - 1] : bf[size - 1];
+		return (bf[read_idx]*(1.0f-frac) + prev*frac);
 	}
-
-    inline const float getTapHermite(float delay) const
+	/**
+	 * @brief 4 point Hermite interpolated read
+	 * 
+	 * @param delay read position relative to the write index, 0 to size-1
+	 */
+    inline float getTapHermite(float delay) const
     {
         int32_t delay_integral   = static_cast<int32_t>(delay);
         float   delay_fractional = delay - static_cast<float>(delay_integral);
 
-        int32_t     t     = (idx + delay_integral + size);
-        const float     xm1   = bf[(t - 1) % size];
-        const float     x0    = bf[(t) % size];
-        const float     x1    = bf[(t + 1) % size];
-        const float     x2    = bf[(t + 2) % size];
+        int32_t t = idx + delay_integral - 1;
+		if (mask) t &= mask;
+		else
+		{
+			if (t < 0) t += size;
+			else if (t >= size) t -= size;
+		}
+		return hermite(&bf[t], delay_fractional);	// 4 contiguous samples, guard area covers the end
+    }
+	/**
+	 * @brief 4 point Hermite interpolation
+	 * 
+	 * @param p pointer to 4 samples x[-1], x[0], x[1], x[2]
+	 * @param f fractional position between x[0] and x[1]
+	 */
+	static inline float hermite(const float *p, float f)
+	{
+        const float     xm1   = p[0];
+        const float     x0    = p[1];
+        const float     x1    = p[2];
+        const float     x2    = p[3];
         const float c     = (x1 - xm1) * 0.5f;
         const float v     = x0 - x1;
         const float w     = c + v;
         const float a     = w + v + (x2 - x0) * 0.5f;
         const float b_neg = w + a;
-        const float f     = delay_fractional;
         return (((a * f) - b_neg) * f + c) * f + x0;
-    }
+	}
+	/**
+	 * @brief Copy a contiguous section of the buffer in one or two bursts
+	 * 			Used to stage the read window of a whole audio block in internal RAM
+	 * 
+	 * @param dst destination buffer
+	 * @param pos start position relative to the write index, same as in getTapHermite()
+	 * @param len number of samples
+	 */
+	void readBlock(float *dst, int32_t pos, uint32_t len)
+	{
+		int32_t s = idx + pos;
+		if (mask) s &= mask;
+		else
+		{
+			while (s < 0) s += size;
+			while (s >= size) s -= size;
+		}
+		uint32_t l = size + BASIC_DELAY_GUARD - s;	// guard samples extend the first burst
+		if (l > len) l = len;
+		load(dst, s, l);
+		if (l < len)
+		{
+			// continue from the start, skipping the already copied guard samples
+			uint32_t g = l - (size - s);
+			load(dst + l, g, len - l);
+		}
+	}
+	/**
+	 * @brief Write a block of samples starting at the write index, advance the index
+	 * 			Replaces len calls to write_toOffset(x, 0) + updateIndex()
+	 * 
+	 * @param src source samples
+	 * @param len number of samples, max. buffer size
+	 */
+	void writeBlock(const float *src, uint32_t len)
+	{
+		uint32_t l = size - idx;
+		if (l > len) l = len;
+		store(idx, src, l);
+		if (l < len) store(0, src + l, len - l);
+		idx += len;
+		if (mask) idx &= mask;
+		else if (idx >= size) idx -= size;
+	}
+	/**
+	 * @brief number of memory transactions done by readBlock/writeBlock,
+	 * 			including the guard updates
+	 */
+	uint32_t getBurstCount() { return burstCount; }
+	void resetBurstCount() { burstCount = 0; }
 
 	/**
 	 * @brief read last sample and write a new one
@@ -99,26 +257,237 @@ public:
 	inline float process(float newSample)
 	{
 		float out = bf[idx];
-		bf[idx] = newSample;
-		
+		write(idx, newSample);
 		return out; 
 	}
 	inline void write_toOffset(float newSample, uint32_t offset)
 	{
 		int32_t write_idx;
 		write_idx = idx - offset;
-		if (write_idx < 0) write_idx += size;
-		bf[write_idx] = newSample;
+		if (mask) write_idx &= mask;
+		else if (write_idx < 0) write_idx += size;
+		write(write_idx, newSample);
 	}
 	inline void updateIndex()
 	{
-		if (++idx >= size) idx = 0;
+		if (mask) idx = (idx + 1) & mask;
+		else if (++idx >= size) idx = 0;
 	}
+	float32_t* getBuffer() { return bf; }
+	uint32_t getSize() { return size; }
+	uint32_t getSizeBytes() { return (size + BASIC_DELAY_GUARD) * smpl_bytes; } // including the guard
+	bool isInPSRAM() { return use_psram && !backing; }
+	AudioBasicDelayStore *getStore() { return backing; }
+	bool isPow2() { return mask != 0; }
+	delay_storage_t getStorage() { return fmt; }
 private:
 	int32_t size; 
 	float *bf;
+	AudioBasicDelayStore *backing;
+	uint8_t *xfer;			// backing store only
 	int32_t idx;
+	int32_t mask = 0;
 	bool use_psram = false;
+	uint32_t burstCount = 0;
+	delay_storage_t fmt = DELAY_STORAGE_F32;
+	uint8_t smpl_bytes = sizeof(float32_t);
+	uint32_t dither_seed = 22222;
+	/**
+	 * @brief convert n samples starting at buffer index i to float
+	 */
+	void load(float *dst, uint32_t i, uint32_t n)
+	{
+		burstCount++;
+		if (!backing)
+		{
+			decode(dst, (uint8_t *)bf + i * smpl_bytes, n);
+			return;
+		}
+		// 16bit samples are read to the upper half of dst and converted in place
+		uint8_t *raw = (uint8_t *)dst + n * (sizeof(float) - smpl_bytes);
+		backing->read(i * smpl_bytes, raw, n * smpl_bytes);
+		decode(dst, raw, n);
+	}
+	/**
+	 * @brief convert n float samples and store them at buffer index i,
+	 * 			samples written to the start of the buffer are mirrored in the guard area
+	 */
+	void store(uint32_t i, const float *src, uint32_t n)
+	{
+		uint32_t g;
+		if (!backing)
+		{
+			uint8_t *dst = (uint8_t *)bf + i * smpl_bytes;
+			burstCount++;
+			encode(dst, src, n);
+			if (i < BASIC_DELAY_GUARD)
+			{
+				g = n < BASIC_DELAY_GUARD - i ? n : BASIC_DELAY_GUARD - i;
+				memcpy((uint8_t *)bf + (size + i) * smpl_bytes, dst, g * smpl_bytes);
+				burstCount++;
+			}
+			return;
+		}
+		while (n)
+		{
+			uint32_t c = n;
+			const void *raw = src;
+			if (fmt != DELAY_STORAGE_F32)
+			{
+				if (c > BASIC_DELAY_XFER) c = BASIC_DELAY_XFER;
+				encode(xfer, src, c);
+				raw = xfer;
+			}
+			backing->write(i * smpl_bytes, raw, c * smpl_bytes);
+			burstCount++;
+			if (i < BASIC_DELAY_GUARD)
+			{
+				g = c < BASIC_DELAY_GUARD - i ? c : BASIC_DELAY_GUARD - i;
+				backing->write((size + i) * smpl_bytes, raw, g * smpl_bytes);
+				burstCount++;
+			}
+			i += c;
+			src += c;
+			n -= c;
+		}
+	}
+	/**
+	 * @brief clear n samples of the backing store starting at buffer index i
+	 */
+	void storeZero(uint32_t i, uint32_t n)
+	{
+		memset(xfer, 0, BASIC_DELAY_XFER * smpl_bytes);
+		while (n)
+		{
+			uint32_t c = n > BASIC_DELAY_XFER ? BASIC_DELAY_XFER : n;
+			backing->write(i * smpl_bytes, xfer, c * smpl_bytes);
+			i += c;
+			n -= c;
+		}
+	}
+	/**
+	 * @brief stored format to float, src may overlap the end of dst (in place conversion)
+	 */
+	void decode(float *dst, const void *src, uint32_t n)
+	{
+		switch(fmt)
+		{
+			case DELAY_STORAGE_I16:
+			{
+				const int16_t *s = (const int16_t *)src;
+				while (n--) *dst++ = (float32_t)*s++ * (1.0f / 32768.0f);
+				break;
+			}
+			case DELAY_STORAGE_F16:
+			{
+				const uint16_t *s = (const uint16_t *)src;
+				while (n--) *dst++ = f16_to_f32(*s++);
+				break;
+			}
+			default:
+				if (dst != src) memcpy(dst, src, n * sizeof(float));
+				break;
+		}
+	}
+	/**
+	 * @brief float to the stored format
+	 */
+	void encode(void *dst, const float *src, uint32_t n)
+	{
+		switch(fmt)
+		{
+			case DELAY_STORAGE_I16:
+			{
+				int16_t *d = (int16_t *)dst;
+				uint32_t seed = dither_seed;
+				int32_t v;
+				while (n--)
+				{
+					// TPDF dither, sum of two uniform +-0.5LSB random values
+					// two LCG draws, high 16 bits of each (the low bits of an LCG are periodic)
+					seed = seed * 1664525u + 1013904223u;
+					int32_t r1 = (int32_t)(seed >> 16);
+					seed = seed * 1664525u + 1013904223u;
+					float32_t r = (float32_t)(r1 + (int32_t)(seed >> 16) - 65535) * (1.0f / 65536.0f);
+					v = (int32_t)floorf(*src++ * 32768.0f + r + 0.5f);
+					if (v > 32767) v = 32767;
+					else if (v < -32768) v = -32768;
+					*d++ = (int16_t)v;
+				}
+				dither_seed = seed;
+				break;
+			}
+			case DELAY_STORAGE_F16:
+			{
+				uint16_t *d = (uint16_t *)dst;
+				while (n--) *d++ = f32_to_f16(*src++);
+				break;
+			}
+			default:
+				memcpy(dst, src, n * sizeof(float));
+				break;
+		}
+	}
+	/**
+	 * @brief float to IEEE754 half conversion, round to nearest even, 
+	 * 			subnormals handled, overflow saturates to inf
+	 * 			F. Giesen "float->half variants"
+	 */
+	static inline uint16_t f32_to_f16(float f)
+	{
+		union { float f; uint32_t u; } x = { f };
+		const union { uint32_t u; float f; } denorm_magic = { ((127 - 15) + (23 - 10) + 1) << 23 };
+		uint32_t sign = x.u & 0x80000000u;
+		uint16_t o;
+		x.u ^= sign;
+		if (x.u >= ((127 + 16) << 23)) o = 0x7C00;		// too large or NaN, use inf
+		else if (x.u < (113 << 23))						// subnormal or zero
+		{
+			x.f += denorm_magic.f;
+			o = x.u - denorm_magic.u;
+		}
+		else
+		{
+			uint32_t mant_odd = (x.u >> 13) & 1;
+			x.u += ((uint32_t)(15 - 127) << 23) + 0xFFF;
+			x.u += mant_odd;
+			o = x.u >> 13;
+		}
+		return o | (sign >> 16);
+	}
+	static inline float f16_to_f32(uint16_t h)
+	{
+		const union { uint32_t u; float f; } magic = { 113 << 23 };
+		const uint32_t shifted_exp = 0x7C00 << 13;
+		union { uint32_t u; float f; } o;
+		o.u = (h & 0x7FFF) << 13;
+		uint32_t exp = shifted_exp & o.u;
+		o.u += (127 - 15) << 23;
+		if (exp == shifted_exp) o.u += (128 - 16) << 23;	// inf/NaN
+		else if (exp == 0)								// zero/subnormal
+		{
+			o.u += 1 << 23;
+			o.f -= magic.f;
+		}
+		o.u |= (uint32_t)(h & 0x8000) << 16;
+		return o.f;
+	}
+	inline void write(int32_t i, float newSample)
+	{
+		bf[i] = newSample;
+		if (i < BASIC_DELAY_GUARD) bf[size + i] = newSample;
+	}
+	void freeBuffer()
+	{
+		if (xfer)
+		{
+			AudioBasicMemArena::free(xfer);
+			xfer = NULL;
+		}
+		if (!bf) return;
+		AudioBasicMemArena::free(bf);
+		bf = NULL;
+	}
 };
 
 #endif // _BASIC_DELAY_H_
@@ -0,0 +1,135 @@
+/**
+ * @file basic_denormal.h
+ * @author Piotr Zapart
+ * @brief Scoped flush-to-zero guard for recursive DSP structures
+ *
+ * Reverb/delay feedback loops, one pole filters and envelope followers
+ * decay towards subnormal floats on silence. Depending on the FPU this
+ * can slow down every operation on such numbers by a large factor.
+ * The guard enables the FZ (ARM) or FTZ/DAZ (x86 SSE) mode for the
+ * lifetime of the object and restores the previous FPU control word
+ * on exit. Place it at the top of the update() function.
+ *
+ * Define AUDIO_DENORMAL_FTZ as 0 before including the library to
+ * compile the guard out.
+ *
+ * Fallback for FPUs without a known flush-to-zero control (or with the
+ * guard compiled out): denormal_bias() adds a tiny offset (-360dBFS) to
+ * the state of the recursive structures, which then settles at a small
+ * normal value instead of decaying into the subnormal range. Used in the
+ * allpass, shelving/lowpass, TDF2 filters and the hand written feedback
+ * loops of the effects. With the FTZ guard available it compiles to
+ * nothing. AUDIO_DENORMAL_BIAS 0/1 forces it off/on.
+ *
+ * @version 1.0
+ * @date 2024-10-19
+ * 
+ * @copyright Copyright (c) 2024
+ * 
+ */
+#ifndef _BASIC_DENORMAL_H_
+#define _BASIC_DENORMAL_H_
+
+#include <Arduino.h>
+
+#ifndef AUDIO_DENORMAL_FTZ
+	#define AUDIO_DENORMAL_FTZ	1
+#endif
+
+#if !defined(__ARM_FP) && !defined(__aarch64__) && defined(__SSE__)
+	#include <xmmintrin.h>
+#endif
+
+#define BASIC_DENORMAL_ARM_FZ		(1UL<<24)	// FPSCR/FPCR flush-to-zero bit
+#define BASIC_DENORMAL_SSE_FTZ_DAZ	(0x8040)	// MXCSR FTZ (bit15) + DAZ (bit6)
+#define BASIC_DENORMAL_BIAS_VALUE	(1.0e-18f)
+
+#ifndef AUDIO_DENORMAL_BIAS
+	#if AUDIO_DENORMAL_FTZ && (defined(__ARM_FP) || defined(__aarch64__) || defined(__SSE__))
+		#define AUDIO_DENORMAL_BIAS	0
+	#else
+		#define AUDIO_DENORMAL_BIAS	1
+	#endif
+#endif
+
+/**
+ * @brief bias injection for the recursive states, see above
+ */
+static inline float denormal_bias(float x)
+{
+#if AUDIO_DENORMAL_BIAS
+	return x + BASIC_DENORMAL_BIAS_VALUE;
+#else
+	return x;
+#endif
+}
+
+/**
+ * @brief Enables the FPU flush-to-zero mode for the current scope
+ *  Cortex-M7 FZ mode flushes both the subnormal inputs and results.
+ *  On targets without a known FPU control register the guard does nothing,
+ *  denormal_bias() is active instead.
+ */
+class AudioBasicDenormalGuard
+{
+public:
+	AudioBasicDenormalGuard()
+	{
+#if AUDIO_DENORMAL_FTZ
+		ctrl = read();
+		write(ctrl | mask);
+#endif
+	}
+	~AudioBasicDenormalGuard()
+	{
+#if AUDIO_DENORMAL_FTZ
+		write(ctrl);
+#endif
+	}
+	/**
+	 * @brief check if the FTZ mode is currently active
+	 */
+	static bool active()
+	{
+		return (read() & mask) == mask && mask;
+	}
+private:
+	AudioBasicDenormalGuard(const AudioBasicDenormalGuard&) = delete;
+	AudioBasicDenormalGuard& operator=(const AudioBasicDenormalGuard&) = delete;
+	uint32_t ctrl;
+#if defined(__ARM_FP) && !defined(__aarch64__)
+	static const uint32_t mask = BASIC_DENORMAL_ARM_FZ;
+	static inline uint32_t read()
+	{
+		uint32_t r;
+		__asm__ volatile("VMRS %0, fpscr" : "=r"(r));
+		return r;
+	}
+	static inline void write(uint32_t r)
+	{
+		__asm__ volatile("VMSR fpscr, %0" : : "r"(r) : "memory");
+	}
+#elif defined(__aarch64__)
+	static const uint32_t mask = BASIC_DENORMAL_ARM_FZ;
+	static inline uint32_t read()
+	{
+		uint64_t r;
+		__asm__ volatile("mrs %0, fpcr" : "=r"(r));
+		return (uint32_t)r;
+	}
+	static inline void write(uint32_t r)
+	{
+		__asm__ volatile("msr fpcr, %0" : : "r"((uint64_t)r) : "memory");
+	}
+#elif defined(__SSE__)
+	static const uint32_t mask = BASIC_DENORMAL_SSE_FTZ_DAZ;
+	static inline uint32_t read() { return _mm_getcsr(); }
+	static inline void write(uint32_t r) { _mm_setcsr(r); }
+#else
+	static const uint32_t mask = 0;
+	static inline uint32_t read() { return 0; }
+	static inline void write(uint32_t r) { (void)r; }
+#endif
+};
+
+#endif // _BASIC_DENORMAL_H_
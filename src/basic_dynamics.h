@@ -0,0 +1,107 @@
+/**
+ * @file basic_dynamics.h
+ * @author Piotr Zapart
+ * @brief Level detector, gain computer and attack/release smoother shared by the compressors
+ * 			One pole RMS detector on the side chain power, hard knee gain computer
+ * 			in the log domain (attenuation only) and a one pole smoother on the gain
+ * 			in dB with separate attack and release coefficients.
+ * 			AudioBasicDynamics is created on the stack at the top of the processing
+ * 			loop: the coefficients and the detector state are copied into it, stay
+ * 			in registers during the loop and the state is written back with store().
+ * 			The steps are available separately for the detectors using a different
+ * 			level (ie. the lookahead peak) or limiting the target gain.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_DYNAMICS_H_
+#define _BASIC_DYNAMICS_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+#include "basic_fastMath.h"
+#include "basic_denormal.h"
+
+#define DYNAMICS_LEVEL_POW_MIN		(1.0E-13f)		// detector floor, -130dBFS
+
+/**
+ * @brief detector state, one per compressor channel/band
+ */
+typedef struct
+{
+	float32_t level_lp_pow;		// RMS detector, mean power
+	float32_t gain_dB;			// smoothed gain
+}dynamics_detector_t;
+
+class AudioBasicDynamics
+{
+public:
+	/**
+	 * @param det 		detector state, copied in, write it back with store()
+	 * @param lvl_k 	RMS detector coefficient
+	 * @param thr_dB 	threshold in dBFS
+	 * @param ratio_k 	1/ratio
+	 * @param att_k 	attack coefficient
+	 * @param rel_k 	release coefficient
+	 */
+	AudioBasicDynamics(const dynamics_detector_t *det, float32_t lvl_k, float32_t thr_dB, float32_t ratio_k,
+					   float32_t att_k, float32_t rel_k)
+		: c1(lvl_k), c2(1.0f - lvl_k), thr(-thr_dB), ratio_k(ratio_k),
+		  att(att_k), one_minus_att(1.0f - att_k), rel(rel_k), one_minus_rel(1.0f - rel_k),
+		  lvl_pow(det->level_lp_pow), gain_dB(det->gain_dB) {}
+	/**
+	 * @brief first-order low-pass filter on the power, returns the level in dB
+	 */
+	inline float32_t rms_dB(float32_t sc)
+	{
+		lvl_pow = c1 * lvl_pow + c2 * (sc * sc);
+		return fast_pow2dB(lvl_pow);
+	}
+	/**
+	 * @brief how much is the level above the threshold, scaled by the ratio,
+	 * 		limited to attenuation only
+	 */
+	inline float32_t target_dB(float32_t level_dB)
+	{
+		float32_t above_dB = level_dB + thr;
+		float32_t targ_dB = above_dB * ratio_k - above_dB;
+		return targ_dB > 0.0f ? 0.0f : targ_dB;
+	}
+	/**
+	 * @brief smooth the gain using the attack or release constants, returns the gain in dB
+	 */
+	inline float32_t smooth_dB(float32_t targ_dB)
+	{
+		if (targ_dB < gain_dB) 	gain_dB = att * gain_dB + one_minus_att * targ_dB;
+		else 					gain_dB = denormal_bias(rel * gain_dB + one_minus_rel * targ_dB);
+		return gain_dB;
+	}
+	/**
+	 * @brief one sample of the RMS compressor, returns the linear gain
+	 */
+	inline float32_t gain(float32_t sc)
+	{
+		return fast_dB2lin(smooth_dB(target_dB(rms_dB(sc))));
+	}
+	/**
+	 * @brief write the state back, the detector does not go below -130dBFS
+	 */
+	void store(dynamics_detector_t *det)
+	{
+		if (lvl_pow < DYNAMICS_LEVEL_POW_MIN) lvl_pow = DYNAMICS_LEVEL_POW_MIN;
+		det->level_lp_pow = lvl_pow;
+		det->gain_dB = gain_dB;
+	}
+private:
+	const float32_t c1, c2;
+	const float32_t thr;
+	const float32_t ratio_k;
+	const float32_t att, one_minus_att;
+	const float32_t rel, one_minus_rel;
+	float32_t lvl_pow;
+	float32_t gain_dB;
+};
+
+#endif // _BASIC_DYNAMICS_H_
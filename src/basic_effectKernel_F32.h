@@ -0,0 +1,39 @@
+/**
+ * @file basic_effectKernel_F32.h
+ * @author Piotr Zapart
+ * @brief In place processing interface of the stereo effects
+ * 			Effects implementing it can run inside the AudioEffectChain_F32,
+ * 			which calls process() directly on its own pair of buffers instead
+ * 			of passing the audio blocks through the patch cords.
+ * 			process() does the same as the update() of the effect, including
+ * 			the bypass handling, only the block transport is left out.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_EFFECTKERNEL_F32_H_
+#define _BASIC_EFFECTKERNEL_F32_H_
+
+#include "arm_math.h"
+
+class AudioEffectKernel_F32
+{
+public:
+	/**
+	 * @brief process one block of stereo audio in place
+	 *
+	 * @param dataL channel L, input and output
+	 * @param dataR channel R, input and output
+	 * @param len 	number of samples
+	 */
+	virtual void process(float32_t *dataL, float32_t *dataR, uint32_t len) = 0;
+	/**
+	 * @brief bypass control, used by the chain for the per stage bypass
+	 */
+	virtual void bypass_set(bool state) = 0;
+	virtual bool bypass_get(void) = 0;
+};
+
+#endif // _BASIC_EFFECTKERNEL_F32_H_
@@ -0,0 +1,118 @@
+/**
+ * @file basic_fastMath.h
+ * @author Piotr Zapart
+ * @brief Fast log2/exp2 and dB conversions for the dynamics processors
+ *
+ * Branch free polynomial approximations, no libm calls. The float is split
+ * into the exponent and the mantissa with integer operations, the polynomial
+ * covers one octave. Coefficients are minimax fits (Remez).
+ *
+ * Error bounds, measured against double precision libm, float rounding included:
+ * 	fast_log2f	abs. error < 1.4e-5 for 2^-32 < |x| < 2^24	(5th order)
+ * 				< 1.7e-5 below 2^-32, rounding of the exponent + polynomial sum
+ * 	fast_exp2f	rel. error < 2.8e-6						(4th order)
+ * 	fast_lin2dB	abs. error < 1e-4 dB in the -140...+20dB range
+ * 	fast_pow2dB	abs. error < 1e-4 dB in the -140...+20dB range
+ * 	fast_dB2lin	rel. error < 4e-6 (3.5e-5 dB)
+ * Roughly 10 cycles per call on the Cortex-M7, the block versions have no
+ * dependency between the samples, which keeps the dual issue FPU busy.
+ *
+ * Input ranges:
+ * 	log functions use |x|, 0 and subnormals return about -127 (-764dB)
+ * 	exp functions clamp the argument to -126...127, the result is never 0
+ *
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_FASTMATH_H_
+#define _BASIC_FASTMATH_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+
+#define FAST_MATH_LOG2_TO_DB20	(6.020599913f)		// 20*log10(2)
+#define FAST_MATH_LOG2_TO_DB10	(3.010299957f)		// 10*log10(2)
+#define FAST_MATH_DB20_TO_LOG2	(0.1660964047f)		// log2(10)/20
+
+typedef union
+{
+	float32_t f;
+	uint32_t u;
+}fast_math_f32_t;
+
+/**
+ * @brief log2(|x|)
+ */
+static inline float32_t fast_log2f(float32_t x)
+{
+	fast_math_f32_t v;
+	v.f = x;
+	float32_t e = (float32_t)((int32_t)((v.u >> 23) & 0xFF) - 127);
+	v.u = (v.u & 0x007FFFFF) | 0x3F800000;	// mantissa 1.0 ... 2.0
+	float32_t m = v.f - 1.0f;
+	float32_t y = 0.044873604f;
+	y = y * m - 0.19219562f;
+	y = y * m + 0.413630106f;
+	y = y * m - 0.707992647f;
+	y = y * m + 1.44168456f;
+	y = y * m + 1.25387318e-05f;
+	return e + y;
+}
+
+/**
+ * @brief 2^x
+ */
+static inline float32_t fast_exp2f(float32_t x)
+{
+	fast_math_f32_t v;
+	x = x < -126.0f ? -126.0f : x;
+	x = x > 127.0f ? 127.0f : x;
+	float32_t xi = floorf(x);
+	float32_t f = x - xi;
+	float32_t y = 0.0135341681f;
+	y = y * f + 0.0520114603f;
+	y = y * f + 0.241442757f;
+	y = y * f + 0.693003834f;
+	y = y * f + 1.00000259f;
+	v.f = y;
+	v.u += (uint32_t)((int32_t)xi) << 23;	// add the integer part to the exponent
+	return v.f;
+}
+
+/**
+ * @brief amplitude to dB, 20*log10(|x|)
+ */
+static inline float32_t fast_lin2dB(float32_t x) { return fast_log2f(x) * FAST_MATH_LOG2_TO_DB20; }
+/**
+ * @brief power to dB, 10*log10(x)
+ */
+static inline float32_t fast_pow2dB(float32_t x) { return fast_log2f(x) * FAST_MATH_LOG2_TO_DB10; }
+/**
+ * @brief dB to amplitude, 10^(dB/20)
+ */
+static inline float32_t fast_dB2lin(float32_t dB) { return fast_exp2f(dB * FAST_MATH_DB20_TO_LOG2); }
+
+/**
+ * @brief block versions, src and dst can be the same buffer
+ */
+static inline void fast_log2_block(const float32_t *src, float32_t *dst, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) dst[i] = fast_log2f(src[i]);
+}
+static inline void fast_exp2_block(const float32_t *src, float32_t *dst, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) dst[i] = fast_exp2f(src[i]);
+}
+static inline void fast_lin2dB_block(const float32_t *src, float32_t *dst, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) dst[i] = fast_lin2dB(src[i]);
+}
+static inline void fast_dB2lin_block(const float32_t *src, float32_t *dst, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) dst[i] = fast_dB2lin(src[i]);
+}
+
+#endif // _BASIC_FASTMATH_H_
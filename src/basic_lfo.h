@@ -22,9 +22,11 @@ extern const int16_t AudioWaveformSine[257];
 class AudioBasicLfo
 {
 public:
-	AudioBasicLfo(float rateHz, uint32_t ampl)
+	AudioBasicLfo(float rateHz, uint32_t ampl, float fs=AUDIO_SAMPLE_RATE_EXACT)
 	{
 		acc = 0;
+		rate_Hz = rateHz;
+		rate_mult = 4294967295.0f / fs;
 		if (!ampl) 
 		{
 			state = false;
@@ -39,6 +41,13 @@ public:
 	{
 		acc += adder; // update the phase acc
 	}
+	/**
+	 * @brief advance the phase by n samples, used for control rate (per block) modulation
+	 */
+	inline void update(uint32_t n)
+	{
+		acc += adder * n;
+	}
 	/**
 	 * @brief LFO output split in two parts
 	 * 
@@ -70,8 +79,17 @@ public:
 	}
 	inline void setRate(float rateHz)
 	{
+		rate_Hz = rateHz;
 		adder = (uint32_t)(rateHz * rate_mult);
 	}
+	/**
+	 * @brief Set the sample rate, LFO frequency in Hz is preserved
+	 */
+	void setSampleRate(float fs)
+	{
+		rate_mult = 4294967295.0f / fs;
+		setRate(rate_Hz);
+	}
 	inline void setDepth(uint32_t ampl)
 	{
 		if (!ampl) 
@@ -87,7 +105,8 @@ private:
 	uint32_t acc;
 	uint32_t adder;
 	int32_t divider = 1;
-	const uint32_t rate_mult = 4294967295.0f / AUDIO_SAMPLE_RATE_EXACT;
+	float rate_Hz;
+	float rate_mult;
 };
 
 #endif // _BASIC_LFO_H_
@@ -0,0 +1,144 @@
+#include "basic_memArena.h"
+
+AudioBasicMemArena::pool_t AudioBasicMemArena::pools[ARENA_POOLS];
+AudioBasicMemArena::owner_t AudioBasicMemArena::owners[ARENA_MAX_OWNERS];
+uint8_t AudioBasicMemArena::ownerCount = 0;
+int8_t AudioBasicMemArena::owner = -1;
+
+static const char *const arena_pool_names[ARENA_POOLS + 1] = {"RAM1", "RAM2", "PSRAM", "heap"};
+
+bool AudioBasicMemArena::pool_init(arena_pool_t pool, uint32_t bytes, void *mem)
+{
+	if (pool >= ARENA_POOLS || pools[pool].base) return false;	// already configured
+	if (!mem)
+	{
+		if (pool == ARENA_RAM1) return false;
+		mem = pool == ARENA_PSRAM ? extmem_malloc(bytes) : ::malloc(bytes);
+		if (!mem) return false;
+	}
+	// align the base, the size shrinks accordingly
+	uint32_t a = (ARENA_ALIGN - ((uintptr_t)mem & (ARENA_ALIGN - 1))) & (ARENA_ALIGN - 1);
+	if (bytes <= a) return false;
+	pools[pool].base = (uint8_t *)mem + a;
+	pools[pool].size = (bytes - a) & ~(ARENA_ALIGN - 1);
+	pools[pool].top = 0;
+	pools[pool].peak = 0;
+	return true;
+}
+
+void *AudioBasicMemArena::pool_alloc(arena_pool_t pool, uint32_t bytes)
+{
+	pool_t *p = &pools[pool];
+	if (!p->base || bytes > p->size - p->top) return NULL;
+	void *ptr = p->base + p->top;
+	p->top += bytes;
+	if (p->top > p->peak) p->peak = p->top;
+	account(pool, bytes);
+	return ptr;
+}
+
+void *AudioBasicMemArena::alloc(uint32_t bytes, arena_pool_t pool)
+{
+	void *ptr;
+	if (!bytes || pool >= ARENA_POOLS) return NULL;
+	bytes = (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	ptr = pool_alloc(pool, bytes);
+	if (!ptr && pool == ARENA_RAM1) ptr = pool_alloc(ARENA_RAM2, bytes);
+	if (ptr) return ptr;
+	// heap fallback, aligned, the original pointer is stored in front of the buffer
+	uint8_t *raw = (uint8_t *)(pool == ARENA_PSRAM ? extmem_malloc(bytes + ARENA_ALIGN) : ::malloc(bytes + ARENA_ALIGN));
+	if (!raw) return NULL;
+	ptr = (void *)(((uintptr_t)raw + ARENA_ALIGN) & ~(uintptr_t)(ARENA_ALIGN - 1));
+	((void **)ptr)[-1] = raw;
+	account(ARENA_POOLS, bytes);
+	return ptr;
+}
+
+void AudioBasicMemArena::free(void *ptr)
+{
+	if (!ptr) return;
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+	{
+		if (pools[i].base && (uint8_t *)ptr >= pools[i].base && (uint8_t *)ptr < pools[i].base + pools[i].size)
+			return;		// returned with release()
+	}
+	extmem_free(((void **)ptr)[-1]);	// handles both PSRAM and heap pointers
+}
+
+arena_mark_t AudioBasicMemArena::mark()
+{
+	arena_mark_t m;
+	for (uint8_t i = 0; i < ARENA_POOLS; i++) m.top[i] = pools[i].top;
+	m.owners = ownerCount;
+	return m;
+}
+
+void AudioBasicMemArena::release(const arena_mark_t &m)
+{
+	for (uint8_t i = 0; i < ARENA_POOLS; i++)
+	{
+		if (m.top[i] < pools[i].top) pools[i].top = m.top[i];
+	}
+	if (m.owners < ownerCount) ownerCount = m.owners;
+	owner = -1;
+}
+
+void AudioBasicMemArena::reset()
+{
+	for (uint8_t i = 0; i < ARENA_POOLS; i++) pools[i].top = 0;
+	ownerCount = 0;
+	owner = -1;
+}
+
+void AudioBasicMemArena::owner_begin(const void *obj, const char *name)
+{
+	uint8_t i;
+	for (i = 0; i < ownerCount; i++)
+	{
+		if (owners[i].obj == obj) break;
+	}
+	if (i == ownerCount)
+	{
+		if (ownerCount >= ARENA_MAX_OWNERS)
+		{
+			owner = -1;		// table full, not accounted
+			return;
+		}
+		ownerCount++;
+	}
+	owners[i].obj = obj;
+	owners[i].name = name;
+	memset(owners[i].bytes, 0, sizeof(owners[i].bytes));
+	owner = i;
+}
+
+uint32_t AudioBasicMemArena::owner_bytes(const void *obj, arena_pool_t pool)
+{
+	if (pool > ARENA_POOLS) return 0;
+	for (uint8_t i = 0; i < ownerCount; i++)
+	{
+		if (owners[i].obj == obj) return owners[i].bytes[pool];
+	}
+	return 0;
+}
+
+void AudioBasicMemArena::report(Print &p)
+{
+	uint8_t i, j;
+	p.printf("Memory arena\r\n");
+	for (i = 0; i < ARENA_POOLS; i++)
+	{
+		if (!pools[i].base) p.printf("%-6s not used\r\n", arena_pool_names[i]);
+		else p.printf("%-6s used %lu / %lu, peak %lu\r\n", arena_pool_names[i],
+					(unsigned long)pools[i].top, (unsigned long)pools[i].size, (unsigned long)pools[i].peak);
+	}
+	p.printf("%-20s", "effect");
+	for (j = 0; j <= ARENA_POOLS; j++) p.printf("%10s", arena_pool_names[j]);
+	p.printf("\r\n");
+	for (i = 0; i < ownerCount; i++)
+	{
+		p.printf("%-20s", owners[i].name);
+		for (j = 0; j <= ARENA_POOLS; j++) p.printf("%10lu", (unsigned long)owners[i].bytes[j]);
+		p.printf("\r\n");
+	}
+}
@@ -0,0 +1,175 @@
+/**
+ * @file basic_memArena.h
+ * @author Piotr Zapart
+ * @brief Region based memory arena for the effect buffers
+ * 			Delay lines, allpass and pitch shifter buffers, reverb and cabsim
+ * 			storage are allocated from up to three linear pools: internal RAM1 (DTCM),
+ * 			RAM2 (DMAMEM/OCRAM) and PSRAM. Allocation is a pointer bump, memory is
+ * 			returned in one go by rolling the pool back to a mark, so there is no
+ * 			fragmentation when an effect chain is torn down and built again:
+ * 				AudioBasicMemArena::pool_init(ARENA_RAM2, 256*1024);
+ * 				arena_mark_t m = AudioBasicMemArena::mark();
+ * 				... fx.mem_realloc() for each effect ...
+ * 				AudioNoInterrupts();
+ * 				AudioBasicMemArena::release(m);
+ * 				... fx.mem_realloc() for the new set ...
+ * 				AudioInterrupts();
+ * 			Pools not configured (default) or exhausted fall back to malloc/extmem_malloc,
+ * 			which is also used for the effects constructed as global objects before setup().
+ * 			Each allocation is accounted to the current owner (effect), report() prints
+ * 			the per effect memory use.
+ * 			All buffers, including the heap fallback, are ARENA_ALIGN aligned.
+ * 			Effects created with new can be placed in a chosen memory:
+ * 				AudioEffectPhaserStereo_F32 *phaser = new(ARENA_RAM1) AudioEffectPhaserStereo_F32;
+ * 			and have to be destroyed with AudioBasicMemArena::destroy(phaser), not delete.
+ * 			Global objects are placed in RAM1 by the linker.
+ * 			Not thread safe, allocate from the main code only.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_MEMARENA_H_
+#define _BASIC_MEMARENA_H_
+
+#include <Arduino.h>
+
+#define ARENA_ALIGN				(32)	// cache line, required for the PSRAM dcache flush
+#define ARENA_MAX_OWNERS		(24)	// effects tracked in the memory report
+// hot per sample state of the effects is grouped in cache line aligned structures
+#define ARENA_ALIGNED			alignas(ARENA_ALIGN)
+
+typedef enum
+{
+	ARENA_RAM1,		// DTCM, fastest, small buffers used every sample
+	ARENA_RAM2,		// OCRAM/DMAMEM, same as malloc on Teensy4
+	ARENA_PSRAM,	// external PSRAM, long delay lines
+	ARENA_POOLS
+}arena_pool_t;
+
+typedef struct
+{
+	uint32_t top[ARENA_POOLS];
+	uint8_t owners;
+}arena_mark_t;
+
+class AudioBasicMemArena
+{
+public:
+	/**
+	 * @brief assign memory to a pool
+	 *
+	 * @param pool 	pool type
+	 * @param bytes pool size in bytes
+	 * @param mem 	pool memory, ie. a static DMAMEM/EXTMEM array. With NULL the pool
+	 * 				is allocated once from the heap (RAM2) or PSRAM (extmem_malloc).
+	 * 				RAM1 pool requires a static array.
+	 * @return true on success
+	 */
+	static bool pool_init(arena_pool_t pool, uint32_t bytes, void *mem=NULL);
+	/**
+	 * @brief allocate a buffer
+	 * 			RAM1 requests use the RAM2 pool if RAM1 is not available,
+	 * 			the heap is used if the pool is not configured or full.
+	 *
+	 * @param bytes buffer size
+	 * @param pool 	preferred memory
+	 * @return void* buffer, NULL if out of memory
+	 */
+	static void *alloc(uint32_t bytes, arena_pool_t pool=ARENA_RAM2);
+	/**
+	 * @brief free a buffer, arena memory is returned with release() only,
+	 * 			heap buffers are freed. NULL is ignored.
+	 */
+	static void free(void *ptr);
+	/**
+	 * @brief destroy an object created with new(ARENA_x), calls the destructor
+	 * 			and frees the memory the same way as free(). NULL is ignored.
+	 */
+	template <class T>
+	static void destroy(T *obj)
+	{
+		if (!obj) return;
+		obj->~T();
+		free(obj);
+	}
+	/**
+	 * @brief current state of the pools, everything allocated after the mark
+	 * 			is returned by release()
+	 */
+	static arena_mark_t mark();
+	static void release(const arena_mark_t &m);
+	/**
+	 * @brief return all the arena memory
+	 */
+	static void reset();
+	static uint32_t pool_used(arena_pool_t pool) { return pool < ARENA_POOLS ? pools[pool].top : 0; }
+	static uint32_t pool_size(arena_pool_t pool) { return pool < ARENA_POOLS ? pools[pool].size : 0; }
+	static uint32_t pool_peak(arena_pool_t pool) { return pool < ARENA_POOLS ? pools[pool].peak : 0; }
+	/**
+	 * @brief set the owner the following allocations are accounted to
+	 * 			Starting the same owner again clears its previous counters.
+	 *
+	 * @param obj 	effect instance
+	 * @param name 	effect name used in the report
+	 */
+	static void owner_begin(const void *obj, const char *name);
+	static void owner_end() { owner = -1; }
+	/**
+	 * @brief memory allocated by an effect
+	 *
+	 * @param obj 	effect instance
+	 * @param pool 	arena pool, ARENA_POOLS returns the heap fallback
+	 * @return uint32_t bytes
+	 */
+	static uint32_t owner_bytes(const void *obj, arena_pool_t pool);
+	/**
+	 * @brief print the pool use and the per effect memory budget
+	 */
+	static void report(Print &p);
+private:
+	typedef struct
+	{
+		uint8_t *base;
+		uint32_t size;
+		uint32_t top;
+		uint32_t peak;
+	}pool_t;
+	typedef struct
+	{
+		const void *obj;
+		const char *name;
+		uint32_t bytes[ARENA_POOLS + 1];	// last one: heap fallback
+	}owner_t;
+	static pool_t pools[ARENA_POOLS];
+	static owner_t owners[ARENA_MAX_OWNERS];
+	static uint8_t ownerCount;
+	static int8_t owner;
+	static void *pool_alloc(arena_pool_t pool, uint32_t bytes);
+	static void account(uint8_t slot, uint32_t bytes)
+	{
+		if (owner >= 0) owners[owner].bytes[slot] += bytes;
+	}
+};
+
+/**
+ * @brief Scoped owner, allocations inside the scope are accounted to the effect
+ * 			Place it at the top of the effect's init/begin function.
+ */
+class AudioBasicMemArenaOwner
+{
+public:
+	AudioBasicMemArenaOwner(const void *obj, const char *name) { AudioBasicMemArena::owner_begin(obj, name); }
+	~AudioBasicMemArenaOwner() { AudioBasicMemArena::owner_end(); }
+};
+
+/**
+ * @brief placement hook, allocates the object itself from the arena
+ * 			The matching delete is only called if the constructor throws,
+ * 			use AudioBasicMemArena::destroy() to delete the object.
+ */
+inline void *operator new(size_t bytes, arena_pool_t pool) { return AudioBasicMemArena::alloc(bytes, pool); }
+inline void operator delete(void *ptr, arena_pool_t) { AudioBasicMemArena::free(ptr); }
+
+#endif // _BASIC_MEMARENA_H_
@@ -0,0 +1,136 @@
+/**
+ * @file basic_memCleaner.h
+ * @author Piotr Zapart
+ * @brief Incremental buffer cleaner
+ * 			Clearing all the delay buffers of a reverb or delay in one
+ * 			audio update, esp. if the PSRAM is used, takes too long for the audio ISR.
+ * 			Components register their buffers and the memset (+ dcache flush for PSRAM)
+ * 			work is spread over a number of update() calls, limited by a per call byte budget.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_MEMCLEANER_H_
+#define _BASIC_MEMCLEANER_H_
+
+#include <Arduino.h>
+#include "basic_delay.h"
+
+#define BASIC_MEMCLEANER_MAX_REGIONS	(24)
+#define BASIC_MEMCLEANER_BUDGET_DEFAULT	(16384)		// bytes cleared per process() call
+
+class AudioBasicMemCleaner
+{
+public:
+	AudioBasicMemCleaner(uint32_t bytesPerCall = BASIC_MEMCLEANER_BUDGET_DEFAULT)
+	{
+		budget = bytesPerCall;
+		regionCount = 0;
+		active = false;
+	}
+	/**
+	 * @brief register a memory region
+	 *
+	 * @param ptr pointer to the buffer
+	 * @param bytes buffer size in bytes
+	 * @param psram true if the buffer is placed in PSRAM (requires dcache flush)
+	 * @return true on success, false if the region table is full
+	 */
+	bool addRegion(void *ptr, uint32_t bytes, bool psram=false)
+	{
+		if (!ptr || !bytes) return true; // nothing to clean
+		if (regionCount >= BASIC_MEMCLEANER_MAX_REGIONS) return false;
+		regions[regionCount].ptr = (uint8_t *)ptr;
+		regions[regionCount].size = bytes;
+		regions[regionCount].psram = psram;
+		regionCount++;
+		return true;
+	}
+	/**
+	 * @brief register the buffer of a basic component (delay, allpass, pitch shifter)
+	 */
+	template <class T>
+	bool add(T &component, bool psram=false)
+	{
+		return addRegion(component.getBuffer(), component.getSize() * sizeof(*component.getBuffer()), psram);
+	}
+	/**
+	 * @brief register the delay line buffer including the guard samples
+	 * 			buffers placed in an AudioBasicDelayStore are not registered, use reset()
+	 */
+	bool add(AudioBasicDelay &dly, bool psram=false)
+	{
+		return addRegion(dly.getBuffer(), dly.getSizeBytes(), psram);
+	}
+	/**
+	 * @brief remove all registered regions, use before reallocating the buffers
+	 */
+	void clear()
+	{
+		__disable_irq();
+		regionCount = 0;
+		active = false;
+		__enable_irq();
+	}
+	/**
+	 * @brief start (or restart) the cleaning process from the first region
+	 */
+	void start()
+	{
+		__disable_irq();
+		regionIdx = 0;
+		offset = 0;
+		active = regionCount > 0;
+		__enable_irq();
+	}
+	/**
+	 * @brief clear the next portion of the registered memory
+	 * 			to be called from the update() function
+	 *
+	 * @return true 	cleaning complete (or not active)
+	 * @return false 	cleaning still in progress
+	 */
+	bool process()
+	{
+		if (!active) return true;
+		uint32_t bytesLeft = budget;
+		while (bytesLeft && regionIdx < regionCount)
+		{
+			region_t *r = &regions[regionIdx];
+			uint32_t l = r->size - offset;
+			if (l > bytesLeft) l = bytesLeft;
+			uint8_t *memPtr = r->ptr + offset;
+			memset(memPtr, 0, l);
+			if (r->psram) arm_dcache_flush_delete(memPtr, l);
+			offset += l;
+			bytesLeft -= l;
+			if (offset >= r->size)
+			{
+				offset = 0;
+				regionIdx++;
+			}
+		}
+		if (regionIdx >= regionCount) active = false;
+		return !active;
+	}
+	bool busy() { return active; }
+	void setBudget(uint32_t bytesPerCall) { budget = bytesPerCall ? bytesPerCall : 1; }
+	uint32_t getBudget() { return budget; }
+private:
+	typedef struct
+	{
+		uint8_t *ptr;
+		uint32_t size;
+		bool psram;
+	}region_t;
+	region_t regions[BASIC_MEMCLEANER_MAX_REGIONS];
+	uint8_t regionCount;
+	uint8_t regionIdx;
+	uint32_t offset;
+	uint32_t budget;
+	volatile bool active;
+};
+
+#endif // _BASIC_MEMCLEANER_H_
@@ -2,7 +2,11 @@
 #define _BASIC_PITCH_H_
 
 #include <Arduino.h>
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "basic_memArena.h"
 #include "basic_shelvFilter.h"
+#include "basic_DSPutils.h"
 
 #define BASIC_PITCH_BUF_BITS 		(12)
 #define BASIC_PITCH_BUF_SIZE 		(1<<BASIC_PITCH_BUF_BITS)
@@ -24,12 +28,17 @@ class AudioBasicPitch
 {
 public:
 	AudioBasicPitch() { bf = NULL; }
-	~AudioBasicPitch() { free(bf); }
-	bool init()
+	~AudioBasicPitch() { AudioBasicMemArena::free(bf); }
+	/**
+	 * @brief allocate the buffer and init the output filter
+	 * 
+	 * @param fs sample rate used to calculate the output filter coefficients
+	 */
+	bool init(float fs=AUDIO_SAMPLE_RATE_EXACT)
 	{
-		free(bf);
-		outFilter.init(hp_f, (float *)&hp_gain, lp_f, &lp_gain);
-		bf = (float *)malloc(BASIC_PITCH_BUF_SIZE*sizeof(float)); // allocate buffer
+		AudioBasicMemArena::free(bf);
+		outFilter.init(onepole_coeff_fs(hp_f, fs), (float *)&hp_gain, onepole_coeff_fs(lp_f, fs), &lp_gain);
+		bf = (float *)AudioBasicMemArena::alloc(BASIC_PITCH_BUF_SIZE*sizeof(float), ARENA_RAM1); // allocate buffer
 		if (!bf) return false;
 		reset();
 		return true;
@@ -92,10 +101,85 @@ public:
 		s_n = outFilter.process(s_n);						// apply output lowpass
 		return (s_n * mix + newSample * (1.0f-mix));			// do dry/wet mix
 	}
+	/**
+	 * @brief Block version of the process() function
+	 * 		Buffer write, read pointer ramp, the interpolated reads and the crossfade
+	 * 		are done in the first pass into the member scratch buffer (nothing on the
+	 * 		stack), output filter and dry/wet mix operate on the whole block.
+	 * 
+	 * @param src input samples
+	 * @param dst output buffer, can be the same as src
+	 * @param len number of samples, max AUDIO_BLOCK_SAMPLES
+	 * @param wetOnly if true, only the pitch shifted signal is written to dst, 
+	 * 			the dry/wet mix is left to the caller
+	 * @return true 	pitch shifter active, dst contains the processed signal
+	 * @return false 	pitch shifter inactive (mix=0 or no pitch change), dst contains
+	 * 					the input signal or is not modified if wetOnly is set
+	 */
+	bool processBlock(const float *src, float *dst, uint16_t len, bool wetOnly=false)
+	{
+		uint32_t rdAddr = readAddr;
+		uint32_t rdAdder = readAdder;
+		uint16_t wrAddr = writeAddr;
+		uint32_t idx, i, delta, delta_acc;
+		float k_frac, x0, xf0, s_n, s_half, xfade;
+
+		if (len > AUDIO_BLOCK_SAMPLES) len = AUDIO_BLOCK_SAMPLES;
+		if (mix == 0.0f || rdAdder == pitchDelta0)
+		{
+			for (i = 0; i < len; i++)
+			{
+				bf[wrAddr] = src[i];
+				wrAddr = (wrAddr + 1) & BASIC_PITCH_BUF_MASK;
+			}
+			readAddr = rdAddr + rdAdder * len;
+			writeAddr = wrAddr;
+			if (!wetOnly && dst != src) memcpy(dst, src, len*sizeof(float));
+			return false;
+		}
+		for (i = 0; i < len; i++)
+		{
+			bf[wrAddr] = src[i];
+			rdAddr += rdAdder;
+			// sample end
+			idx = (rdAddr >> (32-BASIC_PITCH_BUF_BITS)) & BASIC_PITCH_BUF_MASK;
+			k_frac = (float)(rdAddr & BASIC_PITCH_BUF_FRAC_MASK) * fracScale;
+			x0 = bf[idx];
+			s_n = x0 + (bf[(idx + 1) & BASIC_PITCH_BUF_MASK] - x0) * k_frac;
+			// sample half
+			idx = ((rdAddr + 0x80000000) >> (32-BASIC_PITCH_BUF_BITS)) & BASIC_PITCH_BUF_MASK;
+			k_frac = (float)((rdAddr + 0x80000000) & BASIC_PITCH_BUF_FRAC_MASK) * fracScale;
+			x0 = bf[idx];
+			s_half = x0 + (bf[(idx + 1) & BASIC_PITCH_BUF_MASK] - x0) * k_frac;
+			// crossfade coeff.
+			delta_acc = rdAddr - (wrAddr<<(32-BASIC_PITCH_BUF_BITS));
+			delta = (delta_acc >> (32-9)) & 0x1FF;
+			k_frac = (float)(delta_acc & ((1<<23)-1)) * xfadeFracScale;
+			idx = delta & 0xFF;
+			xf0 = AudioWaveformFader_f32[idx];
+			xf0 = xf0 + (AudioWaveformFader_f32[idx+1] - xf0) * k_frac;
+			xfade = delta > 0xFF ? 1.0f - xf0 : xf0;
+			wet[i] = s_half + (s_n - s_half) * xfade;
+			wrAddr = (wrAddr + 1) & BASIC_PITCH_BUF_MASK;
+		}
+		readAddr = rdAddr;
+		writeAddr = wrAddr;
+		float *out = wetOnly ? dst : wet;
+		for (i = 0; i < len; i++) out[i] = outFilter.process(wet[i]);
+		if (!wetOnly)
+		{
+			// src + (wet - src) * mix
+			arm_sub_f32(wet, src, wet, len);
+			arm_scale_f32(wet, mix, wet, len);
+			arm_add_f32(wet, src, dst, len);
+		}
+		return true;
+	}
 	void setMix(float mixRatio)
 	{
 		mix = constrain(mixRatio, 0.0f, 1.0f);
 	}
+	float getMix() { return mix; }
 	void reset()
 	{
 		memset(bf, 0, BASIC_PITCH_BUF_SIZE*sizeof(float));
@@ -105,6 +189,8 @@ public:
 		readAdder = pitchDelta0;
 		mix = 1.0f;
 	}
+	float* getBuffer() { return bf; }
+	uint32_t getSize() { return BASIC_PITCH_BUF_SIZE; }
 private:
 	float *bf;
 	float mix;
@@ -112,8 +198,11 @@ private:
 	uint32_t readAdder;
 	uint16_t writeAddr;
 	static const uint32_t pitchDelta0 = BASIC_PITCH_BUF_FRAC_MASK+1;
+	static constexpr float fracScale = 1.0f / (float)BASIC_PITCH_BUF_FRAC_MASK;
+	static constexpr float xfadeFracScale = 1.0f / (float)((1<<23)-1);
 
 	AudioFilterShelvingLPHP outFilter;
+	ARENA_ALIGNED float wet[AUDIO_BLOCK_SAMPLES];	// processBlock() scratch
 	static constexpr float hp_f = 0.003f;
 	const float hp_gain = 0.0f;
 	static constexpr float lp_f = 0.26f;
@@ -12,6 +12,7 @@
 #define _BASIC_SHELVFILTER_H_
 
 #include <Arduino.h>
+#include "basic_denormal.h"
 
 class AudioFilterShelvingLPHP
 {
@@ -54,10 +55,10 @@ public:
 		}
 
 		tmp1 = input - lpreg;
-        lpreg += tmp1 * lp_f;
+        lpreg = denormal_bias(lpreg + tmp1 * lp_f);
         tmp2 = input - lpreg;
         tmp1 = lpreg - hpreg;
-        hpreg += tmp1 * hp_f;
+        hpreg = denormal_bias(hpreg + tmp1 * hp_f);
 		return (lpreg + hidamp*tmp2 + lodamp * hpreg);
 	}
 	void reset()
@@ -92,7 +93,7 @@ public:
 	{
 		float tmp;
         tmp = input - lpreg;
-        lpreg += (*lp_fPtr) *tmp;
+        lpreg = denormal_bias(lpreg + (*lp_fPtr) *tmp);
 		return lpreg;
 	}
 private:
@@ -0,0 +1,106 @@
+/**
+ * @file basic_tapTempo.h
+ * @author Piotr Zapart
+ * @brief Tap tempo counter shared by the delay effects
+ * 			The counter runs in the audio update, tap() is called from the
+ * 			main code (button press) and returns the time between the taps in samples.
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_TAPTEMPO_H_
+#define _BASIC_TAPTEMPO_H_
+
+#include <Arduino.h>
+#include "arm_math.h"
+#include "AudioStream_F32.h"
+
+class AudioBasicTapTempo
+{
+public:
+	/**
+	 * @brief set the time limits
+	 *
+	 * @param fs sample rate
+	 * @param timeout_s counting stops if there is no tap within this time
+	 * @param deltamax_s taps differing more than this from the last tempo start a new tempo
+	 */
+	void init(float32_t fs, float32_t timeout_s=3.0f, float32_t deltamax_s=0.3f)
+	{
+		counter_max = timeout_s * fs;
+		counter_deltamax = deltamax_s * fs;
+		reset();
+	}
+	/**
+	 * @brief advance the counter, to be called once per audio block
+	 *
+	 * @param n number of samples in the block
+	 */
+	inline void tick(uint32_t n)
+	{
+		if (!active) return;
+		counter += n;
+		if (counter > counter_max)
+		{
+			active = false;
+			counter = 0;
+		}
+	}
+	void reset()
+	{
+		active = false;
+		counter = 0;
+	}
+	/**
+	 * @brief register a tap
+	 *
+	 * @param ticks 	returns the new tempo in samples
+	 * @param limit 	max tempo, longer times are halved until they fit
+	 * @param avg 		average the new time with the last one if they are close
+	 * @return true 	new tempo available
+	 * @return false 	first tap, counting started
+	 */
+	bool tap(uint32_t *ticks, uint32_t limit, bool avg=true)
+	{
+		int32_t delta;
+		uint32_t tempo_ticks = 0;
+		if (!active)
+		{
+			counter = 0;
+			active = true;
+			*ticks = 0;
+			return false;
+		}
+		__disable_irq();
+		counter_new = counter;
+		counter = 0;
+		__enable_irq();
+		delta = counter_new - counter_last;
+		if (abs(delta) > counter_deltamax || !avg) // new tempo?
+		{
+			tempo_ticks = counter_new;
+		}
+		else
+		{
+			tempo_ticks = (counter_new>>1) + (counter_last>>1);
+		}
+		while (tempo_ticks > limit)
+		{
+			tempo_ticks >>= 1;
+		}
+		counter_last = tempo_ticks;
+		*ticks = tempo_ticks;
+		return true;
+	}
+	bool is_active() { return active; }
+private:
+	volatile bool active = false;
+	volatile uint32_t counter = 0;
+	uint32_t counter_last = 0, counter_new = 0;
+	uint32_t counter_max = 3.0f*AUDIO_SAMPLE_RATE_EXACT; // 3 sec
+	int32_t counter_deltamax = 0.3f*AUDIO_SAMPLE_RATE_EXACT;
+};
+
+#endif // _BASIC_TAPTEMPO_H_
@@ -0,0 +1,340 @@
+/**
+ * @file basic_waveshaper.cpp
+ * @author Piotr Zapart
+ * @brief Waveshaper curve tables, 64 cubic Hermite segments over the -1.0 ... 1.0 range
+ * 			BOOSTER: fit of the former 2001 point AudioEffectGuitarBooster_F32 table
+ * 			TUBE: 	x >= 0: tanh(2x)/tanh(2), x < 0: 0.7*tanh(Bx)/tanh(B), B = 2.9475,
+ * 					0.7*B/tanh(B) = 2/tanh(2), same slope on both sides of 0
+ * 			DIODE: 	g(3x)/g(3), g(u) = u/(1+|u|^2.5)^(1/2.5)
+ * 			FUZZ: 	x >= 0: (1-exp(-5x))/(1-exp(-5)), x < 0: -0.6*(1-exp(8x/0.6))/(1-exp(-8/0.6)), kink at 0
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#include "basic_waveshaper.h"
+
+PROGMEM const waveshaper_table_t waveshaper_tables[WAVESHAPER_CURVE_COUNT] =
+{
+	// WAVESHAPER_BOOSTER
+	{
+		{
+			{-0.34169694f, 0.00224546875f, 2.98046866e-05f, 2.8515618e-06f},
+			{-0.339418815f, 0.00231363281f, 3.62859352e-05f, 7.31249922e-07f},
+			{-0.337068165f, 0.00238839844f, 3.85921853e-05f, 8.34374766e-07f},
+			{-0.33464034f, 0.00246808594f, 4.11231224e-05f, 9.30937422e-07f},
+			{-0.3321302f, 0.002553125f, 4.40293725e-05f, 9.85624688e-07f},
+			{-0.32953206f, 0.00264414063f, 4.70709345e-05f, 1.15843742e-06f},
+			{-0.32683969f, 0.00274175782f, 5.04607784e-05f, 1.31390594e-06f},
+			{-0.324046157f, 0.0028466211f, 5.44009342e-05f, 1.39546852e-06f},
+			{-0.32114374f, 0.00295960938f, 5.87637464e-05f, 1.57937477e-06f},
+			{-0.318123788f, 0.003081875f, 6.33656213e-05f, 1.89687469e-06f},
+			{-0.31497665f, 0.00321429688f, 6.88209336e-05f, 2.12718703e-06f},
+			{-0.311691405f, 0.00335832032f, 7.49756205e-05f, 2.39906211e-06f},
+			{-0.30825571f, 0.00351546876f, 8.21832765e-05f, 2.6004682e-06f},
+			{-0.304655458f, 0.00368763672f, 9.01746822e-05f, 3.0410932e-06f},
+			{-0.300874605f, 0.00387710938f, 9.92984317e-05f, 3.57968687e-06f},
+			{-0.296894618f, 0.00408644532f, 0.000109947494f, 4.21468672e-06f},
+			{-0.29269401f, 0.00431898438f, 0.000122490462f, 4.88265523e-06f},
+			{-0.288247653f, 0.00457861329f, 0.000137124367f, 5.82984266e-06f},
+			{-0.283526085f, 0.00487035157f, 0.000154370773f, 7.09265484e-06f},
+			{-0.27849427f, 0.00520037111f, 0.000175061553f, 8.63734219e-06f},
+			{-0.2731102f, 0.00557640626f, 0.000200507177f, 1.04040605e-05f},
+			{-0.267322882f, 0.00600863283f, 0.000231315613f, 1.296406e-05f},
+			{-0.26106997f, 0.00651015627f, 0.00026958733f, 1.6401403e-05f},
+			{-0.254273825f, 0.00709853518f, 0.000317740921f, 2.11089024e-05f},
+			{-0.24683644f, 0.00779734377f, 0.00038012873f, 2.73099949e-05f},
+			{-0.238631658f, 0.00863953128f, 0.000460889665f, 3.67115554e-05f},
+			{-0.229494525f, 0.00967144535f, 0.000568919816f, 5.05573344e-05f},
+			{-0.219203602f, 0.0109609571f, 0.000716863405f, 7.17720177e-05f},
+			{-0.20745401f, 0.0126100001f, 0.000927197147f, 0.000104225293f},
+			{-0.193812588f, 0.0147770704f, 0.00123206901f, 0.000158308095f},
+			{-0.17764514f, 0.0177161329f, 0.00169295119f, 0.000247993391f},
+			{-0.157988062f, 0.0218460158f, 0.00241461929f, 0.000392597426f},
+			{-0.13333483f, 0.0278530471f, 0.00358037816f, 0.000577579734f},
+			{-0.101323825f, 0.0367465433f, 0.00537994039f, 0.000607116294f},
+			{-0.058590225f, 0.0493277739f, 0.00737900437f, -7.0098267e-05f},
+			{-0.001953545f, 0.0638754887f, 0.00706125655f, -0.00106949027f},
+			{0.06791371f, 0.0747895315f, 0.00365758145f, -0.000985392941f},
+			{0.14537543f, 0.0791485157f, 0.000746667983f, -0.000467153661f},
+			{0.22480346f, 0.0792403906f, -0.000595783595f, -0.000192244494f},
+			{0.303255822f, 0.0774720898f, -0.00114669151f, -9.69907627e-05f},
+			{0.37948423f, 0.0748877343f, -0.00142898836f, -6.82134245e-05f},
+			{0.452874763f, 0.0718251171f, -0.00163102772f, -6.3116863e-05f},
+			{0.523005735f, 0.0683737108f, -0.00181782302f, -6.52403002e-05f},
+			{0.589496383f, 0.0645423436f, -0.00200997863f, -6.9597487e-05f},
+			{0.65195915f, 0.0603135936f, -0.00221733643f, -7.15021738e-05f},
+			{0.709983905f, 0.0556644139f, -0.00243264298f, -7.32509236e-05f},
+			{0.763142425f, 0.0505793748f, -0.00265202734f, -6.96899869e-05f},
+			{0.811000082f, 0.0450662498f, -0.00285951483f, -5.66774896e-05f},
+			{0.85315014f, 0.0391771873f, -0.00303159872f, -2.67660886e-05f},
+			{0.889268963f, 0.0330336912f, -0.00311712699f, 1.55782784e-05f},
+			{0.919201105f, 0.0268461717f, -0.00307278557f, 6.9181393e-05f},
+			{0.943043672f, 0.0209081443f, -0.00286375948f, 0.000121692633f},
+			{0.96120975f, 0.015545703f, -0.00249691512f, 0.000159284658f},
+			{0.974417822f, 0.0110297264f, -0.00201913234f, 0.000166778406f},
+			{0.983595195f, 0.00749179678f, -0.00151881222f, 0.000149357941f},
+			{0.989717538f, 0.00490224602f, -0.0010718771f, 0.000118523571f},
+			{0.99366643f, 0.00311406245f, -0.00071926525f, 8.64502962e-05f},
+			{0.996147677f, 0.00193488278f, -0.000463576522f, 5.8556239e-05f},
+			{0.99767754f, 0.00118339842f, -0.000290583412f, 3.79149929e-05f},
+			{0.99860827f, 0.000715976551f, -0.000178683109f, 2.37965579e-05f},
+			{0.99916936f, 0.000429999993f, -0.000108548272f, 1.47157786e-05f},
+			{0.999505527f, 0.000257050777f, -6.53290564e-05f, 8.91077945e-06f},
+			{0.99970616f, 0.000153124998f, -3.90417152e-05f, 5.34421773e-06f},
+			{0.999825588f, 9.10742173e-05f, -2.41046854e-05f, 3.99296813e-06f},
+		},
+		{
+			0.278429568f, 0.267786957f, 0.257216653f, 0.246721f, 0.236302489f, 0.225963779f, 0.215707716f, 0.205537352f,
+			0.195455965f, 0.185467092f, 0.175574553f, 0.165782489f, 0.156095406f, 0.146518221f, 0.13705632f, 0.127715631f,
+			0.118502703f, 0.109424814f, 0.100490089f, 0.0917076617f, 0.0830878626f, 0.0746424701f, 0.0663850258f, 0.0583312467f,
+			0.050499579f, 0.0429119468f, 0.0355947879f, 0.0285805216f, 0.021909702f, 0.015634268f, 0.0098225872f, 0.0045675635f,
+			0.0f, -0.00368970163f, -0.00622112228f, -0.00720500336f, -0.00620279776f, -0.00288150647f, 0.00290229943f, 0.0111578307f,
+			0.0218323741f, 0.0348459589f, 0.0501030797f, 0.0674959028f, 0.0869046579f, 0.108197125f, 0.131227967f, 0.1558383f,
+			0.181855984f, 0.209097281f, 0.237370739f, 0.266483777f, 0.296251702f, 0.326507643f, 0.35711081f, 0.387950565f,
+			0.418945596f, 0.450039512f, 0.481194988f, 0.512388171f, 0.543604191f, 0.574833937f, 0.60607189f, 0.637314735f,
+			0.668560488f,
+		}
+	},
+	// WAVESHAPER_TUBE
+	{
+		{
+			{-0.7f, 0.000710089116f, 6.48553086e-05f, 4.32560618e-06f},
+			{-0.69922073f, 0.000852776551f, 7.7802551e-05f, 5.17506262e-06f},
+			{-0.698284976f, 0.00102390684f, 9.32929888e-05f, 6.18514648e-06f},
+			{-0.697161591f, 0.00122904826f, 0.000111807802f, 7.38348195e-06f},
+			{-0.695813351f, 0.00147481431f, 0.000133911051f, 8.80120184e-06f},
+			{-0.694195825f, 0.00176904002f, 0.000160260251f, 1.04727935e-05f},
+			{-0.692256052f, 0.0021209789f, 0.000191616538f, 1.2435575e-05f},
+			{-0.689931021f, 0.0025415187f, 0.000228853288f, 1.4728608e-05f},
+			{-0.68714592f, 0.0030434111f, 0.00027296155f, 1.73907743e-05f},
+			{-0.683812157f, 0.00364150652f, 0.000325049789f, 2.04576618e-05f},
+			{-0.679825143f, 0.00435297909f, 0.000386334378f, 2.3956829e-05f},
+			{-0.675061872f, 0.00519751833f, 0.000458116009f, 2.79008428e-05f},
+			{-0.669378337f, 0.00619745288f, 0.000541735359f, 3.22775227e-05f},
+			{-0.662606871f, 0.00737775616f, 0.000638499581f, 3.70367309e-05f},
+			{-0.654553579f, 0.00876586552f, 0.000749569251f, 4.20732171e-05f},
+			{-0.644996071f, 0.0103912237f, 0.000875793795f, 4.7205488e-05f},
+			{-0.633681848f, 0.0122844277f, 0.00101748324f, 5.21514773e-05f},
+			{-0.620327786f, 0.0144758486f, 0.00117410635f, 5.65032252e-05f},
+			{-0.604621327f, 0.016993571f, 0.00134391157f, 5.97051149e-05f},
+			{-0.58622414f, 0.0198605095f, 0.00152348095f, 6.10431595e-05f},
+			{-0.564779106f, 0.0230906009f, 0.00170724921f, 5.96563573e-05f},
+			{-0.5399216f, 0.0266840684f, 0.00188705405f, 5.45841148e-05f},
+			{-0.511295893f, 0.0306219288f, 0.00205182592f, 4.48643463e-05f},
+			{-0.478577274f, 0.0348601737f, 0.00218757098f, 2.96922362e-05f},
+			{-0.441499837f, 0.0393243924f, 0.00227783288f, 8.63703219e-06f},
+			{-0.399888975f, 0.0439059692f, 0.0023048126f, -1.81082285e-05f},
+			{-0.353696301f, 0.0484612697f, 0.00225125141f, -4.94983341e-05f},
+			{-0.303033278f, 0.0528152775f, 0.00210301698f, -8.35097264e-05f},
+			{-0.248198494f, 0.0567707823f, 0.00185208434f, -0.000117204935f},
+			{-0.189692832f, 0.0601233362f, 0.00149932997f, -0.000147047333f},
+			{-0.128217213f, 0.0626808541f, 0.0010563701f, -0.000169455359f},
+			{-0.0646494441f, 0.0642852283f, 0.000545705786f, -0.000181489922f},
+			{0.0f, 0.0648321701f, -2.63022126e-07f, -8.40221901e-05f},
+			{0.0647478849f, 0.0645795774f, -0.000252838376f, -8.1424619e-05f},
+			{0.128993199f, 0.0638296268f, -0.000497571157f, -7.63984838e-05f},
+			{0.192248857f, 0.0626052891f, -0.000727148524f, -6.92631637e-05f},
+			{0.254057734f, 0.0609432025f, -0.000935223853f, -6.04542321e-05f},
+			{0.314005258f, 0.0588913921f, -0.00111676669f, -5.04792004e-05f},
+			{0.371729405f, 0.0565064212f, -0.00126827856f, -3.98698254e-05f},
+			{0.426927677f, 0.0538502546f, -0.00138786458f, -2.91374136e-05f},
+			{0.47936093f, 0.0509871132f, -0.00147517001f, -1.87362539e-05f},
+			{0.528854137f, 0.0479805644f, -0.00153120686f, -9.03823584e-06f},
+			{0.575294456f, 0.0448910359f, -0.00155810428f, -3.19613545e-07f},
+			{0.618627068f, 0.0417738685f, -0.00155881959f, 7.24107187e-06f},
+			{0.658849358f, 0.0386779526f, -0.00153684364f, 1.35561032e-05f},
+			{0.696004023f, 0.0356449336f, -0.00149592739f, 1.86155609e-05f},
+			{0.730171645f, 0.0327089255f, -0.00143984815f, 2.24710463e-05f},
+			{0.761463193f, 0.0298966423f, -0.00137222505f, 2.52185675e-05f},
+			{0.790012829f, 0.0272278479f, -0.00129638615f, 2.69824352e-05f},
+			{0.815971273f, 0.0247160229f, -0.00121528408f, 2.79013701e-05f},
+			{0.839499914f, 0.0223691589f, -0.00113145335f, 2.8117367e-05f},
+			{0.860765737f, 0.0201906043f, -0.00104700114f, 2.7767431e-05f},
+			{0.879937107f, 0.0181799043f, -0.000963622722f, 2.69779764e-05f},
+			{0.897180367f, 0.0163335928f, -0.000882633648f, 2.5861503e-05f},
+			{0.912657187f, 0.01464591f, -0.000805011827f, 2.45150624e-05f},
+			{0.9265226f, 0.0131094315f, -0.00073144408f, 2.30200621e-05f},
+			{0.938923608f, 0.0117156035f, -0.000662373218f, 2.14430027e-05f},
+			{0.949998281f, 0.0104551861f, -0.00059804285f, 1.9836757e-05f},
+			{0.959875261f, 0.00931861068f, -0.000538538299f, 1.82421978e-05f},
+			{0.968673576f, 0.00829626068f, -0.000483822619f, 1.66898962e-05f},
+			{0.976502704f, 0.00737868513f, -0.000433767475f, 1.52017956e-05f},
+			{0.983462823f, 0.00655675556f, -0.000388179002f, 1.37928011e-05f},
+			{0.989645193f, 0.00582177596f, -0.000346818879f, 1.24721612e-05f},
+			{0.995132622f, 0.00516555469f, -0.000309421271f, 1.12447142e-05f},
+		},
+		{
+			0.538996636f, 0.51713344f, 0.495296968f, 0.473492581f, 0.451726708f, 0.430007048f, 0.408342821f, 0.386745053f,
+			0.365226919f, 0.343804141f, 0.322495456f, 0.301323147f, 0.280313664f, 0.259498322f, 0.238914075f, 0.218604379f,
+			0.198620106f, 0.179020499f, 0.159874113f, 0.141259686f, 0.123266849f, 0.105996542f, 0.089561014f, 0.0740832087f,
+			0.0596953782f, 0.0465367469f, 0.0347501142f, 0.0244773759f, 0.0158540787f, 0.00900329612f, 0.00402929147f, 0.00101157189f,
+			0.0f, 0.00101234349f, 0.00404150093f, 0.00906409643f, 0.0160419653f, 0.0249232928f, 0.0356441077f, 0.0481300417f,
+			0.0622982573f, 0.0780594473f, 0.0953198147f, 0.113982956f, 0.133951588f, 0.15512907f, 0.177420711f, 0.200734829f,
+			0.224983592f, 0.250083634f, 0.275956483f, 0.302528808f, 0.329732526f, 0.357504794f, 0.385787901f, 0.414529086f,
+			0.443680313f, 0.473198f, 0.503042734f, 0.533178972f, 0.563574741f, 0.594201343f, 0.625033069f, 0.656046932f,
+			0.687222403f,
+		}
+	},
+	// WAVESHAPER_DIODE
+	{
+		{
+			{-1.0f, 0.00188384004f, 9.66392135e-05f, 4.51282044e-06f},
+			{-0.998015008f, 0.00209065692f, 0.000110149865f, 5.28386364e-06f},
+			{-0.995808917f, 0.00232680825f, 0.000125967434f, 6.2090966e-06f},
+			{-0.993349932f, 0.0025973704f, 0.000144552982f, 7.32325008e-06f},
+			{-0.990600686f, 0.00290844612f, 0.000166471392f, 8.66949428e-06f},
+			{-0.987517099f, 0.00326739739f, 0.000192416601f, 1.0301504e-05f},
+			{-0.984046983f, 0.0036831351f, 0.000223243033f, 1.22859483e-05f},
+			{-0.980128319f, 0.00416647901f, 0.000260004486f, 1.47054265e-05f},
+			{-0.97568713f, 0.00473060426f, 0.000304001875f, 1.76617475e-05f},
+			{-0.970634862f, 0.00539159326f, 0.000356840872f, 2.12793728e-05f},
+			{-0.964865149f, 0.00616911312f, 0.000420500025f, 2.57083968e-05f},
+			{-0.958249827f, 0.00708723836f, 0.000497408134f, 3.11260419e-05f},
+			{-0.950634055f, 0.00817543275f, 0.000590526635f, 3.77345397e-05f},
+			{-0.941830361f, 0.00946968964f, 0.0007034266f, 4.57517521e-05f},
+			{-0.931611493f, 0.0110137981f, 0.000840339142f, 5.5388317e-05f},
+			{-0.919701967f, 0.0128606413f, 0.00100613971f, 6.68013832e-05f},
+			{-0.905768385f, 0.0150733249f, 0.00120619709f, 8.00101459e-05f},
+			{-0.889408853f, 0.0177257495f, 0.00144597326f, 9.47535072e-05f},
+			{-0.870142377f, 0.0209019566f, 0.00173020006f, 0.000110268994f},
+			{-0.847399951f, 0.0246931637f, 0.00206139188f, 0.00012498338f},
+			{-0.820520412f, 0.0291908976f, 0.00243741712f, 0.000136146111f},
+			{-0.788755951f, 0.0344741701f, 0.00284793141f, 0.000139529949f},
+			{-0.75129432f, 0.0405886228f, 0.00326983685f, 0.000129482481f},
+			{-0.707306378f, 0.0475167439f, 0.00366279087f, 9.97898725e-05f},
+			{-0.656027053f, 0.0551416953f, 0.00396723637f, 4.58234162e-05f},
+			{-0.596872298f, 0.0632136383f, 0.00410897541f, -3.20631035e-05f},
+			{-0.529581747f, 0.0713353998f, 0.00401434223f, -0.000125143519f},
+			{-0.454357149f, 0.0789886537f, 0.00363613787f, -0.000215540154f},
+			{-0.371947897f, 0.085614309f, 0.0029821443f, -0.000280364653f},
+			{-0.283631809f, 0.0907375036f, 0.00213051223f, -0.000299747055f},
+			{-0.19106354f, 0.0940992869f, 0.00121936577f, -0.000262700691f},
+			{-0.0960075879f, 0.0957499164f, 0.000412080453f, -0.000154408875f},
+			{0.0f, 0.0961108506f, 5.11461727e-05f, -0.000154408875f},
+			{0.0960075879f, 0.0957499164f, -0.000431263694f, -0.000262700691f},
+			{0.19106354f, 0.0940992869f, -0.00123127107f, -0.000299747055f},
+			{0.283631809f, 0.0907375036f, -0.00214105034f, -0.000280364653f},
+			{0.371947897f, 0.085614309f, -0.00298951741f, -0.000215540154f},
+			{0.454357149f, 0.0789886537f, -0.00363891167f, -0.000125143519f},
+			{0.529581747f, 0.0713353998f, -0.0040127861f, -3.20631035e-05f},
+			{0.596872298f, 0.0632136383f, -0.00410470662f, 4.58234162e-05f},
+			{0.656027053f, 0.0551416953f, -0.00396216049f, 9.97898725e-05f},
+			{0.707306378f, 0.0475167439f, -0.00365828429f, 0.000129482481f},
+			{0.75129432f, 0.0405886228f, -0.00326652125f, 0.000139529949f},
+			{0.788755951f, 0.0344741701f, -0.00284585546f, 0.000136146111f},
+			{0.820520412f, 0.0291908976f, -0.00243634202f, 0.00012498338f},
+			{0.847399951f, 0.0246931637f, -0.00206100704f, 0.000110268994f},
+			{0.870142377f, 0.0209019566f, -0.00173023378f, 9.47535072e-05f},
+			{0.889408853f, 0.0177257495f, -0.00144622752f, 8.00101459e-05f},
+			{0.905768385f, 0.0150733249f, -0.00120654386f, 6.68013832e-05f},
+			{0.919701967f, 0.0128606413f, -0.00100650409f, 5.5388317e-05f},
+			{0.931611493f, 0.0110137981f, -0.000840681856f, 4.57517521e-05f},
+			{0.941830361f, 0.00946968964f, -0.000703730254f, 3.77345397e-05f},
+			{0.950634055f, 0.00817543275f, -0.000590786259f, 3.11260419e-05f},
+			{0.958249827f, 0.00708723836f, -0.000497625215f, 2.57083968e-05f},
+			{0.964865149f, 0.00616911312f, -0.00042067899f, 2.12793728e-05f},
+			{0.970634862f, 0.00539159326f, -0.000356987118f, 1.76617475e-05f},
+			{0.97568713f, 0.00473060427f, -0.000304120766f, 1.47054265e-05f},
+			{0.980128319f, 0.00416647901f, -0.000260100878f, 1.22859483e-05f},
+			{0.984046983f, 0.0036831351f, -0.000223321113f, 1.0301504e-05f},
+			{0.987517099f, 0.00326739739f, -0.000192479875f, 8.66949428e-06f},
+			{0.990600686f, 0.00290844612f, -0.000166522732f, 7.32325008e-06f},
+			{0.993349932f, 0.0025973704f, -0.000144594724f, 6.2090966e-06f},
+			{0.995808917f, 0.00232680825f, -0.000126001456f, 5.28386364e-06f},
+			{0.998015008f, 0.00209065693f, -0.000110177675f, 4.51282044e-06f},
+		},
+		{
+			0.775331867f, 0.744112344f, 0.71295823f, 0.681876919f, 0.65087688f, 0.619967855f, 0.589161084f, 0.558469586f,
+			0.5279085f, 0.497495498f, 0.467251285f, 0.437200223f, 0.407371078f, 0.377797951f, 0.348521401f, 0.319589819f,
+			0.291061083f, 0.263004531f, 0.235503272f, 0.2086568f, 0.182583831f, 0.157425129f, 0.133345921f, 0.110537243f,
+			0.0892153016f, 0.0696177285f, 0.0519957337f, 0.0366017581f, 0.0236734874f, 0.0134167128f, 0.00599084338f, 0.00150105849f,
+			0.0f, 0.00150105849f, 0.00599084338f, 0.0134167128f, 0.0236734874f, 0.0366017581f, 0.0519957337f, 0.0696177285f,
+			0.0892153016f, 0.110537243f, 0.133345921f, 0.157425129f, 0.182583831f, 0.2086568f, 0.235503272f, 0.263004531f,
+			0.291061083f, 0.319589819f, 0.348521401f, 0.377797951f, 0.407371078f, 0.437200223f, 0.467251285f, 0.497495498f,
+			0.5279085f, 0.558469586f, 0.589161084f, 0.619967855f, 0.65087688f, 0.681876919f, 0.71295823f, 0.744112344f,
+			0.775331867f,
+		}
+	},
+	// WAVESHAPER_FUZZ
+	{
+		{
+			{-0.6f, 4.04899551e-07f, 8.29079093e-08f, 1.44919889e-08f},
+			{-0.599999498f, 6.14190469e-07f, 1.25764218e-07f, 2.19817387e-08f},
+			{-0.599998736f, 9.31664815e-07f, 1.90767651e-07f, 3.33464583e-08f},
+			{-0.59999758f, 1.41323897e-06f, 2.89375786e-07f, 5.05825898e-08f},
+			{-0.599995827f, 2.14373849e-06f, 4.38950941e-07f, 7.67300113e-08f},
+			{-0.599993167f, 3.25182901e-06f, 6.65846428e-07f, 1.16389383e-07f},
+			{-0.599989133f, 4.93269002e-06f, 1.01001844e-06f, 1.76551554e-07f},
+			{-0.599983014f, 7.48238103e-06f, 1.5320952e-06f, 2.67809675e-07f},
+			{-0.599973732f, 1.13500008e-05f, 2.32402671e-06f, 4.06242243e-07f},
+			{-0.599959651f, 1.7216779e-05f, 3.52531194e-06f, 6.16225102e-07f},
+			{-0.599938293f, 2.61160777e-05f, 5.34753298e-06f, 9.34750557e-07f},
+			{-0.599905895f, 3.96153955e-05f, 8.11165455e-06f, 1.41792031e-06f},
+			{-0.59985675f, 6.00924666e-05f, 1.23045422e-05f, 2.15083936e-06f},
+			{-0.599782202f, 9.11540695e-05f, 1.86647212e-05f, 3.26260129e-06f},
+			{-0.599669121f, 0.000138271316f, 2.83124554e-05f, 4.94902971e-06f},
+			{-0.599497588f, 0.000209743315f, 4.29470755e-05f, 7.5071658e-06f},
+			{-0.59923739f, 0.000318158964f, 6.51462789e-05f, 1.1387597e-05f},
+			{-0.598842697f, 0.000482614313f, 9.8820183e-05f, 1.72738087e-05f},
+			{-0.598243989f, 0.000732076105f, 0.000149900021f, 2.62025837e-05f},
+			{-0.59733581f, 0.0011104839f, 0.000227382861f, 3.97466158e-05f},
+			{-0.595958197f, 0.00168448947f, 0.000344916332f, 6.0291515e-05f},
+			{-0.5938685f, 0.00255519668f, 0.000523202479f, 9.14560061e-05f},
+			{-0.590698645f, 0.00387596965f, 0.000793644166f, 0.000138729322f},
+			{-0.585890301f, 0.00587944595f, 0.00120387629f, 0.000210438064f},
+			{-0.578596541f, 0.00891851273f, 0.00182615609f, 0.000319212826f},
+			{-0.567532659f, 0.0135284634f, 0.00277009032f, 0.000484212913f},
+			{-0.550749893f, 0.0205212828f, 0.00420194114f, 0.000734501017f},
+			{-0.525292168f, 0.0311286681f, 0.00637391105f, 0.00111416224f},
+			{-0.486675427f, 0.0472189769f, 0.00966856525f, 0.00169006913f},
+			{-0.428097815f, 0.0716263148f, 0.0146662157f, 0.00256366045f},
+			{-0.339241624f, 0.108649727f, 0.0222471355f, 0.00388880832f},
+			{-0.204455953f, 0.164810423f, 0.0337466086f, 0.00589892089f},
+			{0.0f, 0.157309946f, -0.0122663389f, 0.000592353008f},
+			{0.14563596f, 0.134554327f, -0.0104919556f, 0.000506666377f},
+			{0.270204998f, 0.115090415f, -0.00897424524f, 0.000433374719f},
+			{0.376754543f, 0.0984420487f, -0.00767607873f, 0.00037068504f},
+			{0.467891198f, 0.0842019464f, -0.00656569808f, 0.000317063718f},
+			{0.54584451f, 0.0720217414f, -0.00561593917f, 0.000271198969f},
+			{0.612521511f, 0.06160346f, -0.00480356733f, 0.000231968772f},
+			{0.669553372f, 0.0526922316f, -0.00410870887f, 0.000198413405f},
+			{0.718335308f, 0.0450700541f, -0.00351436493f, 0.000169711979f},
+			{0.76006071f, 0.0385504602f, -0.00300599562f, 0.000145162347f},
+			{0.795750336f, 0.032973956f, -0.00257116431f, 0.000124163935f},
+			{0.826277292f, 0.0282041192f, -0.00219923338f, 0.000106203043f},
+			{0.852388381f, 0.0241242615f, -0.00188110399f, 9.08402758e-05f},
+			{0.874722379f, 0.0206345744f, -0.00160899351f, 7.76998047e-05f},
+			{0.893825659f, 0.0176496868f, -0.00137624508f, 6.6460165e-05f},
+			{0.910165561f, 0.0150965771f, -0.0011771648f, 5.68463915e-05f},
+			{0.92414182f, 0.0129127867f, -0.00100688241f, 4.8623296e-05f},
+			{0.936096348f, 0.0110448918f, -0.000861232164f, 4.15897081e-05f},
+			{0.946321597f, 0.00944719656f, -0.00073665091f, 3.55735645e-05f},
+			{0.955067716f, 0.00808061543f, -0.000630090912f, 3.04276808e-05f},
+			{0.962548668f, 0.00691171665f, -0.000538945316f, 2.60261744e-05f},
+			{0.968947466f, 0.00591190454f, -0.00046098436f, 2.22613673e-05f},
+			{0.974420647f, 0.00505671993f, -0.000394300818f, 1.90411567e-05f},
+			{0.979102108f, 0.00432524176f, -0.00033726336f, 1.62867634e-05f},
+			{0.983106373f, 0.00369957533f, -0.000288476639f, 1.39308067e-05f},
+			{0.986531402f, 0.00316441447f, -0.000246747146f, 1.19156509e-05f},
+			{0.989460985f, 0.00270666713f, -0.000211054019f, 1.01919969e-05f},
+			{0.99196679f, 0.00231513508f, -0.000180524069f, 8.71767698e-06f},
+			{0.994110119f, 0.00198023998f, -0.000154410419f, 7.45662424e-06f},
+			{0.995943405f, 0.00169378901f, -0.000132074229f, 6.3779876e-06f},
+			{0.997511498f, 0.00144877452f, -0.000112969076f, 5.45538305e-06f},
+			{0.998852759f, 0.00123920251f, -9.66275714e-05f, 4.66623623e-06f},
+		},
+		{
+			0.555002848f, 0.536252855f, 0.517502882f, 0.498752938f, 0.480003039f, 0.461253208f, 0.442503481f, 0.423753909f,
+			0.405004575f, 0.386255601f, 0.367507172f, 0.348759571f, 0.330013227f, 0.311268787f, 0.292527238f, 0.273790072f,
+			0.255059555f, 0.236339126f, 0.217633997f, 0.198952077f, 0.180305363f, 0.161712053f, 0.143199752f, 0.124810333f,
+			0.106607311f, 0.0886870376f, 0.0711956623f, 0.0543548817f, 0.0385009862f, 0.0241440935f, 0.0120579996f, 0.00341647317f,
+			0.0f, 0.0023348213f, 0.00888302354f, 0.0190351215f, 0.0322697948f, 0.0481411345f, 0.0662677345f, 0.0863233609f,
+			0.108028971f, 0.131145887f, 0.155469957f, 0.18082656f, 0.207066335f, 0.234061529f, 0.261702865f, 0.289896877f,
+			0.318563616f, 0.347634702f, 0.377051643f, 0.40676441f, 0.43673021f, 0.466912441f, 0.497279795f, 0.527805492f,
+			0.558466629f, 0.589243613f, 0.620119686f, 0.651080515f, 0.682113839f, 0.713209171f, 0.744357542f, 0.775551279f,
+			0.80678382f,
+		}
+	},
+};
@@ -0,0 +1,146 @@
+/**
+ * @file basic_waveshaper.h
+ * @author Piotr Zapart
+ * @brief Table based waveshaper with selectable drive curves
+ * 			The curves are defined over the -1.0 ... 1.0 input range and stored
+ * 			in flash as 64 cubic segments (Hermite fit), 1.3kB per curve. The fit
+ * 			is C1 continuous wherever the source curve is, FUZZ keeps its kink at 0.
+ * 			The segment table of the used curve stays in the data cache, evaluation
+ * 			is one table read and 3 multiply-adds per sample.
+ * 			Outside the input range the output is constant (the curve end values).
+ * 			Max. deviation from the source curves < 4e-5 (FUZZ next to the kink),
+ * 			< 2.5e-5 for BOOSTER, < 3e-6 for TUBE and DIODE.
+ *
+ * 			Curves:
+ * 			WAVESHAPER_BOOSTER	the AudioEffectGuitarBooster_F32 transfer curve
+ * 			WAVESHAPER_TUBE		asymmetric soft clipper, tanh with a softer negative side
+ * 			WAVESHAPER_DIODE	symmetric diode clipper, x/(1+|x|^2.5)^(1/2.5)
+ * 			WAVESHAPER_FUZZ		asymmetric, hard knee negative side clipping at -0.6,
+ * 								slope 5.03 above and 8.0 below 0
+ *
+ * 			Each curve comes with its antiderivative at the segment starts, used by the
+ * 			first order antiderivative antialiasing (ADAA) versions of process().
+ * @version 1.0
+ * @date 2024-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+#ifndef _BASIC_WAVESHAPER_H_
+#define _BASIC_WAVESHAPER_H_
+
+#include <Arduino.h>
+#include <arm_math.h>
+
+#define WAVESHAPER_SEGMENTS		(64)
+#define WAVESHAPER_ADAA_EPS		(1.0e-3f)	// minimum input step for the ADAA difference quotient
+
+typedef enum
+{
+	WAVESHAPER_BOOSTER,
+	WAVESHAPER_TUBE,
+	WAVESHAPER_DIODE,
+	WAVESHAPER_FUZZ,
+	WAVESHAPER_CURVE_COUNT
+}waveshaper_curve_t;
+
+typedef struct
+{
+	float32_t seg[WAVESHAPER_SEGMENTS][4];			// y = c0 + t*(c1 + t*(c2 + t*c3)), t = 0...1 within the segment
+	float32_t integ[WAVESHAPER_SEGMENTS + 1];		// antiderivative at the segment starts, 0 at x = 0
+}waveshaper_table_t;
+
+extern const waveshaper_table_t waveshaper_tables[WAVESHAPER_CURVE_COUNT];
+
+/**
+ * @brief ADAA state, one per processed channel
+ */
+typedef struct
+{
+	float32_t x1;		// previous input
+	float32_t F1;		// antiderivative at the previous input
+}waveshaper_adaa_t;
+
+class AudioBasicWaveshaper
+{
+public:
+	AudioBasicWaveshaper(waveshaper_curve_t c=WAVESHAPER_BOOSTER) { curve(c); }
+	/**
+	 * @brief select the transfer curve
+	 */
+	void curve(waveshaper_curve_t c)
+	{
+		if (c >= WAVESHAPER_CURVE_COUNT) c = WAVESHAPER_BOOSTER;
+		const waveshaper_table_t *t = &waveshaper_tables[c];
+		const float32_t *last = t->seg[WAVESHAPER_SEGMENTS - 1];
+		__disable_irq();
+		crv = c;
+		tbl = t;
+		yLo = t->seg[0][0];
+		yHi = last[0] + last[1] + last[2] + last[3];
+		__enable_irq();
+	}
+	waveshaper_curve_t curve_get() { return crv; }
+	/**
+	 * @brief shape one sample
+	 */
+	inline float32_t process(float32_t x)
+	{
+		float32_t idx = (x + 1.0f) * (WAVESHAPER_SEGMENTS * 0.5f);
+		if (idx <= 0.0f) return yLo;
+		if (idx >= (float32_t)WAVESHAPER_SEGMENTS) return yHi;
+		uint32_t k = (uint32_t)idx;
+		float32_t t = idx - (float32_t)k;
+		const float32_t *c = tbl->seg[k];
+		return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+	}
+	/**
+	 * @brief antiderivative of the curve, exact for the cubic segments
+	 */
+	inline float32_t integral(float32_t x)
+	{
+		const float32_t h = 2.0f / WAVESHAPER_SEGMENTS;
+		float32_t idx = (x + 1.0f) * (WAVESHAPER_SEGMENTS * 0.5f);
+		if (idx <= 0.0f) return tbl->integ[0] + yLo * (x + 1.0f);
+		if (idx >= (float32_t)WAVESHAPER_SEGMENTS) return tbl->integ[WAVESHAPER_SEGMENTS] + yHi * (x - 1.0f);
+		uint32_t k = (uint32_t)idx;
+		float32_t t = idx - (float32_t)k;
+		const float32_t *c = tbl->seg[k];
+		return tbl->integ[k] + h * t * (c[0] + t * (c[1] * 0.5f + t * (c[2] * (1.0f / 3.0f) + t * c[3] * 0.25f)));
+	}
+	/**
+	 * @brief shape one sample with first order ADAA, (F(x) - F(x1)) / (x - x1)
+	 * 		the plain curve at the midpoint is used for the small steps
+	 *
+	 * @param x 	input sample
+	 * @param st 	ADAA state of the channel
+	 */
+	inline float32_t process_adaa(float32_t x, waveshaper_adaa_t *st)
+	{
+		float32_t F = integral(x);
+		float32_t dx = x - st->x1;
+		float32_t y;
+		if (fabsf(dx) > WAVESHAPER_ADAA_EPS) 	y = (F - st->F1) / dx;
+		else 									y = process(0.5f * (x + st->x1));
+		st->x1 = x;
+		st->F1 = F;
+		return y;
+	}
+	/**
+	 * @brief block versions, in place allowed
+	 */
+	void process(const float32_t *in, float32_t *out, uint32_t len)
+	{
+		for (uint32_t i = 0; i < len; i++) out[i] = process(in[i]);
+	}
+	void process_adaa(const float32_t *in, float32_t *out, uint32_t len, waveshaper_adaa_t *st)
+	{
+		for (uint32_t i = 0; i < len; i++) out[i] = process_adaa(in[i], st);
+	}
+private:
+	const waveshaper_table_t *tbl;
+	float32_t yLo, yHi;				// output outside the input range
+	waveshaper_curve_t crv;
+};
+
+#endif // _BASIC_WAVESHAPER_H_
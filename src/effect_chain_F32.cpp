@@ -0,0 +1,147 @@
+/*  In place stereo effect chain for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "effect_chain_F32.h"
+
+void AudioEffectChain_F32::update()
+{
+	audio_block_f32_t *blockL, *blockR;
+
+	if (bp || !stageCount)
+	{
+		// read only blocks are passed through, no audio memory copy or allocation
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!bypass_process(&blockL, &blockR, BYPASS_MODE_PASS, false))
+		return;
+	process(blockL->data, blockR->data, blockL->length);
+	AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+}
+
+/**
+ * @brief run all stages on the same buffers
+ * 			The chain itself implements the kernel interface, chains can be nested.
+ */
+void AudioEffectChain_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+	uint32_t t0, t;
+	stage_t *st;
+
+	if (bp) return;
+	for (uint8_t i = 0; i < stageCount; i++)
+	{
+		st = &stage[i];
+		t0 = ARM_DWT_CYCCNT;
+		st->fx->process(dataL, dataR, len);
+		t = (ARM_DWT_CYCCNT - t0) >> 6;	// same scale as the cpu_cycles of the audio library
+		st->cycles = t;
+		if (t > st->cyclesMax) st->cyclesMax = t;
+	}
+}
+
+int8_t AudioEffectChain_F32::insert(uint8_t pos, AudioEffectKernel_F32 &fx)
+{
+	if (stageCount >= EFFECT_CHAIN_MAX_STAGES) return -1;
+	if (pos > stageCount) pos = stageCount;
+	__disable_irq();
+	for (uint8_t i = stageCount; i > pos; i--) stage[i] = stage[i - 1];
+	stage[pos].fx = &fx;
+	stage[pos].cycles = 0;
+	stage[pos].cyclesMax = 0;
+	stageCount++;
+	__enable_irq();
+	return pos;
+}
+
+bool AudioEffectChain_F32::remove(uint8_t pos)
+{
+	if (pos >= stageCount) return false;
+	__disable_irq();
+	stageCount--;
+	for (uint8_t i = pos; i < stageCount; i++) stage[i] = stage[i + 1];
+	__enable_irq();
+	return true;
+}
+
+bool AudioEffectChain_F32::move(uint8_t from, uint8_t to)
+{
+	stage_t tmp;
+	uint8_t i;
+	if (from >= stageCount || to >= stageCount) return false;
+	__disable_irq();
+	tmp = stage[from];
+	if (from < to)
+		for (i = from; i < to; i++) stage[i] = stage[i + 1];
+	else
+		for (i = from; i > to; i--) stage[i] = stage[i - 1];
+	stage[to] = tmp;
+	__enable_irq();
+	return true;
+}
+
+bool AudioEffectChain_F32::swap(uint8_t a, uint8_t b)
+{
+	stage_t tmp;
+	if (a >= stageCount || b >= stageCount) return false;
+	__disable_irq();
+	tmp = stage[a];
+	stage[a] = stage[b];
+	stage[b] = tmp;
+	__enable_irq();
+	return true;
+}
+
+int8_t AudioEffectChain_F32::find(AudioEffectKernel_F32 &fx)
+{
+	for (uint8_t i = 0; i < stageCount; i++)
+	{
+		if (stage[i].fx == &fx) return i;
+	}
+	return -1;
+}
+
+float32_t AudioEffectChain_F32::stage_usage(uint8_t pos)
+{
+	if (pos >= stageCount) return 0.0f;
+	return CYCLE_COUNTER_APPROX_PERCENT(stage[pos].cycles);
+}
+
+float32_t AudioEffectChain_F32::stage_usageMax(uint8_t pos)
+{
+	if (pos >= stageCount) return 0.0f;
+	return CYCLE_COUNTER_APPROX_PERCENT(stage[pos].cyclesMax);
+}
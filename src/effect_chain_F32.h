@@ -0,0 +1,163 @@
+/*  In place stereo effect chain for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _EFFECT_CHAIN_F32_H_
+#define _EFFECT_CHAIN_F32_H_
+
+#include <Arduino.h>
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
+
+#define EFFECT_CHAIN_MAX_STAGES		(12)
+
+/**
+ * @brief Series chain of stereo effects processed in one update()
+ * 		The chain receives one pair of blocks and runs the process() function
+ * 		of each stage on them in place, the blocks are transmitted once at the end.
+ * 		The stages can be reordered, inserted and removed at runtime without
+ * 		patch cords.
+ * 		It is not a memory or CPU saving for a linear rig: the supported effects
+ * 		already process the received blocks in place, the same effects connected
+ * 		with patch cords use the same number of audio blocks and about the same
+ * 		time (see extras/test/bench_chain.cpp).
+ * 		Effects added to the chain must not be connected with patch cords,
+ * 		unconnected objects are not updated by the audio library, the chain
+ * 		is the only caller of their process() function.
+ * 			AudioEffectChain_F32 chain;
+ * 			chain.add(booster);
+ * 			chain.add(cabsim);
+ * 			chain.add(reverb);
+ * 			AudioConnection_F32 cable(i2s_in, 0, chain, 0); ...
+ * 		Per stage CPU load is measured with the cycle counter.
+ */
+class AudioEffectChain_F32 : public AudioStream_F32, public AudioEffectKernel_F32
+{
+public:
+	AudioEffectChain_F32(void) : AudioStream_F32(2, inputQueueArray) {}
+	AudioEffectChain_F32(const AudioSettings_F32 &) : AudioStream_F32(2, inputQueueArray) {}
+	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
+	/**
+	 * @brief append an effect at the end of the chain
+	 *
+	 * @param fx effect implementing the AudioEffectKernel_F32 interface
+	 * @return int8_t stage index, -1 if the chain is full
+	 */
+	int8_t add(AudioEffectKernel_F32 &fx) { return insert(stageCount, fx); }
+	/**
+	 * @brief insert an effect before the stage pos, the following stages move one position up
+	 *
+	 * @param pos 	new stage index, values > stages() append the effect
+	 * @param fx 	effect implementing the AudioEffectKernel_F32 interface
+	 * @return int8_t stage index, -1 if the chain is full
+	 */
+	int8_t insert(uint8_t pos, AudioEffectKernel_F32 &fx);
+	/**
+	 * @brief remove the stage, the effect is not processed any more
+	 */
+	bool remove(uint8_t pos);
+	/**
+	 * @brief move a stage to a new position, the stages between move by one
+	 *
+	 * @param from 	current stage index
+	 * @param to 	new stage index
+	 * @return true on success, false if any of the indexes is out of range
+	 */
+	bool move(uint8_t from, uint8_t to);
+	/**
+	 * @brief exchange two stages
+	 */
+	bool swap(uint8_t a, uint8_t b);
+	void clear()
+	{
+		__disable_irq();
+		stageCount = 0;
+		__enable_irq();
+	}
+	uint8_t stages() { return stageCount; }
+	/**
+	 * @brief find the stage index of an effect
+	 *
+	 * @return int8_t stage index, -1 if the effect is not in the chain
+	 */
+	int8_t find(AudioEffectKernel_F32 &fx);
+	AudioEffectKernel_F32 *stage_get(uint8_t pos) { return pos < stageCount ? stage[pos].fx : NULL; }
+	/**
+	 * @brief per stage bypass, uses the bypass of the effect itself,
+	 * 			with its own mode (PASS/OFF/TRAILS) and crossfade
+	 */
+	void stage_bypass_set(uint8_t pos, bool state)
+	{
+		if (pos < stageCount) stage[pos].fx->bypass_set(state);
+	}
+	bool stage_bypass_get(uint8_t pos) { return pos < stageCount ? stage[pos].fx->bypass_get() : true; }
+	bool stage_bypass_tgl(uint8_t pos)
+	{
+		stage_bypass_set(pos, !stage_bypass_get(pos));
+		return stage_bypass_get(pos);
+	}
+	/**
+	 * @brief CPU load of the stage in the last update, same scale as processorUsage()
+	 */
+	float32_t stage_usage(uint8_t pos);
+	float32_t stage_usageMax(uint8_t pos);
+	void stage_usageMaxReset()
+	{
+		__disable_irq();
+		for (uint8_t i = 0; i < EFFECT_CHAIN_MAX_STAGES; i++) stage[i].cyclesMax = 0;
+		__enable_irq();
+	}
+	/**
+	 * @brief bypass the whole chain, the read only input blocks are passed through
+	 * 			the effects are not processed
+	 */
+	void bypass_set(bool state)
+	{
+		__disable_irq();
+		bp = state;
+		__enable_irq();
+	}
+	bool bypass_get(void) { return bp; }
+	bool bypass_tgl(void)
+	{
+		bypass_set(bp ^ 1);
+		return bp;
+	}
+private:
+	audio_block_f32_t *inputQueueArray[2];
+	typedef struct
+	{
+		AudioEffectKernel_F32 *fx;
+		uint32_t cycles;		// cycles/64 used in the last update, as AudioStream::cpu_cycles
+		uint32_t cyclesMax;
+	}stage_t;
+	stage_t stage[EFFECT_CHAIN_MAX_STAGES];
+	volatile uint8_t stageCount = 0;
+	bool bp = false;
+};
+
+#endif // _EFFECT_CHAIN_F32_H_
@@ -0,0 +1,166 @@
+/*  Stereo 3/4 band compressor for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "effect_compressorMultibandStereo_F32.h"
+
+// default crossovers, 3 bands: bass / mid / high, 4 bands: low mid split
+static const float32_t xover_default_3b[2] = {250.0f, 2500.0f};
+static const float32_t xover_default_4b[3] = {150.0f, 800.0f, 4000.0f};
+
+void AudioEffectCompressorMultibandStereo_F32::begin(uint8_t bands)
+{
+	const float32_t *f;
+	bands = constrain(bands, 3, COMPRESSOR_MB_MAX_BANDS);
+	__disable_irq();
+	bandNo = bands;
+	__enable_irq();
+	f = bandNo == 3 ? xover_default_3b : xover_default_4b;
+	for (uint8_t i = 0; i < bandNo - 1; i++)
+	{
+		crossover(i, f[i]);
+		xover[i].reset();
+	}
+	for (uint8_t i = 0; i < COMPRESSOR_MB_MAX_BANDS; i++)
+	{
+		bnd[i].thr_dB = -20.0f;
+		bnd[i].ratio_k = 1.0f / 4.0f;
+		bnd[i].attack_sec = 0.01f;
+		bnd[i].release_sec = 0.2f;
+		bnd[i].makeup = 1.0f;
+		bnd[i].det.level_lp_pow = 0.0f;
+		bnd[i].det.gain_dB = 0.0f;
+		bnd[i].cycles = 0;
+		bnd[i].cyclesMax = 0;
+		band_timeConst(i);
+	}
+	// low band reacts slower, avoids modulating the low notes within the wave period
+	bnd[0].attack_sec = 0.03f;
+	bnd[0].release_sec = 0.3f;
+	band_timeConst(0);
+}
+
+void AudioEffectCompressorMultibandStereo_F32::band_timeConst(uint8_t band)
+{
+	band_t *b = &bnd[band];
+	float32_t lvl_sec = max(min(b->attack_sec, b->release_sec) / 5.0f, 0.002f);
+	float32_t att = expf(-1.0f / (b->attack_sec * fs));
+	float32_t rel = expf(-1.0f / (b->release_sec * fs));
+	float32_t lvl = expf(-1.0f / (lvl_sec * fs));
+	__disable_irq();
+	b->att_k = att;
+	b->rel_k = rel;
+	b->lvl_k = lvl;
+	__enable_irq();
+}
+
+void AudioEffectCompressorMultibandStereo_F32::update()
+{
+	audio_block_f32_t *blockL, *blockR;
+	if (bpx.passThrough()) // fully bypassed, pass the read only blocks
+	{
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!blockL || !blockR)
+	{
+		if (blockL) AudioStream_F32::release(blockL);
+		if (blockR)	AudioStream_F32::release(blockR);
+		return;
+	}
+	process(blockL->data, blockR->data, blockL->length);
+	AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+}
+
+/**
+ * @brief split -> per band compressor -> phase aligned sum, in place
+ * 		band k = LP(k) of the HP(k-1) output, the top band stays in dataL/R
+ * 		sum: acc = band0, acc = AP(k)(acc) + band k, the allpass of each crossover is
+ * 		applied to all the bands below it, which did not pass through that crossover
+ */
+void AudioEffectCompressorMultibandStereo_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+	AudioBasicDenormalGuard ftz;
+	uint32_t t0, t;
+	uint8_t i, top;
+	band_t *b;
+
+	if (bpx.passThrough()) return;
+	bpx.storeDry(dataL, dataR, len);	// only during the bypass crossfade
+	top = bandNo - 1;
+	for (i = 0; i < bandNo; i++)
+	{
+		b = &bnd[i];
+		t0 = ARM_DWT_CYCCNT;
+		if (i < top)
+		{
+			xover[i].split(dataL, dataR, bufL[i], bufR[i], dataL, dataR, len);
+			compress(bufL[i], bufR[i], len, b);
+		}
+		else compress(dataL, dataR, len, b);
+		t = (ARM_DWT_CYCCNT - t0) >> 6;	// same scale as the cpu_cycles of the audio library
+		b->cycles = t;
+		if (t > b->cyclesMax) b->cyclesMax = t;
+	}
+	// phase aligned sum, the top band went through all the crossovers
+	for (i = 1; i < top; i++)
+	{
+		xover[i].allpass(bufL[0], bufR[0], len);
+		arm_add_f32(bufL[0], bufL[i], bufL[0], len);
+		arm_add_f32(bufR[0], bufR[i], bufR[0], len);
+	}
+	arm_add_f32(dataL, bufL[0], dataL, len);
+	arm_add_f32(dataR, bufR[0], dataR, len);
+	bpx.process(dataL, dataR, len);
+}
+
+/**
+ * @brief linked stereo compressor, single pass
+ * 		detector (L+R)/2 RMS -> gain computer -> attack/release -> gain and makeup
+ */
+void AudioEffectCompressorMultibandStereo_F32::compress(float32_t *dataL, float32_t *dataR, uint32_t len, band_t *b)
+{
+	AudioBasicDynamics dyn(&b->det, b->lvl_k, b->thr_dB, b->ratio_k, b->att_k, b->rel_k);
+	const float32_t makeup = b->makeup;
+	float32_t gain;
+
+	for (uint32_t i = 0; i < len; i++)
+	{
+		gain = dyn.gain((dataL[i] + dataR[i]) * 0.5f) * makeup;
+		dataL[i] *= gain;
+		dataR[i] *= gain;
+	}
+	dyn.store(&b->det);
+}
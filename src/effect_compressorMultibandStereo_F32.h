@@ -0,0 +1,170 @@
+/*  Stereo 3/4 band compressor for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _EFFECT_COMPRESSORMULTIBANDSTEREO_F32_H_
+#define _EFFECT_COMPRESSORMULTIBANDSTEREO_F32_H_
+
+#include <Arduino.h>
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "basic_DSPutils.h"
+#include "basic_fastMath.h"
+#include "basic_crossover.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
+#include "basic_dynamics.h"
+
+#define COMPRESSOR_MB_MAX_BANDS		(4)
+
+/**
+ * @brief Stereo multiband compressor
+ * 		The signal is split with LR4 crossovers into 3 or 4 bands, each band has its own
+ * 		compressor (linked stereo RMS detector, threshold, ratio, attack, release, makeup).
+ * 		The bands are summed back with the crossover allpasses applied to the lower bands,
+ * 		with all bands at 0dB gain the output is an allpass filtered copy of the input,
+ * 		flat magnitude response.
+ * 		No audio blocks are allocated, the bands use member buffers.
+ * 		Per band CPU load (split + compressor) is measured with the cycle counter.
+ */
+class AudioEffectCompressorMultibandStereo_F32 : public AudioStream_F32, public AudioEffectKernel_F32
+{
+public:
+	AudioEffectCompressorMultibandStereo_F32(uint8_t bands=3) : AudioStream_F32(2, inputQueueArray_f32) { begin(bands); }
+	AudioEffectCompressorMultibandStereo_F32(const AudioSettings_F32 &settings, uint8_t bands=3) : AudioStream_F32(2, inputQueueArray_f32)
+	{
+		fs = settings.sample_rate_Hz;
+		begin(bands);
+	}
+	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
+	/**
+	 * @brief number of bands, 3 or 4, resets the crossovers and band settings to defaults
+	 */
+	void begin(uint8_t bands);
+	uint8_t bands_get() { return bandNo; }
+	/**
+	 * @brief crossover frequency
+	 *
+	 * @param idx 	crossover index, 0 = lowest, keep the frequencies ascending
+	 * @param f 	frequency in Hz
+	 */
+	void crossover(uint8_t idx, float32_t f)
+	{
+		if (idx >= bandNo - 1) return;
+		f = constrain(f, 20.0f, fs * 0.45f);
+		xover[idx].freq(f, fs);
+		xover_f[idx] = f;
+	}
+	float32_t crossover_get(uint8_t idx) { return idx < bandNo - 1 ? xover_f[idx] : 0.0f; }
+	/**
+	 * @brief compression threshold in dBFS
+	 */
+	void threshold(uint8_t band, float32_t dB)
+	{
+		if (band >= bandNo) return;
+		band_t *b = &bnd[band];
+		b->thr_dB = dB;
+	}
+	/**
+	 * @brief compression ratio, 1.0 = no compression
+	 */
+	void ratio(uint8_t band, float32_t r)
+	{
+		if (band >= bandNo) return;
+		r = max(r, 1.0f);
+		bnd[band].ratio_k = 1.0f / r;
+	}
+	void attack(uint8_t band, float32_t sec)
+	{
+		if (band >= bandNo) return;
+		bnd[band].attack_sec = max(sec, 0.0001f);
+		band_timeConst(band);
+	}
+	void release(uint8_t band, float32_t sec)
+	{
+		if (band >= bandNo) return;
+		bnd[band].release_sec = max(sec, 0.001f);
+		band_timeConst(band);
+	}
+	/**
+	 * @brief band output gain
+	 */
+	void makeup(uint8_t band, float32_t dB)
+	{
+		if (band >= bandNo) return;
+		bnd[band].makeup = fast_dB2lin(dB);
+	}
+	/**
+	 * @brief current gain reduction of the band in dB (<= 0)
+	 */
+	float32_t gain_reduction_dB(uint8_t band) { return band < bandNo ? bnd[band].det.gain_dB : 0.0f; }
+	/**
+	 * @brief CPU load of the band in the last update, same scale as processorUsage()
+	 */
+	float32_t band_usage(uint8_t band) { return band < bandNo ? CYCLE_COUNTER_APPROX_PERCENT(bnd[band].cycles) : 0.0f; }
+	float32_t band_usageMax(uint8_t band) { return band < bandNo ? CYCLE_COUNTER_APPROX_PERCENT(bnd[band].cyclesMax) : 0.0f; }
+	void band_usageMaxReset()
+	{
+		__disable_irq();
+		for (uint8_t i = 0; i < COMPRESSOR_MB_MAX_BANDS; i++) bnd[i].cyclesMax = 0;
+		__enable_irq();
+	}
+	bool bypass_get(void) {return bpx.get();}
+	void bypass_set(bool state) {bpx.set(state);}
+	bool bypass_tgl(void) {return bpx.tgl();}
+	/**
+	 * @brief bypass crossfade length in audio blocks
+	 */
+	void bypass_setFade(uint16_t blocks) {bpx.setFadeBlocks(blocks);}
+private:
+	audio_block_f32_t *inputQueueArray_f32[2];
+	typedef struct
+	{
+		float32_t thr_dB;			// threshold
+		float32_t ratio_k;			// 1/ratio
+		float32_t attack_sec;
+		float32_t release_sec;
+		float32_t att_k;			// gain smoothing coeffs
+		float32_t rel_k;
+		float32_t lvl_k;			// level detector coeff
+		float32_t makeup;			// linear output gain
+		dynamics_detector_t det;	// detector and smoother state
+		uint32_t cycles;			// cycles/64 used in the last update, as AudioStream::cpu_cycles
+		uint32_t cyclesMax;
+	}band_t;
+	band_t bnd[COMPRESSOR_MB_MAX_BANDS];
+	AudioBasicCrossoverLR4 xover[COMPRESSOR_MB_MAX_BANDS - 1];
+	float32_t xover_f[COMPRESSOR_MB_MAX_BANDS - 1];
+	// lower bands, the top band is processed in the input buffers
+	float32_t bufL[COMPRESSOR_MB_MAX_BANDS - 1][AUDIO_BLOCK_SAMPLES];
+	float32_t bufR[COMPRESSOR_MB_MAX_BANDS - 1][AUDIO_BLOCK_SAMPLES];
+	uint8_t bandNo = 3;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
+	AudioBasicBypassXfade bpx;	// crossfading bypass, starts bypassed
+	void band_timeConst(uint8_t band);
+	void compress(float32_t *dataL, float32_t *dataR, uint32_t len, band_t *b);
+};
+
+#endif // _EFFECT_COMPRESSORMULTIBANDSTEREO_F32_H_
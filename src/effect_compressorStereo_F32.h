@@ -19,6 +19,11 @@
 #include <arm_math.h> //ARM DSP extensions.  https://www.keil.com/pack/doc/CMSIS/DSP/html/index.html
 #include <AudioStream_F32.h>
 #include "basic_DSPutils.h"
+#include "basic_fastMath.h"
+#include "basic_memArena.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
+#include "basic_dynamics.h"
 
 // ranges used for normalized parameters. 
 // input is 0.0f to 1.0f, output RANGE_MIN to RANGE_MAX
@@ -34,9 +39,10 @@
 #define COMPRESSOR_THRES_RANGE_MAX		(-40.0f)
 #define COMPRESSOR_RATIO_RANGE_MIN		(0.0f)
 #define COMPRESSOR_RATIO_RANGE_MAX		(10.0f)
+#define COMPRESSOR_LOOKAHEAD_MAX_MS		(5.0f)
 
 
-class AudioEffectCompressorStereo_F32 : public AudioStream_F32
+class AudioEffectCompressorStereo_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 	// GUI: inputs:1, outputs:1  //this line used for automatic generation of GUI node
 public:
@@ -75,16 +81,11 @@ public:
 	void update(void)
 	{
 		audio_block_f32_t *blockL, *blockR;
-		if (bp) // handle bypass
+		if (bpx.passThrough()) // fully bypassed, pass the read only blocks
 		{
 			blockL = AudioStream_F32::receiveReadOnly_f32(0);
 			blockR = AudioStream_F32::receiveReadOnly_f32(1);
-			if (!blockL || !blockR)
-			{
-				if (blockL) AudioStream_F32::release(blockL);
-				if (blockR) AudioStream_F32::release(blockR);
-				return;
-			}
+			bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
 			AudioStream_F32::transmit(blockL, 0);
 			AudioStream_F32::transmit(blockR, 1);
 			AudioStream_F32::release(blockL);
@@ -99,199 +100,53 @@ public:
 			if (blockR)	AudioStream_F32::release(blockR);
 			return;
 		}
-		// allocate blocks required for gain calculations
-		audio_block_f32_t* audio_level_dB_blockL = AudioStream_F32::allocate_f32();
-		audio_block_f32_t* audio_level_dB_blockR = AudioStream_F32::allocate_f32();
-		audio_block_f32_t *gain_blockL = AudioStream_F32::allocate_f32();
-		audio_block_f32_t *gain_blockR = AudioStream_F32::allocate_f32();
-		// no memory for the audio gain blocks
-		if ( !audio_level_dB_blockL || !audio_level_dB_blockR || !gain_blockL || !gain_blockL)
-		{
-			if (audio_level_dB_blockL) AudioStream_F32::release(audio_level_dB_blockL);
-			if (audio_level_dB_blockR) AudioStream_F32::release(audio_level_dB_blockR);
-			if (gain_blockL) AudioStream_F32::release(gain_blockL);
-			if (gain_blockR) AudioStream_F32::release(gain_blockR);
-			AudioStream_F32::release(blockL);
-			AudioStream_F32::release(blockR);
-			return;
-		}
+		process(blockL->data, blockR->data, blockL->length);
+		// transmit the block and release memory
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+	}
+	/**
+	 * @brief in place processing, no audio blocks are allocated
+	 * 		pass 1: DC blocking HP filter
+	 * 		pass 2: pregain, level detector, gain computer, attack/release smoothing,
+	 * 				gain and postgain fused in one loop per sample
+	 */
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len)
+	{
+		AudioBasicDenormalGuard ftz;
+		if (bpx.passThrough()) return;
+		bpx.storeDry(dataL, dataR, len);	// only during the bypass crossfade
 		// apply a high-pass filter to get rid of the DC offset
 		if (use_HP_prefilter)
 		{
-			arm_biquad_cascade_df1_f32(&hp_filt_structL, blockL->data, blockL->data, blockL->length);
-			arm_biquad_cascade_df1_f32(&hp_filt_structR, blockR->data, blockR->data, blockR->length);
+			arm_biquad_cascade_df1_f32(&hp_filt_structL, dataL, dataL, len);
+			arm_biquad_cascade_df1_f32(&hp_filt_structR, dataR, dataR, len);
 		}
-		// apply the pre-gain...a negative gain value will disable
-		if (pre_gain > 0.0f) 
-		{
-			arm_scale_f32(blockL->data, pre_gain, blockL->data, blockL->length); // use ARM DSP for speed!
-			arm_scale_f32(blockR->data, pre_gain, blockR->data, blockR->length); 
-		}			
 		// Side chain processing
 		switch (sidechainMode)
 		{
 			case COMP_SIDECHAIN_SRC_LR:			// l + r separate
-				calcAudioLevel_dB(blockL, audio_level_dB_blockL);
-				calcAudioLevel_dB(blockR, audio_level_dB_blockR);
-				calcGain(audio_level_dB_blockL, gain_blockL);
-				calcGain(audio_level_dB_blockR, gain_blockR);
-				arm_mult_f32(blockL->data, gain_blockL->data, blockL->data, blockL->length);
-				arm_mult_f32(blockR->data, gain_blockR->data, blockR->data, blockR->length);
+				compress(dataL, NULL, len, &detL);
+				compress(dataR, NULL, len, &detR);
 				break;
-			case COMP_SIDECHAIN_SRC_LRSUM:		// l + r sum / 2
-				arm_add_f32(blockL->data, blockR->data, audio_level_dB_blockL->data, audio_level_dB_blockL->length); // L+R -> db_L
-				arm_scale_f32(audio_level_dB_blockL->data, 0.5f, audio_level_dB_blockL->data, audio_level_dB_blockL->length); // L+R / 2
-				calcAudioLevel_dB(audio_level_dB_blockL, audio_level_dB_blockL); // chn L used for L&R
-				calcGain(audio_level_dB_blockL, gain_blockL);
-				arm_mult_f32(blockL->data, gain_blockL->data, blockL->data, blockL->length);
-				arm_mult_f32(blockR->data, gain_blockL->data, blockR->data, blockR->length);				
+			case COMP_SIDECHAIN_SRC_LRSUM:		// l + r sum / 2, chn L detector used for L&R
+				compress(dataL, dataR, len, &detL);
 				break;
 			default:
 				break;
 		}
-		if (post_gain > 0.0f) 
-		{
-			arm_scale_f32(blockL->data, post_gain, blockL->data, blockL->length); // use ARM DSP for speed!
-			arm_scale_f32(blockR->data, post_gain, blockR->data, blockR->length); 
-		}	
-		// transmit the block and release memory
-		AudioStream_F32::transmit(blockL, 0);
-		AudioStream_F32::transmit(blockR, 1);
-		AudioStream_F32::release(blockL);
-		AudioStream_F32::release(blockR);		
-		AudioStream_F32::release(gain_blockL);
-		AudioStream_F32::release(gain_blockR);
-		AudioStream_F32::release(audio_level_dB_blockL);
-		AudioStream_F32::release(audio_level_dB_blockR);
-	}
-
-	// Here's the method that estimates the level of the audio (in dB)
-	// It squares the signal and low-pass filters to get a time-averaged
-	// signal power.  It then
-	void calcAudioLevel_dB(audio_block_f32_t *wav_block, audio_block_f32_t *level_dB_block)
-	{
-		// calculate the instantaneous signal power (square the signal)
-		audio_block_f32_t *wav_pow_block = AudioStream_F32::allocate_f32();
-		arm_mult_f32(wav_block->data, wav_block->data, wav_pow_block->data, wav_block->length);
-
-		// low-pass filter and convert to dB
-		float c1 = level_lp_const, c2 = 1.0f - c1; // prepare constants
-		for (int i = 0; i < wav_pow_block->length; i++)
-		{
-			// first-order low-pass filter to get a running estimate of the average power
-			wav_pow_block->data[i] = c1 * prev_level_lp_pow + c2 * wav_pow_block->data[i];
-
-			// save the state of the first-order low-pass filter
-			prev_level_lp_pow = wav_pow_block->data[i];
-
-			// now convert the signal power to dB (but not yet multiplied by 10.0)
-			level_dB_block->data[i] = log10f_approx(wav_pow_block->data[i]);
-		}
-
-		// limit the amount that the state of the smoothing filter can go toward negative infinity
-		if (prev_level_lp_pow < (1.0E-13))
-			prev_level_lp_pow = 1.0E-13; // never go less than -130 dBFS
-
-		// scale the wav_pow_block by 10.0 to complete the conversion to dB
-		arm_scale_f32(level_dB_block->data, 10.0f, level_dB_block->data, level_dB_block->length); // use ARM DSP for speed!
-
-		// release memory and return
-		AudioStream_F32::release(wav_pow_block);
-		return; // output is passed through level_dB_block
-	}
-
-	// This method computes the desired gain from the compressor, given an estimate
-	// of the signal level (in dB)
-	void calcGain(audio_block_f32_t *audio_level_dB_block, audio_block_f32_t *gain_block)
-	{
-		// first, calculate the instantaneous target gain based on the compression ratio
-		audio_block_f32_t *inst_targ_gain_dB_block = AudioStream_F32::allocate_f32();
-		calcInstantaneousTargetGain(audio_level_dB_block, inst_targ_gain_dB_block);
-
-		// second, smooth in time (attack and release) by stepping through each sample
-		audio_block_f32_t *gain_dB_block = AudioStream_F32::allocate_f32();
-		calcSmoothedGain_dB(inst_targ_gain_dB_block, gain_dB_block);
-
-		// finally, convert from dB to linear gain: gain = 10^(gain_dB/20);  (ie this takes care of the sqrt, too!)
-		arm_scale_f32(gain_dB_block->data, 1.0f / 20.0f, gain_dB_block->data, gain_dB_block->length); // divide by 20
-		for (int i = 0; i < gain_dB_block->length; i++)
-			gain_block->data[i] = pow10f(gain_dB_block->data[i]); // do the 10^(x)
-
-		// release memory and return
-		AudioStream_F32::release(gain_dB_block);
-		AudioStream_F32::release(inst_targ_gain_dB_block);
-		return; // output is passed through gain_block
-	}
-
-	// Compute the instantaneous desired gain, including the compression ratio and
-	// threshold for where the comrpession kicks in
-	void calcInstantaneousTargetGain(audio_block_f32_t *audio_level_dB_block, audio_block_f32_t *inst_targ_gain_dB_block)
-	{
-		// how much are we above the compression threshold?
-		audio_block_f32_t *above_thresh_dB_block = AudioStream_F32::allocate_f32();
-		arm_offset_f32(audio_level_dB_block->data,	// CMSIS DSP for "add a constant value to all elements"
-					   -thresh_dBFS,				// this is the value to be added
-					   above_thresh_dB_block->data, // this is the output
-					   audio_level_dB_block->length);
-
-		// scale by the compression ratio...this is what the output level should be (this is our target level)
-		arm_scale_f32(above_thresh_dB_block->data,	 // CMSIS DSP for "multiply all elements by a constant value"
-					  1.0f / comp_ratio,			 // this is the value to be multiplied
-					  inst_targ_gain_dB_block->data, // this is the output
-					  above_thresh_dB_block->length);
-
-		// compute the instantaneous gain...which is the difference between the target level and the original level
-		arm_sub_f32(inst_targ_gain_dB_block->data, // CMSIS DSP for "subtract two vectors element-by-element"
-					above_thresh_dB_block->data,   // this is the vector to be subtracted
-					inst_targ_gain_dB_block->data, // this is the output
-					inst_targ_gain_dB_block->length);
-
-		// limit the target gain to attenuation only (this part of the compressor should not make things louder!)
-		for (int i = 0; i < inst_targ_gain_dB_block->length; i++)
-		{
-			if (inst_targ_gain_dB_block->data[i] > 0.0f)
-				inst_targ_gain_dB_block->data[i] = 0.0f;
-		}
-
-		// release memory before returning
-		AudioStream_F32::release(above_thresh_dB_block);
-		return; // output is passed through inst_targ_gain_dB_block
-	}
-
-	// this method applies the "attack" and "release" constants to smooth the
-	// target gain level through time.
-	void calcSmoothedGain_dB(audio_block_f32_t *inst_targ_gain_dB_block, audio_block_f32_t *gain_dB_block)
-	{
-		float32_t gain_dB;
-		float32_t one_minus_attack_const = 1.0f - attack_const;
-		float32_t one_minus_release_const = 1.0f - release_const;
-		for (int i = 0; i < inst_targ_gain_dB_block->length; i++)
-		{
-			gain_dB = inst_targ_gain_dB_block->data[i];
-
-			// smooth the gain using the attack or release constants
-			if (gain_dB < prev_gain_dB)
-			{ // are we in the attack phase?
-				gain_dB_block->data[i] = attack_const * prev_gain_dB + one_minus_attack_const * gain_dB;
-			}
-			else
-			{ // or, we're in the release phase
-				gain_dB_block->data[i] = release_const * prev_gain_dB + one_minus_release_const * gain_dB;
-			}
-
-			// save value for the next time through this loop
-			prev_gain_dB = gain_dB_block->data[i];
-		}
-
-		// return
-		return; // the output here is gain_block
+		bpx.process(dataL, dataR, len);
 	}
 
 	// methods to set parameters of this module
 	void resetStates(void)
 	{
-		prev_level_lp_pow = 1.0f;
-		prev_gain_dB = 0.0f;
+		detL.dyn.level_lp_pow = detR.dyn.level_lp_pow = 1.0f;
+		detL.dyn.gain_dB = detR.dyn.gain_dB = 0.0f;
+		lookahead_reset(&detL.la);
+		lookahead_reset(&detR.la);
 
 		// initialize the HP filter.  (This also resets the filter states,)
 		arm_biquad_cascade_df1_init_f32(&hp_filt_structL, hp_nstages, hp_coeff, hp_stateL);
@@ -360,14 +215,14 @@ public:
 	void enableHPFilter(boolean flag) { use_HP_prefilter = flag; };
 
 	// methods to return information about this module
-	float32_t getPreGain_dB(void) { return 20.0 * log10f_approx(pre_gain); }
+	float32_t getPreGain_dB(void) { return fast_lin2dB(pre_gain); }
 	float32_t getAttack_sec(void) { return attack_sec; }
 	float32_t getRelease_sec(void) { return release_sec; }
 	float32_t getLevelTimeConst_sec(void) { return level_lp_sec; }
 	float32_t getThresh_dBFS(void) { return thresh_dBFS; }
 	float32_t getCompressionRatio(void) { return comp_ratio; }
-	float32_t getCurrentLevel_dBFS(void) { return 10.0 * log10f_approx(prev_level_lp_pow); }
-	float32_t getCurrentGain_dB(void) { return prev_gain_dB; }
+	float32_t getCurrentLevel_dBFS(void) { return fast_pow2dB(detL.dyn.level_lp_pow); }
+	float32_t getCurrentGain_dB(void) { return detL.dyn.gain_dB; }
 
 	void setHPFilterCoeff_N2IIR_Matlab(float32_t b[], float32_t a[])
 	{
@@ -379,21 +234,253 @@ public:
 		hp_coeff[3] = -a[1];
 		hp_coeff[4] = -a[2]; // the DSP needs the "a" terms to have opposite sign vs Matlab
 	}
-    bool bypass_get(void) {return bp;}
-    void bypass_set(bool state) {bp = state;}
-    bool bypass_tgl(void) 
-    {
-        bp ^= 1; 
-        return bp;
-    }
+    bool bypass_get(void) {return bpx.get();}
+    void bypass_set(bool state) {bpx.set(state);}
+    bool bypass_tgl(void) {return bpx.tgl();}
+    /**
+     * @brief bypass crossfade length in audio blocks
+     */
+    void bypass_setFade(uint16_t blocks) {bpx.setFadeBlocks(blocks);}
 	void setSideChainMode(sideChainMode_t newMode) {sidechainMode = newMode;}
+	/**
+	 * @brief lookahead time, the output is delayed by the same amount
+	 * 		With the lookahead on the detector uses the peak over the lookahead window
+	 * 		instead of the RMS level. Together with setCeiling_dBFS, a high ratio,
+	 * 		the threshold at the ceiling and the attack time around 1/3 of the lookahead
+	 * 		the compressor works as a transparent brickwall limiter.
+	 * 		The delay lines are allocated on the first use.
+	 * 
+	 * @param ms lookahead time 0.0 (off) to COMPRESSOR_LOOKAHEAD_MAX_MS
+	 * @return false if there is no memory for the delay lines
+	 */
+	bool setLookahead_ms(float32_t ms)
+	{
+		ms = constrain(ms, 0.0f, COMPRESSOR_LOOKAHEAD_MAX_MS);
+		uint32_t samples = (uint32_t)(ms * 0.001f * fs_Hz + 0.5f);
+		if (samples && !detL.la.q)
+		{
+			// power of 2 size covering the maximum window
+			uint32_t sz = 2;
+			while (sz < (uint32_t)(COMPRESSOR_LOOKAHEAD_MAX_MS * 0.001f * fs_Hz) + 2) sz <<= 1;
+			AudioBasicMemArenaOwner memOwner(this, "Compressor");
+			float32_t *dly = (float32_t *)AudioBasicMemArena::alloc(sz * 4 * sizeof(float32_t), ARENA_RAM1);
+			peak_entry_t *q = (peak_entry_t *)AudioBasicMemArena::alloc(sz * 2 * sizeof(peak_entry_t), ARENA_RAM1);
+			if (!dly || !q)
+			{
+				AudioBasicMemArena::free(dly);
+				AudioBasicMemArena::free(q);
+				return false;
+			}
+			__disable_irq();
+			la_mask = sz - 1;
+			detL.la.dlyL = dly;
+			detL.la.dlyR = dly + sz;
+			detR.la.dlyL = dly + 2 * sz;
+			detR.la.dlyR = dly + 3 * sz;
+			detL.la.q = q;
+			detR.la.q = q + sz;
+			__enable_irq();
+		}
+		__disable_irq();
+		if (samples && samples != la_samples)
+		{
+			// new delay length, clear the old audio and the stale peaks
+			lookahead_reset(&detL.la);
+			lookahead_reset(&detR.la);
+		}
+		la_samples = samples;
+		la_ms = ms;
+		__enable_irq();
+		return true;
+	}
+	float32_t getLookahead_ms(void) { return la_ms; }
+	/**
+	 * @brief allocate the lookahead buffers again, ie. after the memory arena was released
+	 */
+	bool mem_realloc()
+	{
+		__disable_irq();
+		la_samples = 0;
+		AudioBasicMemArena::free(detL.la.dlyL);
+		AudioBasicMemArena::free(detL.la.q);
+		detL.la.q = detR.la.q = NULL;
+		detL.la.dlyL = detL.la.dlyR = detR.la.dlyL = detR.la.dlyR = NULL;
+		__enable_irq();
+		return setLookahead_ms(la_ms);
+	}
+	/**
+	 * @brief output ceiling, peaks above are clipped.
+	 * 		In the lookahead mode the gain is reduced to keep the peaks under the ceiling
+	 * 
+	 * @param g ceiling, linear, negative value disables
+	 */
+	void setCeiling(float32_t g) { ceiling = g; }
+	void setCeiling_dBFS(float32_t dB) { setCeiling(fast_dB2lin(dB)); }
 private:
 	// state-related variables
 	audio_block_f32_t *inputQueueArray_f32[2]; // memory pointer for the input to this module
-	float32_t prev_level_lp_pow = 1.0f;
-	float32_t prev_gain_dB = 0.0f; // last gain^2 used
+	typedef struct
+	{
+		float32_t val;
+		uint32_t n;					// sample index
+	}peak_entry_t;
+	typedef struct
+	{
+		float32_t *dlyL;			// lookahead delay lines
+		float32_t *dlyR;
+		peak_entry_t *q;			// running peak deque, decreasing values
+		uint32_t head, tail;
+		uint32_t n;					// sample counter
+		uint32_t idx;				// delay write index
+	}lookahead_t;
+	typedef struct
+	{
+		dynamics_detector_t dyn;	// level detector and gain smoother state
+		lookahead_t la;
+	}detector_t;
+	detector_t detL = {{1.0f, 0.0f}, {}};
+	detector_t detR = {{1.0f, 0.0f}, {}};
+	uint32_t la_samples = 0;		// lookahead delay, 0 = off
+	uint32_t la_mask = 0;			// buffer size - 1
+	float32_t la_ms = 0.0f;
+	float32_t ceiling = -1.0f;		// output ceiling, negative value disables
+	void lookahead_reset(lookahead_t *la)
+	{
+		la->head = la->tail = la->n = la->idx = 0;
+		if (la->dlyL) memset(la->dlyL, 0, (la_mask + 1) * sizeof(float32_t));
+		if (la->dlyR) memset(la->dlyR, 0, (la_mask + 1) * sizeof(float32_t));
+	}
+	/**
+	 * @brief lookahead version of compress()
+	 * 		The side chain peak over the lookahead window is found with a monotonic
+	 * 		deque: each sample is pushed and popped once, O(1) per sample independent
+	 * 		of the window length. The audio is delayed by the window length, so the
+	 * 		gain reduction starts before the peak reaches the output.
+	 * 		Stereo side chain uses max(|L|,|R|), a sum would miss the out of phase peaks.
+	 */
+	void compress_la(float32_t *dataL, float32_t *dataR, uint32_t len, detector_t *det)
+	{
+		lookahead_t *la = &det->la;
+		const uint32_t mask = la_mask;
+		const uint32_t D = la_samples;
+		AudioBasicDynamics dyn(&det->dyn, level_lp_const, thresh_dBFS, 1.0f / comp_ratio, attack_const, release_const);
+		const float32_t preG = pre_gain, postG = post_gain;
+		const float32_t ceil = ceiling;
+		// ceiling referred to the signal before the postgain
+		const float32_t ceil_dB = ceil > 0.0f ? fast_lin2dB(ceil) - (postG > 0.0f ? fast_lin2dB(postG) : 0.0f) : 1000.0f;
+		peak_entry_t *q = la->q;
+		uint32_t head = la->head, tail = la->tail, n = la->n, idx = la->idx;
+		float32_t l, r = 0.0f, sc, peak = 0.0f, level_dB, targ_dB, gain;
+
+		for (uint32_t i = 0; i < len; i++)
+		{
+			l = dataL[i];
+			if (dataR) r = dataR[i];
+			if (preG > 0.0f)
+			{
+				l *= preG;
+				r *= preG;
+			}
+			sc = fabsf(l);
+			if (dataR && fabsf(r) > sc) sc = fabsf(r);
+			// running peak: drop the smaller values from the back, expired ones from the front
+			while (tail != head && q[(tail - 1) & mask].val <= sc) tail--;
+			q[tail & mask].val = sc;
+			q[tail & mask].n = n;
+			tail++;
+			while (n - q[head & mask].n > D) head++;
+			peak = q[head & mask].val;
+			n++;
+			// delay the audio by the window length
+			la->dlyL[idx] = l;
+			l = la->dlyL[(idx - D) & mask];
+			if (dataR)
+			{
+				la->dlyR[idx] = r;
+				r = la->dlyR[(idx - D) & mask];
+			}
+			idx = (idx + 1) & mask;
+			// gain computer
+			level_dB = fast_lin2dB(peak);
+			targ_dB = dyn.target_dB(level_dB);
+			if (targ_dB > ceil_dB - level_dB) targ_dB = ceil_dB - level_dB;	// brickwall
+			gain = fast_dB2lin(dyn.smooth_dB(targ_dB));
+			l *= gain;
+			r *= gain;
+			if (postG > 0.0f)
+			{
+				l *= postG;
+				r *= postG;
+			}
+			// residual overshoot if the attack is slower than the lookahead
+			if (ceil > 0.0f)
+			{
+				l = constrain(l, -ceil, ceil);
+				r = constrain(r, -ceil, ceil);
+			}
+			dataL[i] = l;
+			if (dataR) dataR[i] = r;
+		}
+		la->head = head;
+		la->tail = tail;
+		la->n = n;
+		la->idx = idx;
+		dyn.store(&det->dyn);
+		det->dyn.level_lp_pow = peak * peak;
+	}
+	/**
+	 * @brief level detector -> gain computer -> smoother -> gain, single pass
+	 * 
+	 * @param dataL first channel, also the side chain input if dataR == NULL
+	 * @param dataR second channel, NULL for a single channel,
+	 * 			otherwise the side chain is (L+R)/2 and the gain is applied to both channels
+	 * @param len 	block length
+	 * @param det 	detector state
+	 */
+	void compress(float32_t *dataL, float32_t *dataR, uint32_t len, detector_t *det)
+	{
+		if (la_samples)
+		{
+			compress_la(dataL, dataR, len, det);
+			return;
+		}
+		AudioBasicDynamics dyn(&det->dyn, level_lp_const, thresh_dBFS, 1.0f / comp_ratio, attack_const, release_const);
+		const float32_t preG = pre_gain, postG = post_gain;
+		const float32_t ceil = ceiling;
+		float32_t l, r = 0.0f, sc, gain;
+
+		for (uint32_t i = 0; i < len; i++)
+		{
+			// apply the pre-gain...a negative gain value will disable
+			l = dataL[i];
+			if (dataR) r = dataR[i];
+			if (preG > 0.0f)
+			{
+				l *= preG;
+				r *= preG;
+			}
+			sc = dataR ? (l + r) * 0.5f : l;
+			// RMS detector -> gain computer -> attack/release -> linear gain
+			gain = dyn.gain(sc);
+			l *= gain;
+			r *= gain;
+			if (postG > 0.0f)
+			{
+				l *= postG;
+				r *= postG;
+			}
+			if (ceil > 0.0f)
+			{
+				l = constrain(l, -ceil, ceil);
+				r = constrain(r, -ceil, ceil);
+			}
+			dataL[i] = l;
+			if (dataR) dataR[i] = r;
+		}
+		dyn.store(&det->dyn);
+	}
 	float32_t fs_Hz = AUDIO_SAMPLE_RATE_EXACT;
-	bool bp = true; // bypass flag
+	AudioBasicBypassXfade bpx;	// crossfading bypass, starts bypassed
 	sideChainMode_t sidechainMode = COMP_SIDECHAIN_SRC_LRSUM;
 	// HP filter state-related variables
 	arm_biquad_casd_df1_inst_f32 hp_filt_structL;
@@ -433,56 +520,6 @@ private:
 	float32_t pre_gain = -1.0f;	// gain to apply before the compression.  negative value disables
 	float32_t post_gain = -1.0f;
 	boolean use_HP_prefilter;
-
-	// Accelerate the powf(10.0,x) function
-	static float32_t pow10f(float x)
-	{
-		// return powf(10.0f,x)   //standard, but slower
-		return expf(2.302585092994f * x); // faster:  exp(log(10.0f)*x)
-	}
-
-	// Accelerate the log10f(x)  function?
-	static float32_t log10f_approx(float x)
-	{
-		// return log10f(x);   //standard, but slower
-		return log2f_approx(x) * 0.3010299956639812f; // faster:  log2(x)/log2(10)
-	}
-
-	/* ----------------------------------------------------------------------
-	** Fast approximation to the log2() function.  It uses a two step
-	** process.  First, it decomposes the floating-point number into
-	** a fractional component F and an exponent E.  The fraction component
-	** is used in a polynomial approximation and then the exponent added
-	** to the result.  A 3rd order polynomial is used and the result
-	** when computing db20() is accurate to 7.984884e-003 dB.
-	** ------------------------------------------------------------------- */
-	// https://community.arm.com/tools/f/discussions/4292/cmsis-dsp-new-functionality-proposal/22621#22621
-	// float log2f_approx_coeff[4] = {1.23149591368684f, -4.11852516267426f, 6.02197014179219f, -3.13396450166353f};
-	static float log2f_approx(float X)
-	{
-		// float *C = &log2f_approx_coeff[0];
-		float Y;
-		float F;
-		int E;
-
-		// This is the approximation to log2()
-		F = frexpf(fabsf(X), &E);
-		//  Y = C[0]*F*F*F + C[1]*F*F + C[2]*F + C[3] + E;
-		// Y = *C++;
-		Y = 1.23149591368684f;
-		Y *= F;
-		// Y += (*C++);
-		Y += -4.11852516267426f;
-		Y *= F;
-		// Y += (*C++);
-		Y += 6.02197014179219f;
-		Y *= F;
-		// Y += (*C++);
-		Y += -3.13396450166353f;
-		Y += E;
-
-		return (Y);
-	}
 };
 
 #endif
@@ -31,174 +31,228 @@
 
 extern uint8_t external_psram_size;
 
-AudioEffectDelayStereo_F32::AudioEffectDelayStereo_F32(uint32_t dly_range_ms, bool use_psram) : AudioStream_F32(2, inputQueueArray)
+AudioEffectDelayStereo_F32::AudioEffectDelayStereo_F32(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage) : AudioStream_F32(2, inputQueueArray)
 {
-	begin(dly_range_ms, use_psram);
+	begin(dly_range_ms, use_psram, storage);
 }
 
-void AudioEffectDelayStereo_F32::begin(uint32_t dly_range_ms, bool use_psram)
+AudioEffectDelayStereo_F32::AudioEffectDelayStereo_F32(const AudioSettings_F32 &settings, uint32_t dly_range_ms, bool use_psram, delay_storage_t storage) : AudioStream_F32(2, inputQueueArray)
 {
+	fs = settings.sample_rate_Hz;
+	begin(dly_range_ms, use_psram, storage);
+}
+
+void AudioEffectDelayStereo_F32::begin(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage)
+{
+	AudioBasicMemArenaOwner memOwner(this, "DelayStereo");
 	initialized = false;
+	cfg_range_ms = dly_range_ms;
+	cfg_psram = use_psram;
+	cfg_storage = storage;
 	// failsafe if psram is required but not found
-	// limit the delay time to 500ms (88200 bytes at 44.1kHz)
+	// limit the delay time to 200ms (4x 35280 bytes at 44.1kHz), 16bit storage fits 400ms into the same memory
+	uint32_t dly_range_max = storage == DELAY_STORAGE_F32 ? 200 : 400;
 	psram_mode = use_psram;
 	#if ARDUINO_TEENSY41
 	if (psram_mode && external_psram_size == 0)
 	{
 		psram_mode = false;
-		if (dly_range_ms > 200) dly_range_ms = 200;
+		if (dly_range_ms > dly_range_max) dly_range_ms = dly_range_max;
 	}	
 	#else
 		psram_mode = false;
-		if (dly_range_ms > 200) dly_range_ms = 200;	
+		if (dly_range_ms > dly_range_max) dly_range_ms = dly_range_max;	
 
 	#endif
 	bool memOk = true;
-	dly_length = ((float32_t)(dly_range_ms)/1000.0f) * AUDIO_SAMPLE_RATE_EXACT;	
-	if (!dly0a.init(dly_length, psram_mode)) memOk = false;
-	if (!dly0b.init(dly_length, psram_mode)) memOk = false;
-	if (!dly1a.init(dly_length, psram_mode)) memOk = false;
-	if (!dly1b.init(dly_length, psram_mode)) memOk = false;
-	flt0L.init(BASS_LOSS_FREQ, &bassCut_k, TREBLE_LOSS_FREQ, &trebleCut_k);
-	flt1L.init(BASS_LOSS_FREQ, &bass_k, TREBLE_LOSS_FREQ, &treble_k);
-	flt0R.init(BASS_LOSS_FREQ, &bassCut_k, TREBLE_LOSS_FREQ, &trebleCut_k);
-	flt1R.init(BASS_LOSS_FREQ, &bass_k, TREBLE_LOSS_FREQ, &treble_k);
+	float32_t fs_k = fs / AUDIO_SAMPLE_RATE_EXACT;
+	dly_length = ((float32_t)(dly_range_ms)/1000.0f) * fs;	
+	// PSRAM has plenty of space for power of 2 sized buffers with mask indexing
+	if (!dly0a.init(dly_length, psram_mode, psram_mode, storage)) memOk = false;
+	if (!dly0b.init(dly_length, psram_mode, psram_mode, storage)) memOk = false;
+	if (!dly1a.init(dly_length, psram_mode, psram_mode, storage)) memOk = false;
+	if (!dly1b.init(dly_length, psram_mode, psram_mode, storage)) memOk = false;
+	// buffer can be longer than the used delay range, shift the read position
+	dly_rd_offset = (float32_t)(dly0a.getSize() - dly_length);
+	float32_t bassLoss = onepole_coeff_fs(BASS_LOSS_FREQ, fs);
+	float32_t trebleLoss = onepole_coeff_fs(TREBLE_LOSS_FREQ, fs);
+	flt0L.init(bassLoss, &bassCut_k, trebleLoss, &trebleCut_k);
+	flt1L.init(bassLoss, &bass_k, trebleLoss, &treble_k);
+	flt0R.init(bassLoss, &bassCut_k, trebleLoss, &trebleCut_k);
+	flt1R.init(bassLoss, &bass_k, trebleLoss, &treble_k);
+	// time based parameters defined at 44.1kHz
+	lfo.setSampleRate(fs);
+	lfo_ampl_max = lfo_ampl_max44k1 * fs_k;
+	dly_time_step = 10.0f * fs_k;
+	tapTempo.init(fs);
+	// the first block ramps from the current modulated tap times
+	for (uint8_t i = 0; i < 4; i++) tap_end[i] = tap_time(i, AUDIO_BLOCK_SAMPLES);
 	mix(0.5f);
 	feedback(0.5f);
+	// delay buffers are cleared in portions in the update() function
+	memCleaner.clear();
+	memCleaner.setBudget(memCleanupStep);
+	memCleaner.add(dly0a, psram_mode);
+	memCleaner.add(dly0b, psram_mode);
+	memCleaner.add(dly1a, psram_mode);
+	memCleaner.add(dly1b, psram_mode);
+	memCleaner.start();
 	cleanup_done = true;
 	if (memOk) initialized = true;
 }
 
+/**
+ * @brief modulated delay time of a tap
+ * 			max. read position is limited, reads must not reach the part of the buffer written in this block
+ */
+float32_t AudioEffectDelayStereo_F32::tap_time(uint8_t t, uint32_t len)
+{
+	static const uint8_t lfo_phase[4] = {BASIC_LFO_PHASE_0, BASIC_LFO_PHASE_60, BASIC_LFO_PHASE_120, BASIC_LFO_PHASE_180};
+	float32_t dly_rd_max = (float32_t)(dly_length - len - 3);
+	float32_t mod_fr;
+	uint32_t mod_int;
+	lfo.get(lfo_phase[t], &mod_int, &mod_fr);
+	float32_t d = dly_time + (float32_t)mod_int + mod_fr;
+	return d > dly_rd_max ? dly_rd_max : d;
+}
+
 void AudioEffectDelayStereo_F32::update()
 {
 	if (!initialized) return;
-	if (!memsetup_done)
-	{
-		memsetup_done = memCleanup();
-		return;		
-	}
-
 	audio_block_f32_t *blockL, *blockR;
-	int i;
-	float32_t acc1, acc2, outL, outR, mod_fr[4];
-	uint32_t mod_int;
-	static float32_t dly_time_flt = 0.0f;
 
+	if (bp && bp_mode != BYPASS_MODE_TRAILS)
+	{
+		// read only blocks are passed through, no audio memory copy or allocation
+		bypass_update();
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, bp_mode);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
 	blockL = AudioStream_F32::receiveWritable_f32(0);
 	blockR = AudioStream_F32::receiveWritable_f32(1);
 	if (!bypass_process(&blockL, &blockR, bp_mode, bp))
 		return;
+	process(blockL->data, blockR->data, blockL->length);
+	AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+}
 
-    if (bp)
-    {
-		// mem cleanup not required in TRAILS mode
-		if (!cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
-		{
-			cleanup_done = memCleanup();
-			tap_active = false;	// reset tap tempo
-			tap_counter = 0;
-		}
-		if (infinite) freeze(false);
-		if (bp_mode != BYPASS_MODE_TRAILS)
-		{
-			AudioStream_F32::transmit(blockL, 0);
-			AudioStream_F32::transmit(blockR, 1);
-			AudioStream_F32::release(blockL);
-			AudioStream_F32::release(blockR);
-			return;
-		}
-		else
-		{
-			inputGainSet = 0.0f;
-			tap_active = false;	// reset tap tempo
-			tap_counter = 0;		
-		}
+/**
+ * @brief bypass housekeeping, buffer cleanup in PASS and OFF modes, input fade out in TRAILS mode
+ */
+void AudioEffectDelayStereo_F32::bypass_update()
+{
+	// mem cleanup not required in TRAILS mode
+	if (!cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
+	{
+		memCleaner.start();	// clear the buffers in portions over the next updates
+		flt0L.reset();
+		flt0R.reset();
+		flt1L.reset();
+		flt1R.reset();
+		cleanup_done = true;
+		tapTempo.reset();
+	}
+	if (infinite) freeze(false);
+	if (bp_mode != BYPASS_MODE_TRAILS)
+	{
+		memCleaner.process();
+	}
+	else
+	{
+		inputGainSet = 0.0f;
+		tapTempo.reset();
 	}
+}
 
-	cleanup_done = false;
+void AudioEffectDelayStereo_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+	AudioBasicDenormalGuard ftz;
+	if (!initialized) return;
 
-	for (i=0; i < blockL->length; i++) 
-    {  
-		inputGain += (inputGainSet - inputGain) * 0.25f;
-		// tap tempo
-		if (tap_active)
-		{
-			if (++tap_counter > tap_counter_max)
-			{
-				tap_active = false;
-				tap_counter = 0;
-			}
-		}
+	uint32_t i;
+	float32_t acc1, acc2, outL, outR;
+	float32_t step;
 
-		if (dly_time < dly_time_set)
-		{
-			dly_time += dly_time_step;
-			if (dly_time > dly_time_set) dly_time = dly_time_set;
-		}
-		if (dly_time > dly_time_set)
-		{
-			dly_time -= dly_time_step;
-			if (dly_time < dly_time_set) dly_time = dly_time_set;
-		}
-		// lowpass the delay time
-		acc1 = dly_time - dly_time_flt;
-		dly_time_flt += acc1 * 0.1f;
-		dly_time = dly_time_flt;
+	if (bp)
+	{
+		bypass_update();
+		if (bp_mode == BYPASS_MODE_PASS) return;
+		// OFF mutes the output, TRAILS processes the silent input
+		memset(dataL, 0, len * sizeof(float32_t));
+		memset(dataR, 0, len * sizeof(float32_t));
+		if (bp_mode == BYPASS_MODE_OFF) return;
+	}
 
-		lfo.update();
+	// bypass released before the buffers were cleared, output the dry signal only
+	if (memCleaner.busy())
+	{
+		memCleaner.process();
+		arm_scale_f32(dataL, dry_gain, dataL, len);
+		arm_scale_f32(dataR, dry_gain, dataR, len);
+		return;
+	}
 
-		lfo.get(BASIC_LFO_PHASE_0, &mod_int, &mod_fr[0]);
-		mod_fr[0] = (float32_t)mod_int + mod_fr[0];
-		acc2 = (float32_t)dly_length - 1.0f - (dly_time + mod_fr[0]);
-		if (acc2 < 0.0f) mod_fr[0] += acc2;
+	cleanup_done = false;
 
-		lfo.get(BASIC_LFO_PHASE_60, &mod_int, &mod_fr[1]);
-		mod_fr[1] = (float32_t)mod_int + mod_fr[1];
-		acc2 = (float32_t)dly_length - 1.0f - (dly_time + mod_fr[1]);
-		if (acc2 < 0.0f) mod_fr[1] += acc2;
+	// control rate: delay time slew and modulation calculated once per block,
+	// the taps read along linear ramps from the last block's end values
+	tapTempo.tick(len);
+	step = dly_time_step * 0.1f * (float32_t)len;
+	acc1 = dly_time_set - dly_time;
+	if (acc1 > step) acc1 = step;
+	if (acc1 < -step) acc1 = -step;
+	dly_time += acc1;
 
-		lfo.get(BASIC_LFO_PHASE_120, &mod_int, &mod_fr[2]);
-		mod_fr[2] = (float32_t)mod_int + mod_fr[2];
-		acc2 = (float32_t)dly_length - 1.0f - (dly_time + mod_fr[2]);
-		if (acc2 < 0.0f) mod_fr[2] += acc2;	
+	lfo.update(len);
+	AudioBasicDelay *tap_dly[4] = {&dly0b, &dly0a, &dly1b, &dly1a};
+	for (i=0; i < 4; i++)
+	{
+		// stage the read windows, one burst per delay line (two if the window wraps)
+		tap_stage(i, *tap_dly[i], tap_time(i, len), len);
+	}
 
-		lfo.get(BASIC_LFO_PHASE_180, &mod_int, &mod_fr[3]);
-		mod_fr[3] = (float32_t)mod_int + mod_fr[3];	
-		acc2 = (float32_t)dly_length - 1.0f - (dly_time + mod_fr[3]);
-		if (acc2 < 0.0f) mod_fr[3] += acc2;		
+	// audio processing, writes go to the internal RAM scratch buffers
+	for (i=0; i < len; i++) 
+    {  
+		inputGain += (inputGainSet - inputGain) * 0.25f;
 
-		acc1 = dly0b.getTapHermite(dly_time+mod_fr[0]);
+		acc1 = tap_read(0, dly0b, i);
 		outR = acc1 * 0.6f;
 		acc1 = flt0R.process(acc1) * feedb;
-		acc1 += blockR->data[i] * inputGain;
+		acc1 += dataR[i] * inputGain;
 		acc1 = flt1R.process(acc1);
-		acc2 = dly0a.getTapHermite(dly_time+mod_fr[1]);
-		dly0b.write_toOffset(acc2, 0);
+		acc2 = tap_read(1, dly0a, i);
+		wr_buf[1][i] = acc2;		// dly0b
 		outL = acc2 * 0.6f;
-		dly0a.write_toOffset(acc1, 0);
+		wr_buf[0][i] = acc1;		// dly0a
 
-		acc1 = dly1b.getTapHermite(dly_time+mod_fr[2]);
+		acc1 = tap_read(2, dly1b, i);
 		outR += acc1 * 0.6f;
 		acc1 = flt0L.process(acc1) * feedb;
-		acc1 += blockL->data[i] * inputGain;
+		acc1 += dataL[i] * inputGain;
 		acc1 = flt1L.process(acc1);
-		acc2 = dly1a.getTapHermite(dly_time+mod_fr[3]);
-		dly1b.write_toOffset(acc2, 0);
+		acc2 = tap_read(3, dly1a, i);
+		wr_buf[3][i] = acc2;		// dly1b
 		outL += acc2 * 0.6f;
-		dly1a.write_toOffset(acc1, 0);
-
-		dly0a.updateIndex();
-		dly0b.updateIndex();
-		dly1a.updateIndex();
-		dly1b.updateIndex();
-		blockL->data[i] = outL * wet_gain + blockL->data[i] * dry_gain;
-		blockR->data[i] = outR * wet_gain + blockR->data[i] * dry_gain;
+		wr_buf[2][i] = acc1;		// dly1a
 
+		dataL[i] = outL * wet_gain + dataL[i] * dry_gain;
+		dataR[i] = outR * wet_gain + dataR[i] * dry_gain;
 	}
-    AudioStream_F32::transmit(blockL, 0);
-	AudioStream_F32::transmit(blockR, 1);
-	AudioStream_F32::release(blockL);
-	AudioStream_F32::release(blockR);
+	// write the new block into the delay lines and advance the write index
+	dly0a.writeBlock(wr_buf[0], len);
+	dly0b.writeBlock(wr_buf[1], len);
+	dly1a.writeBlock(wr_buf[2], len);
+	dly1b.writeBlock(wr_buf[3], len);
 }
 void AudioEffectDelayStereo_F32::freeze(bool state)
 {
@@ -233,91 +287,3 @@ void AudioEffectDelayStereo_F32::freeze(bool state)
 		__enable_irq();
 	}
 }
-
-/**
- * @brief Partial memory clear
- * 	Clearing all the delay buffers at once, esp. if 
- * 	the PSRAM is used takes too long for the audio ISR.
- *  Hence the buffer clear is done in configurable portions
- *  spread over a few audio update routines.
- * 
- * @return true 	Memory clean is complete
- * @return false 	Memory clean still in progress
- */
-bool AudioEffectDelayStereo_F32::memCleanup()
-{
-
-	static uint8_t dlyIdx = 0;
-	bool result = false;
-	if (dlyIdx == 0) // value 0 is used to reset the addr
-	{
-		memCleanupStart = 0;
-		memCleanupEnd = memCleanupStep;
-		flt0L.reset();
-		flt0R.reset();
-		flt1L.reset();
-		flt1R.reset();
-		dlyIdx = 1;
-	}
-	if (memCleanupEnd > dly_length) 		// last segment
-	{
-		memCleanupEnd = dly_length;
-		result = true;
-	}
-	switch(dlyIdx)
-	{
-		case 1:
-			dly0a.reset(memCleanupStart, memCleanupEnd);
-			memCleanupStart = memCleanupEnd;
-			memCleanupEnd += memCleanupStep;
-			if (result) // if done, reset the mem addr
-			{
-				memCleanupStart = 0;
-				memCleanupEnd = memCleanupStep;
-				dlyIdx = 2;
-				result = false;
-			}
-			break;
-		case 2:
-			dly0b.reset(memCleanupStart, memCleanupEnd);
-			memCleanupStart = memCleanupEnd;
-			memCleanupEnd += memCleanupStep;			
-			if (result) // if done, reset the mem addr
-			{
-				memCleanupStart = 0;
-				memCleanupEnd = memCleanupStep;
-				dlyIdx = 3;
-				result = false;
-			}		
-			break;
-		case 3:
-			dly1a.reset(memCleanupStart, memCleanupEnd);
-			memCleanupStart = memCleanupEnd;
-			memCleanupEnd += memCleanupStep;			
-			if (result) // if done, reset the mem addr
-			{
-				memCleanupStart = 0;
-				memCleanupEnd = memCleanupStep;
-				dlyIdx = 4;
-				result = false;
-			}	
-			break;
-		case 4:
-			dly1b.reset(memCleanupStart, memCleanupEnd);
-			memCleanupStart = memCleanupEnd;
-			memCleanupEnd += memCleanupStep;			
-			if (result) // if done, reset the mem addr
-			{
-				dlyIdx = 0;
-				result = true;
-			}				
-			break;
-		default:
-			dlyIdx = 0; // cleanup done, reset the dly line idx
-			result = false;
-			break;
-	}
-
-	
-	return result;
-}
\ No newline at end of file
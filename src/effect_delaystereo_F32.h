@@ -33,12 +33,23 @@
 #include "arm_math.h"
 #include "basic_components.h"
 
-class AudioEffectDelayStereo_F32 : public AudioStream_F32
+// length of the staged read window, covers one block + delay time change within the block
+#define DELAYSTEREO_STAGE_LEN	(2*AUDIO_BLOCK_SAMPLES + 16)
+
+class AudioEffectDelayStereo_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
-	AudioEffectDelayStereo_F32(uint32_t dly_range_ms=400, bool use_psram=false);
+	/**
+	 * @param dly_range_ms max delay time
+	 * @param use_psram place the delay buffers in PSRAM, if no PSRAM is found the time is 
+	 * 				limited to 200ms (float storage) or 400ms (16bit storage)
+	 * @param storage delay line sample format, 16bit formats double the delay time for the same memory
+	 */
+	AudioEffectDelayStereo_F32(uint32_t dly_range_ms=400, bool use_psram=false, delay_storage_t storage=DELAY_STORAGE_F32);
+	AudioEffectDelayStereo_F32(const AudioSettings_F32 &settings, uint32_t dly_range_ms=400, bool use_psram=false, delay_storage_t storage=DELAY_STORAGE_F32);
 	~AudioEffectDelayStereo_F32(){};
 	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 	/**
 	 * @brief set the delay time
 	 * 
@@ -96,7 +107,7 @@ public:
 	{
 		n = constrain(n, 0.0f, 1.0f);
 		n = 2.0f * n - (n*n);
-        n = map (n, 0.0f, 1.0f, 10.0f, 0.3f);
+        n = map (n, 0.0f, 1.0f, 10.0f, 0.3f) * (fs / AUDIO_SAMPLE_RATE_EXACT);
         __disable_irq();
         dly_time_step = n;
         __enable_irq();	
@@ -222,10 +233,6 @@ public:
 		bp = state;
 		if (bp)
 		{
-			__disable_irq();
-			memCleanupStart = 0;
-			memCleanupEnd = memCleanupStep;
-			__enable_irq();
 			freeze(false);
 		}
 		else
@@ -245,42 +252,73 @@ public:
     bool freeze_get() {return infinite;}
 	uint32_t tap_tempo(bool avg=true)
 	{
-		int32_t delta;
-		uint32_t tempo_ticks = 0;
-		if (!tap_active)
-		{
-			tap_counter = 0;
-			tap_active = true;
-		} 
-		else
-		{
-			__disable_irq();
-			tap_counter_new = tap_counter;
-			tap_counter = 0;
-			__enable_irq();
-			delta = tap_counter_new - tap_counter_last;
-			if (abs(delta) > tap_counter_deltamax || !avg) // new tempo?
-			{
-				tempo_ticks = tap_counter_new;
-			}
-			else 
-			{
-				tempo_ticks = (tap_counter_new>>1) + (tap_counter_last>>1);
-			}
-			while (tempo_ticks > dly_length - dly_time_min)
-			{
-				tempo_ticks >>= 1;
-			}
-			tap_counter_last = tempo_ticks;
-			delay(tempo_ticks);
-		}
+		uint32_t tempo_ticks;
+		if (tapTempo.tap(&tempo_ticks, dly_length - dly_time_min, avg)) delay(tempo_ticks);
 		return tempo_ticks;
 	}
 	bool is_initialized() {return initialized;}
+	/**
+	 * @brief allocate the delay buffers again with the constructor settings,
+	 * 			ie. after the memory arena was released
+	 */
+	bool mem_realloc()
+	{
+		begin(cfg_range_ms, cfg_psram, cfg_storage);
+		return initialized;
+	}
 private:
+	void bypass_update();
 	audio_block_f32_t *inputQueueArray[2];
 
 	uint32_t dly_length;
+	float32_t dly_rd_offset = 0.0f;
+	// block based delay line access: the read window of each tap is copied to 
+	// the internal RAM in one burst, new samples are written back once per block
+	// delay time and modulation are calculated per block, read positions are linear ramps
+	float32_t tap_p0[4];							// read position of the first sample
+	float32_t tap_dp[4];							// position increment per sample
+	float32_t tap_end[4] = {0.0f, 0.0f, 0.0f, 0.0f};	// modulated delay time at the end of the last block
+	float32_t tap_buf[4][DELAYSTEREO_STAGE_LEN];	// staged read windows
+	int32_t tap_start[4];							// window start position
+	bool tap_staged[4];
+	float32_t wr_buf[4][AUDIO_BLOCK_SAMPLES];		// new samples for dly0a, dly0b, dly1a, dly1b
+	/**
+	 * @brief set the read position ramp of one tap and copy its read window to the internal RAM
+	 * 			Windows longer than the staging buffer (fast delay time changes)
+	 * 			are read per sample.
+	 * 
+	 * @param end modulated delay time at the end of the block
+	 */
+	inline void tap_stage(uint8_t t, AudioBasicDelay &dly, float32_t end, uint32_t len)
+	{
+		// positions relative to the write index at the start of the block
+		float32_t dp = (end - tap_end[t]) / (float32_t)len;
+		tap_p0[t] = dly_rd_offset + tap_end[t] + dp;
+		tap_dp[t] = dp + 1.0f;
+		tap_end[t] = end;
+		float32_t pmin = tap_p0[t];
+		float32_t pmax = dly_rd_offset + end + (float32_t)(len - 1);
+		if (pmax < pmin) { pmin = pmax; pmax = tap_p0[t]; }
+		int32_t start = (int32_t)pmin - 1;
+		uint32_t span = (int32_t)pmax + 3 - start;
+		tap_staged[t] = span <= DELAYSTEREO_STAGE_LEN;
+		if (!tap_staged[t]) return;
+		tap_start[t] = start;
+		dly.readBlock(tap_buf[t], start, span);
+	}
+	float32_t tap_time(uint8_t t, uint32_t len);
+	inline float32_t tap_read(uint8_t t, AudioBasicDelay &dly, uint32_t i)
+	{
+		float32_t pos = tap_p0[t] + (float32_t)i * tap_dp[t];
+		int32_t p = (int32_t)pos;
+		if (!tap_staged[t])
+		{
+			float32_t x[4];
+			dly.readBlock(x, p - 1, 4);
+			return AudioBasicDelay::hermite(x, pos - (float32_t)p);
+		}
+		return AudioBasicDelay::hermite(&tap_buf[t][p - 1 - tap_start[t]], pos - (float32_t)p);
+	}
 	AudioBasicDelay dly0a;
 	AudioBasicDelay dly0b;
 	AudioBasicDelay dly1a;
@@ -292,11 +330,11 @@ private:
 	AudioFilterShelvingLPHP flt1R;
 
 	static constexpr float32_t lfo_fmax = 16.0f;
-	static constexpr float32_t lfo_ampl_max = 127.0f;
+	static constexpr float32_t lfo_ampl_max44k1 = 127.0f;
+	float32_t lfo_ampl_max = lfo_ampl_max44k1;	// scaled to the sample rate
 	float32_t lfo_ampl = 0.0f;
 	AudioBasicLfo lfo = AudioBasicLfo(0.0f, lfo_ampl);
 	bool psram_mode;
-	bool memsetup_done = false;
 	bool bp = true;
 	bypass_mode_t bp_mode = BYPASS_MODE_TRAILS;
 	bool cleanup_done = false;
@@ -314,10 +352,14 @@ private:
 	float32_t bassCut_k = 0.0f;
 	float32_t treble_k = 1.0f;
 	float32_t bass_k = 0.0f;
-	float32_t dly_time, dly_time_set;
+	float32_t dly_time = 0.0f, dly_time_set = 0.0f;	// per instance delay time state
 	float32_t dly_time_step = 10.0f;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 	static const uint32_t dly_time_min = 128;
 	bool initialized = false;
+	uint32_t cfg_range_ms;
+	bool cfg_psram;
+	delay_storage_t cfg_storage;
 	
 	// freeze variables
 	float32_t freeze_ingain = 0.00f;
@@ -326,17 +368,11 @@ private:
 	float32_t trebleCut_k_tmp = 1.0f;
 	float32_t feedb_tmp = 0;
 
-	bool tap_active = false;
-	uint32_t tap_counter = 0;
-	uint32_t tap_counter_last=0, tap_counter_new=0;
-	static const uint32_t tap_counter_max = 3000*AUDIO_SAMPLE_RATE; // 3 sec
-	static const int32_t tap_counter_deltamax = 0.3f*AUDIO_SAMPLE_RATE_EXACT;
+	AudioBasicTapTempo tapTempo;
 
-	bool memCleanup(void);
-	void begin(uint32_t dly_range_ms, bool use_psram);
-	const uint32_t memCleanupStep = 2048;
-	uint32_t memCleanupStart = 0;
-	uint32_t memCleanupEnd = memCleanupStep;
+	void begin(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage);
+	static const uint32_t memCleanupStep = 2048*sizeof(float32_t);	// bytes cleared per update
+	AudioBasicMemCleaner memCleaner;
 };
 
 #endif // _EFFECT_DELAYSTEREO_H_
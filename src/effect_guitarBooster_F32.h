@@ -2,7 +2,7 @@
  * @file effect_guitarBooster_F32.h
  * @author Piotr Zapart
  * @brief Oversampled Waveshaper based overdrive effect
- * 			Stereo IO and bypass, but the processing is mono
+ * 			Stereo IO and bypass, mono (L+R) or true stereo processing
  * @version 0.1
  * @date 2024-03-20
  * 
@@ -22,6 +22,10 @@
 
 #include <AudioStream_F32.h>
 #include "basic_DSPutils.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
+#include "basic_oversampler.h"
+#include "basic_waveshaper.h"
 #include <arm_math.h>
 
 
@@ -30,8 +34,16 @@
 #define GBOOST_LP2_F		(10000.0f)
 #define GBOOST_BOTTOM_MINF	(50.0f)
 #define GBOOST_BOTTOM_MAXF	(350.0f)
+#define GBOOST_OVERSAMPLE	(4)			// default oversampling factor (was a 5x FIR before the half-band oversampler)
+// Max. oversampling factor, sets the size of the oversampled buffers in each booster:
+// 10KB at 8x, 5KB at 4x, 2.5KB at 2x (two channels, used by the true stereo mode).
+// Define it before including the library to save memory, oversample() is limited to it.
+#ifndef GBOOST_OVERSAMPLE_MAX
+	#define GBOOST_OVERSAMPLE_MAX	(8)
+#endif
+#define GBOOST_DRIVE_SCALE	(5.0f)		// drive range, the input is scaled by 1/GBOOST_DRIVE_SCALE
 
-class AudioEffectGuitarBooster_F32 : public AudioStream_F32
+class AudioEffectGuitarBooster_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
 	AudioEffectGuitarBooster_F32(void) : AudioStream_F32(2, inputQueueArray)
@@ -49,21 +61,81 @@ public:
 	}
 
 	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 	
 	void begin()
 	{
-		arm_fir_interpolate_init_f32(&interpolator, upsample_k, FIR_taps, (float32_t*)FIR_coeffs, interpState, AUDIO_BLOCK_SAMPLES);
-		arm_fir_decimate_init_f32(&decimator, FIR_taps, upsample_k, (float32_t*)FIR_coeffs, decimState, upsample_k * AUDIO_BLOCK_SAMPLES);
+		oversample(GBOOST_OVERSAMPLE);
 		bottom(1.0f);
 		tone(1.0f);
-		hpPost_k = omega(GBOOST_BOTTOM_MINF);
-		lp2_k = omega(GBOOST_LP2_F);
 		gainRange = 4.0f;
 	}
+	/**
+	 * @brief oversampling factor for the waveshaper, quality vs CPU load
+	 * 		default GBOOST_OVERSAMPLE (4x)
+	 * 
+	 * @param f 1 (off), 2, 4 or 8, up to GBOOST_OVERSAMPLE_MAX
+	 */
+	void oversample(uint8_t f)
+	{
+		os.factor(f);
+		float32_t hp = omega(GBOOST_BOTTOM_MINF);
+		float32_t lp = omega(GBOOST_LP2_F);
+		__disable_irq();
+		hpPost_k = hp;
+		lp2_k = lp;
+		__enable_irq();
+		bottom(bottomSet);	// recalculate for the new sampling rate
+		tone(toneSet);
+	}
+	uint8_t oversample_get() { return os.factor_get(); }
+	/**
+	 * @brief first order antiderivative antialiasing (ADAA) for the waveshaper
+	 * 		The shaper output is the difference quotient of the integrated transfer curve,
+	 * 		which suppresses the aliasing of the nonlinearity by itself.
+	 * 		ADAA at 2x has lower aliasing than the plain shaper at 4x for less CPU load,
+	 * 		ADAA at 1x (no oversampling) is comparable to the plain shaper at 2x.
+	 * 		Adds a half sample delay and a mild top end rolloff at 1x.
+	 * 
+	 * @param state true = ADAA on
+	 */
+	void adaa_set(bool state)
+	{
+		__disable_irq();
+		adaa = state;
+		__enable_irq();
+	}
+	bool adaa_get() { return adaa; }
+	/**
+	 * @brief true stereo processing, both channels go through the oversampled shaper
+	 * 		as two lanes of the same loop (own filter states, shared coefficients).
+	 * 		Each channel gets the gain of the L+R sum used in mono mode, a mono source
+	 * 		sounds the same in both modes.
+	 * 
+	 * @param state true = stereo, false = mono, L+R sum on both outputs (default)
+	 */
+	void stereo_set(bool state)
+	{
+		__disable_irq();
+		if (state != stereo)
+		{
+			lane[1] = lane[0];		// start the new lane from the current state
+			stereo = state;
+		}
+		__enable_irq();
+	}
+	bool stereo_get() { return stereo; }
+	/**
+	 * @brief waveshaper transfer curve, default WAVESHAPER_BOOSTER
+	 * 
+	 * @param c WAVESHAPER_BOOSTER, WAVESHAPER_TUBE, WAVESHAPER_DIODE or WAVESHAPER_FUZZ
+	 */
+	void curve(waveshaper_curve_t c) { ws.curve(c); }
+	waveshaper_curve_t curve_get() { return ws.curve_get(); }
 	void drive(float32_t value)
 	{
 		value = fabs(value);
-		value = 1.0f + value * upsample_k;
+		value = 1.0f + value * GBOOST_DRIVE_SCALE;
 		__disable_irq()
 		gainSet = value;
 		__enable_irq();
@@ -78,7 +150,7 @@ public:
 		value = fabs(value);
 		value = constrain(value, 0.0f, 1.0f);
 		// start with 0.5 - L+R are summed giving x2 gain
-		value = 0.5f + value * upsample_k * gainRange;
+		value = 0.5f + value * GBOOST_DRIVE_SCALE * gainRange;
 		__disable_irq()
 		gainSet = value;
 		__enable_irq();
@@ -118,13 +190,13 @@ public:
 		__enable_irq();
 	}
 	// Bypass 
-    bool bypass_get(void) {return bp;}
-    void bypass_set(bool state) {bp = state;}
-    bool bypass_tgl(void) 
-    {
-        bp ^= 1; 
-        return bp;
-    }
+    bool bypass_get(void) {return bpx.get();}
+    void bypass_set(bool state) {bpx.set(state);}
+    bool bypass_tgl(void) {return bpx.tgl();}
+    /**
+     * @brief bypass crossfade length in audio blocks
+     */
+    void bypass_setFade(uint16_t blocks) {bpx.setFadeBlocks(blocks);}
 
 	bool octave_get(void) {return octave;}
     void octave_set(bool state) {octave = state;}
@@ -135,35 +207,28 @@ public:
     }
 private:
 	audio_block_f32_t *inputQueueArray[2];
+	bool kernel(float32_t *dataL, float32_t *dataR, uint32_t len);
+	template <uint8_t LANES>
+	void shaper(float32_t **buf, uint32_t len);
 	float fs_Hz;
 	uint16_t blockSize;
-	static const uint8_t upsample_k = 5;
-	static const uint8_t FIR_taps = 75;
-	static constexpr float32_t FIR_coeffs[FIR_taps] =
-	{
-		-0.000033, 0.000112,-0.000100,-0.000103, 0.000361,-0.000331,-0.000181, 0.000822,-0.000824,-0.000205, 
-		 0.001556,-0.001737,-0.000054, 0.002607,-0.003263, 0.000461, 0.003979,-0.005641, 0.001621, 0.005626, 
-		-0.009170, 0.003841, 0.007448,-0.014287, 0.007776, 0.009301,-0.021812, 0.014667, 0.011009,-0.033775, 
-		 0.027639, 0.012392,-0.057262, 0.058949, 0.013293,-0.142816, 0.268001, 0.680272, 0.268001,-0.142816, 
-		 0.013293, 0.058949,-0.057262, 0.012392, 0.027639,-0.033775, 0.011009, 0.014667,-0.021812, 0.009301, 
-		 0.007776,-0.014287, 0.007448, 0.003841,-0.009170, 0.005626, 0.001621,-0.005641, 0.003979, 0.000461, 
-		-0.003263, 0.002607,-0.000054,-0.001737, 0.001556,-0.000205,-0.000824, 0.000822,-0.000181,-0.000331, 
-		 0.000361,-0.000103,-0.000100, 0.000112,-0.000033
-	};
-	float32_t blockInterpolated[upsample_k * AUDIO_BLOCK_SAMPLES];
-
-	float32_t interpState[(FIR_taps / upsample_k) + AUDIO_BLOCK_SAMPLES - 1];
-	float32_t decimState[FIR_taps + (upsample_k * AUDIO_BLOCK_SAMPLES) - 1];
-
-	arm_fir_interpolate_instance_f32 interpolator;
-	arm_fir_decimate_instance_f32 decimator;
-	arm_linear_interp_instance_f32 waveshaper = 
-	{
-		2000, -1.0f, 2.0f/2000.0f, &driveWaveform[0]
-	};
-	bool bp = true; // bypass flag
+	AudioBasicOversampler<2, GBOOST_OVERSAMPLE_MAX> os;
+	AudioBasicWaveshaper ws;
+	AudioBasicBypassXfade bpx;	// crossfading bypass, starts bypassed
 
 	bool octave = true;
+	bool adaa = false;
+	bool stereo = false;
+	typedef struct
+	{
+		float32_t hpPre1_reg;
+		float32_t hpPre2_reg;
+		float32_t lp1_reg;
+		float32_t lp2_reg;
+		float32_t hpPost_reg;
+		waveshaper_adaa_t adaa;
+	}lane_t;
+	lane_t lane[2] = {};			// per channel filter states
 
 	float32_t dryGain = 0.0f;
 	float32_t wetGain = 1.0f;
@@ -175,21 +240,16 @@ private:
     float32_t levelSet = 1.0f;
     float32_t level = 1.0f;
     float32_t lp1_k = 0.0f;
-    float32_t lp1_reg = 0.0f;
     float32_t lp2_k = 0.0f;
-    float32_t lp2_reg = 0.0f;
     float32_t hpPre1_k = 0.0f;
-    float32_t hpPre1_reg = 0.0f;
     float32_t hpPre2_k = 0.0f;
-    float32_t hpPre2_reg = 0.0f;	
     float32_t hpPost_k = 0.0f;
-    float32_t hpPost_reg = 0.0f;	
-
-	static float32_t driveWaveform[2001];
+	float32_t bottomSet = 1.0f;
+	float32_t toneSet = 1.0f;
 
 	inline float32_t omega(float f)
 	{
-		float32_t fs = fs_Hz * upsample_k;
+		float32_t fs = fs_Hz * os.factor_get();
 		return 1.0f - expf(-TWO_PI * f / fs);
 	}
 };
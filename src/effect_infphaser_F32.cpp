@@ -46,6 +46,7 @@ void AudioEffectInfinitePhaser_F32::begin(void)
 void AudioEffectInfinitePhaser_F32::update()
 {
 #if defined(__IMXRT1062__)
+    AudioBasicDenormalGuard ftz;
     audio_block_f32_t *blockIn; 
     uint16_t i = 0;
     float32_t modSig;
@@ -59,18 +60,20 @@ void AudioEffectInfinitePhaser_F32::update()
     float32_t fdb = feedb;
     float32_t ampl;
 
-    blockIn = AudioStream_F32::receiveWritable_f32(0);       // audio data
-    
-    if (!blockIn)
-    {
-        return;
-    }
     if (bps)
     {
+        blockIn = AudioStream_F32::receiveReadOnly_f32(0);   // pass the read only block
+        if (!blockIn) return;
         AudioStream_F32::transmit(blockIn);
         AudioStream_F32::release(blockIn);
         return;
     }
+    blockIn = AudioStream_F32::receiveWritable_f32(0);       // audio data
+    
+    if (!blockIn)
+    {
+        return;
+    }
 
 	for (i=0; i < blockIn->length; i++) 
     {
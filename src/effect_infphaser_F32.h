@@ -31,6 +31,7 @@
 #include "Audio.h"
 #include "AudioStream_F32.h"
 #include "arm_math.h"
+#include "basic_denormal.h"
 
 // ################ SHEPARD/BARBERPOLE INFINITE PHASER ################
 #define INFINITE_PHASER_STAGES	6
@@ -47,6 +48,7 @@ public:
 	}
 	AudioEffectInfinitePhaser_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray_f32)
 	{
+		fs = settings.sample_rate_Hz;
 		begin();
 	}
     ~AudioEffectInfinitePhaser_F32(){};
@@ -97,7 +99,7 @@ public:
         else rate = rate*rate;
         top = constrain(top, 0.0f, 1.0f);
         btm = constrain(btm, 0.0f, 1.0f);
-        add = rate * (4294967296.0 / AUDIO_SAMPLE_RATE_EXACT);
+        add = rate * (4294967296.0f / fs);
         __disable_irq();
         lfo_top = top;
         lfo_btm = btm;
@@ -116,7 +118,7 @@ public:
         else rate = rate*rate;
         int32_t add;
         rate = map(rate, -1.0f, 1.0f, -INFINITE_PHASER_MAX_LFO_HZ, INFINITE_PHASER_MAX_LFO_HZ);
-        add = rate * (4294967296.0f / AUDIO_SAMPLE_RATE_EXACT);
+        add = rate * (4294967296.0f / fs);
         __disable_irq();
         lfo_add = add;
         __enable_irq();
@@ -172,6 +174,7 @@ public:
 private:
     uint8_t stg;                             // number of stages
     bool bps;                                // bypass
+    float32_t fs = AUDIO_SAMPLE_RATE_EXACT;     // sample rate
     audio_block_f32_t *inputQueueArray_f32[1];      
     float32_t allpass_x[INFINITE_PHASER_PATHS][INFINITE_PHASER_STAGES];      // allpass inputs
 	float32_t allpass_y[INFINITE_PHASER_PATHS][INFINITE_PHASER_STAGES];      // allpass outputs
@@ -31,23 +31,25 @@
  */
 #include "effect_monoToStereo_F32.h"
 
-const float32_t allpass_k_table[ALLP_NETWORK_LEN] = 
+// allpass corner frequencies in Hz, the coefficients are calculated for the used sample rate
+static const float32_t allpass_fc_table[ALLP_NETWORK_LEN] = 
 {
-    -0.9823311567306519f, -0.9838343858718872f, -0.9838343858718872f, 
-    -0.9843953251838684f, -0.9843953251838684f, -0.9850407838821411f, 
-    -0.9850407838821411f, -0.9856590032577515f, -0.9856590032577515f, 
-    -0.9868955612182617f, -0.9868955612182617f, -0.9894036054611206f, 
-    -0.9894036054611206f, -0.9902338981628418f, -0.9902338981628418f, 
-    -0.9911531209945679f, -0.9911531209945679f, -0.9911531209945679f, 
-    -0.9911531209945679f, -0.9928167462348938f, -0.9928167462348938f
+    125.11493f, 114.38416f, 114.38416f,
+    110.38404f, 110.38404f, 105.78398f,
+    105.78398f, 101.38083f, 101.38083f,
+    92.58184f, 92.58184f, 74.76870f,
+    74.76870f, 68.88146f, 68.88146f,
+    62.36936f, 62.36936f, 62.36936f,
+    62.36936f, 50.59885f, 50.59885f
 };
 
 AudioEffectMonoToStereo_F32::AudioEffectMonoToStereo_F32() : AudioStream_F32(1, inputQueueArray_f32)
 {
-    pancos = 1.0f;
-    pansin= 0.0f;
-    width = 0.0f;
-    bypass = false;
+    init(AUDIO_SAMPLE_RATE_EXACT);
+}
+AudioEffectMonoToStereo_F32::AudioEffectMonoToStereo_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray_f32)
+{
+    init(settings.sample_rate_Hz);
 }
 AudioEffectMonoToStereo_F32::~AudioEffectMonoToStereo_F32()
 {
@@ -56,7 +58,7 @@ AudioEffectMonoToStereo_F32::~AudioEffectMonoToStereo_F32()
 void AudioEffectMonoToStereo_F32::update()
 {
 #if defined(__IMXRT1062__)
-
+    AudioBasicDenormalGuard ftz;
     audio_block_f32_t *blockIn;
     uint16_t i;
     float32_t _width = width;
@@ -106,24 +108,42 @@ void AudioEffectMonoToStereo_F32::update()
 }
 
 
+void AudioEffectMonoToStereo_F32::init(float32_t fs)
+{
+    pancos = 1.0f;
+    pansin= 0.0f;
+    width = 0.0f;
+    bypass = false;
+    for (uint32_t i = 0; i < ALLP_NETWORK_LEN; i++)
+    {
+        double t = tan(M_PI * allpass_fc_table[i] / fs);
+        allpass_k[i] = (float32_t)((t - 1.0) / (t + 1.0));
+    }
+    memset(allpass_netw_1x, 0, sizeof(allpass_netw_1x));
+    memset(allpass_netw_1y, 0, sizeof(allpass_netw_1y));
+    memset(allpass_netw_2x, 0, sizeof(allpass_netw_2x));
+    memset(allpass_netw_2y, 0, sizeof(allpass_netw_2y));
+}
+
 // y[n] = c*x[n] + x[n-1] - c*y[n-1]
 // y[n] = c*(x[n] - y[n-1]) + x[n-1]
 // c = (tan(pi*fc/fs)-1) / (tan(pi*fc/fs)+1)
 float32_t AudioEffectMonoToStereo_F32::do_allp_netw(float32_t inSig, float32_t *x, float32_t *y)
 {
     uint32_t stg = ALLP_NETWORK_LEN;
+    inSig = denormal_bias(inSig);     // DC passes the allpasses, keeps all stages out of the subnormal range
     while (stg)
     {
         stg--;
-        y[stg] = allpass_k_table[stg] * (inSig - y[stg]) + x[stg];
+        y[stg] = allpass_k[stg] * (inSig - y[stg]) + x[stg];
         x[stg] = inSig;
         inSig = y[stg];
                 stg--;
-        y[stg] = allpass_k_table[stg] * (inSig - y[stg]) + x[stg];
+        y[stg] = allpass_k[stg] * (inSig - y[stg]) + x[stg];
         x[stg] = inSig;
         inSig = y[stg];
                 stg--;
-        y[stg] = allpass_k_table[stg] * (inSig - y[stg]) + x[stg];
+        y[stg] = allpass_k[stg] * (inSig - y[stg]) + x[stg];
         x[stg] = inSig;
         inSig = y[stg];
     }
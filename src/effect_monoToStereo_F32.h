@@ -35,6 +35,7 @@
 #include <Arduino.h>
 #include "AudioStream_F32.h"
 #include "arm_math.h"
+#include "basic_denormal.h"
 
 #define ALLP_NETWORK_LEN    21
 
@@ -42,6 +43,7 @@ class AudioEffectMonoToStereo_F32 : public AudioStream_F32
 {
 public:
     AudioEffectMonoToStereo_F32();
+    AudioEffectMonoToStereo_F32(const AudioSettings_F32 &settings);
     ~AudioEffectMonoToStereo_F32();
     virtual void update();
     void setSpread(float32_t val)
@@ -69,7 +71,9 @@ private:
     bool bypass;
     float32_t width;
     float32_t pancos, pansin;
+    void init(float32_t fs);
     float32_t do_allp_netw(float32_t inSig, float32_t *x, float32_t *y);
+    float32_t allpass_k[ALLP_NETWORK_LEN];
     float32_t allpass_netw_1x[ALLP_NETWORK_LEN];
     float32_t allpass_netw_1y[ALLP_NETWORK_LEN];
     float32_t allpass_netw_2x[ALLP_NETWORK_LEN];
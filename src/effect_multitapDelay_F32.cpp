@@ -0,0 +1,303 @@
+/*  Multi tap rhythmic delay for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "effect_multitapDelay_F32.h"
+
+#define TREBLE_LOSS_FREQ    (0.20f)
+#define BASS_LOSS_FREQ      (0.05f)
+
+extern uint8_t external_psram_size;
+
+AudioEffectMultitapDelay_F32::AudioEffectMultitapDelay_F32(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage) : AudioStream_F32(2, inputQueueArray)
+{
+	begin(dly_range_ms, use_psram, storage);
+}
+
+AudioEffectMultitapDelay_F32::AudioEffectMultitapDelay_F32(const AudioSettings_F32 &settings, uint32_t dly_range_ms, bool use_psram, delay_storage_t storage) : AudioStream_F32(2, inputQueueArray)
+{
+	fs = settings.sample_rate_Hz;
+	begin(dly_range_ms, use_psram, storage);
+}
+
+void AudioEffectMultitapDelay_F32::begin(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage)
+{
+	AudioBasicMemArenaOwner memOwner(this, "MultitapDelay");
+	initialized = false;
+	cfg_range_ms = dly_range_ms;
+	cfg_psram = use_psram;
+	cfg_storage = storage;
+	// failsafe if psram is required but not found
+	// limit the delay time to 800ms (141120 bytes at 44.1kHz), 16bit storage fits 1600ms into the same memory
+	uint32_t dly_range_max = storage == DELAY_STORAGE_F32 ? 800 : 1600;
+	psram_mode = use_psram;
+	#if ARDUINO_TEENSY41
+	if (psram_mode && external_psram_size == 0)
+	{
+		psram_mode = false;
+		if (dly_range_ms > dly_range_max) dly_range_ms = dly_range_max;
+	}
+	#else
+		psram_mode = false;
+		if (dly_range_ms > dly_range_max) dly_range_ms = dly_range_max;
+	#endif
+	// reads have to stay behind the block written at the end of the update
+	dly_time_min = AUDIO_BLOCK_SAMPLES + 3;
+	dly_time_max = ((float32_t)(dly_range_ms)/1000.0f) * fs;
+	if (dly_time_max < dly_time_min) dly_time_max = dly_time_min;
+	// +4 samples: the oldest interpolated read needs one sample before the read position
+	dly_length = dly_time_max + 4;
+	if (!dly.init(dly_length, psram_mode, psram_mode, storage)) return;
+	flt_fb.init(onepole_coeff_fs(BASS_LOSS_FREQ, fs), &bassCut_k, onepole_coeff_fs(TREBLE_LOSS_FREQ, fs), &trebleCut_k);
+	dly_time_step = 10.0f * fs / AUDIO_SAMPLE_RATE_EXACT;
+	tapTempo.init(fs);
+	beat = 0.5f * fs;		// 120bpm
+	// default pattern: 8th notes, only the first tap is active
+	for (uint8_t t = 0; t < MULTITAP_MAX_TAPS; t++)
+	{
+		tap_t *tp = &taps[t];
+		tp->active = t == 0;
+		tp->div = MULTITAP_DIV_8TH * (t + 1);
+		tp->dly_set = tp->dly = constrain(tp->div * beat, (float32_t)dly_time_min, (float32_t)dly_time_max);
+		tp->level = 1.0f;
+		tp->pan = (t & 0x01) ? 0.8f : 0.2f;
+		tp->lp_k = 1.0f;
+		tp->lp_reg = 0.0f;
+		tap_gains(t);
+		tp->gainL = tp->gainL_set;
+		tp->gainR = tp->gainR_set;
+	}
+	fb_tap = 0;
+	tempo_update();
+	mix(0.5f);
+	feedback(0.5f);
+	// delay buffer is cleared in portions in the update() function
+	memCleaner.clear();
+	memCleaner.setBudget(memCleanupStep);
+	memCleaner.add(dly, psram_mode);
+	memCleaner.start();
+	cleanup_done = true;
+	initialized = true;
+}
+
+/**
+ * @brief recalculate the tempo synced tap times
+ */
+void AudioEffectMultitapDelay_F32::tempo_update()
+{
+	float32_t d = 0.0f;
+	for (uint8_t t = 0; t < MULTITAP_MAX_TAPS; t++)
+	{
+		if (taps[t].div == 0.0f) continue;
+		tap_setDelay(t, taps[t].div * beat);
+		if (taps[t].active && taps[t].div > d) d = taps[t].div;
+	}
+	div_max = d;
+}
+
+/**
+ * @brief read one block of a tap from the delay line
+ * 			The delay time is ramped linearly over the block. Constant integer
+ * 			times are copied in one burst, otherwise the read window is staged
+ * 			in the internal RAM and Hermite interpolated.
+ */
+void AudioEffectMultitapDelay_F32::tap_render(tap_t *tp, float32_t *dst, uint32_t len)
+{
+	float32_t d0 = tp->dly;
+	float32_t d1 = tp->dly_set;
+	float32_t step = dly_time_step * 0.1f * (float32_t)len;
+	if (d1 > d0 + step) d1 = d0 + step;
+	if (d1 < d0 - step) d1 = d0 - step;
+	tp->dly = d1;
+	// read position relative to the write index at the start of the block
+	float32_t p0 = (float32_t)dly.getSize() - d0;
+	float32_t p1 = (float32_t)dly.getSize() - d1;
+	if (d0 == d1 && d0 == (float32_t)((int32_t)d0))
+	{
+		dly.readBlock(dst, (int32_t)p0, len);
+		return;
+	}
+	float32_t dp = (p1 - p0) / (float32_t)len;
+	float32_t pos = p0 + dp;	// delay reaches d1 at the last sample
+	float32_t pmin = pos;
+	float32_t pmax = p1 + (float32_t)(len - 1);
+	if (pmax < pmin) { pmin = pmax; pmax = pos; }
+	int32_t start = (int32_t)pmin - 1;
+	uint32_t span = (int32_t)pmax + 3 - start;
+	uint32_t i;
+	int32_t p;
+	if (span <= MULTITAP_STAGE_LEN)
+	{
+		dly.readBlock(tap_buf, start, span);
+		for (i = 0; i < len; i++)
+		{
+			p = (int32_t)pos;
+			dst[i] = AudioBasicDelay::hermite(&tap_buf[p - 1 - start], pos - (float32_t)p);
+			pos += dp + 1.0f;
+		}
+	}
+	else	// fast time change, read per sample
+	{
+		float32_t x[4];
+		for (i = 0; i < len; i++)
+		{
+			p = (int32_t)pos;
+			dly.readBlock(x, p - 1, 4);
+			dst[i] = AudioBasicDelay::hermite(x, pos - (float32_t)p);
+			pos += dp + 1.0f;
+		}
+	}
+}
+
+void AudioEffectMultitapDelay_F32::update()
+{
+	if (!initialized) return;
+	audio_block_f32_t *blockL, *blockR;
+
+	if (bp && bp_mode != BYPASS_MODE_TRAILS)
+	{
+		// read only blocks are passed through, no audio memory copy or allocation
+		bypass_update();
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, bp_mode);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!bypass_process(&blockL, &blockR, bp_mode, bp))
+		return;
+	process(blockL->data, blockR->data, blockL->length);
+	AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+}
+
+/**
+ * @brief bypass housekeeping, buffer cleanup in PASS and OFF modes, input fade out in TRAILS mode
+ */
+void AudioEffectMultitapDelay_F32::bypass_update()
+{
+	// mem cleanup not required in TRAILS mode
+	if (!cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
+	{
+		memCleaner.start();	// clear the buffer in portions over the next updates
+		flt_fb.reset();
+		for (uint8_t t = 0; t < MULTITAP_MAX_TAPS; t++) taps[t].lp_reg = 0.0f;
+		cleanup_done = true;
+		tapTempo.reset();
+	}
+	if (bp_mode != BYPASS_MODE_TRAILS)
+	{
+		memCleaner.process();
+	}
+	else
+	{
+		inputGainSet = 0.0f;
+		tapTempo.reset();
+	}
+}
+
+void AudioEffectMultitapDelay_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+	AudioBasicDenormalGuard ftz;
+	if (!initialized) return;
+
+	uint32_t i;
+	uint8_t t;
+	float32_t acc, gL, gR, dgL, dgR, lp_k, lp_reg;
+	bool fb_active = false;
+
+	if (bp)
+	{
+		bypass_update();
+		if (bp_mode == BYPASS_MODE_PASS) return;
+		// OFF mutes the output, TRAILS processes the silent input
+		memset(dataL, 0, len * sizeof(float32_t));
+		memset(dataR, 0, len * sizeof(float32_t));
+		if (bp_mode == BYPASS_MODE_OFF) return;
+	}
+
+	// bypass released before the buffer was cleared, output the dry signal only
+	if (memCleaner.busy())
+	{
+		memCleaner.process();
+		arm_scale_f32(dataL, dry_gain, dataL, len);
+		arm_scale_f32(dataR, dry_gain, dataR, len);
+		return;
+	}
+
+	cleanup_done = false;
+	tapTempo.tick(len);
+	memset(wetL, 0, len * sizeof(float32_t));
+	memset(wetR, 0, len * sizeof(float32_t));
+
+	// taps: one read burst per tap, filter and pan into the wet buffers
+	for (t = 0; t < MULTITAP_MAX_TAPS; t++)
+	{
+		tap_t *tp = &taps[t];
+		if (!tp->active) continue;
+		tap_render(tp, tap_out, len);
+		lp_k = tp->lp_k;
+		lp_reg = tp->lp_reg;
+		gL = tp->gainL;
+		gR = tp->gainR;
+		dgL = (tp->gainL_set - gL) / (float32_t)len;
+		dgR = (tp->gainR_set - gR) / (float32_t)len;
+		for (i = 0; i < len; i++)
+		{
+			lp_reg += (tap_out[i] - lp_reg) * lp_k;
+			tap_out[i] = lp_reg;
+			gL += dgL;
+			gR += dgR;
+			wetL[i] += lp_reg * gL;
+			wetR[i] += lp_reg * gR;
+		}
+		tp->lp_reg = lp_reg;
+		tp->gainL = tp->gainL_set;
+		tp->gainR = tp->gainR_set;
+		if (t == fb_tap)
+		{
+			memcpy(fb_buf, tap_out, len * sizeof(float32_t));
+			fb_active = true;
+		}
+	}
+	if (!fb_active) memset(fb_buf, 0, len * sizeof(float32_t));
+
+	// new samples: mono input + filtered feedback, one write burst per block
+	for (i = 0; i < len; i++)
+	{
+		inputGain += (inputGainSet - inputGain) * 0.25f;
+		acc = flt_fb.process(fb_buf[i]) * feedb;
+		wr_buf[i] = acc + (dataL[i] + dataR[i]) * 0.5f * inputGain;
+		dataL[i] = wetL[i] * wet_gain + dataL[i] * dry_gain;
+		dataR[i] = wetR[i] * wet_gain + dataR[i] * dry_gain;
+	}
+	dly.writeBlock(wr_buf, len);
+}
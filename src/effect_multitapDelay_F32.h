@@ -0,0 +1,397 @@
+/*  Multi tap rhythmic delay for Teensy 4
+ *
+ *  Author: Piotr Zapart
+ *          www.hexefx.com
+ *
+ * Copyright (c) 2024 by Piotr Zapart
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _EFFECT_MULTITAPDELAY_H_
+#define _EFFECT_MULTITAPDELAY_H_
+
+#include <Arduino.h>
+#include "Audio.h"
+#include "AudioStream.h"
+#include "AudioStream_F32.h"
+#include "arm_math.h"
+#include "basic_components.h"
+
+#define MULTITAP_MAX_TAPS		(8)
+// length of the staged read window, covers one block + delay time change within the block
+#define MULTITAP_STAGE_LEN		(2*AUDIO_BLOCK_SAMPLES + 16)
+
+// tap time as a fraction of the tempo (quarter note)
+#define MULTITAP_DIV_WHOLE			(4.0f)
+#define MULTITAP_DIV_HALF			(2.0f)
+#define MULTITAP_DIV_QUARTER		(1.0f)
+#define MULTITAP_DIV_QUARTER_DOT	(1.5f)
+#define MULTITAP_DIV_QUARTER_TRIP	(2.0f/3.0f)
+#define MULTITAP_DIV_8TH			(0.5f)
+#define MULTITAP_DIV_8TH_DOT		(0.75f)
+#define MULTITAP_DIV_8TH_TRIP		(1.0f/3.0f)
+#define MULTITAP_DIV_16TH			(0.25f)
+#define MULTITAP_DIV_16TH_DOT		(0.375f)
+#define MULTITAP_DIV_16TH_TRIP		(1.0f/6.0f)
+
+/**
+ * @brief Up to 8 taps reading from one shared delay buffer
+ * 		The input (L+R) is written to the delay line once per block, each tap has its own
+ * 		time, level, panorama and lowpass filter. Tap times are either set
+ * 		directly or as a fraction of the tempo (tap tempo or BPM).
+ * 		Minimum tap time is one audio block.
+ */
+class AudioEffectMultitapDelay_F32 : public AudioStream_F32, public AudioEffectKernel_F32
+{
+public:
+	/**
+	 * @param dly_range_ms max delay time
+	 * @param use_psram place the delay buffer in PSRAM, if no PSRAM is found the time is
+	 * 				limited to 800ms (float storage) or 1600ms (16bit storage)
+	 * @param storage delay line sample format, 16bit formats double the delay time for the same memory
+	 */
+	AudioEffectMultitapDelay_F32(uint32_t dly_range_ms=2000, bool use_psram=true, delay_storage_t storage=DELAY_STORAGE_F32);
+	AudioEffectMultitapDelay_F32(const AudioSettings_F32 &settings, uint32_t dly_range_ms=2000, bool use_psram=true, delay_storage_t storage=DELAY_STORAGE_F32);
+	~AudioEffectMultitapDelay_F32(){};
+	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
+	/**
+	 * @brief enable or disable a tap
+	 *
+	 * @param t tap number 0-7
+	 * @param state true = active
+	 */
+	void tap_enable(uint8_t t, bool state)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		__disable_irq();
+		taps[t].active = state;
+		__enable_irq();
+		tempo_update();
+	}
+	bool tap_enabled(uint8_t t) { return t < MULTITAP_MAX_TAPS ? taps[t].active : false; }
+	/**
+	 * @brief set the tap time in ms, disables the tempo sync for this tap
+	 *
+	 * @param t tap number 0-7
+	 * @param ms delay time
+	 */
+	void tap_time(uint8_t t, float32_t ms)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		ms = ms < 0.0f ? 0.0f : ms;
+		taps[t].div = 0.0f;
+		tap_setDelay(t, ms * 0.001f * fs);
+		tempo_update();
+	}
+	/**
+	 * @brief tap time in samples, disables the tempo sync for this tap
+	 *
+	 * @param t tap number 0-7
+	 * @param samples range is from the minimum delay (1 audio block) to the max delay
+	 */
+	void tap_delay(uint8_t t, uint32_t samples)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		taps[t].div = 0.0f;
+		tap_setDelay(t, samples);
+		tempo_update();
+	}
+	/**
+	 * @brief sync the tap time to the tempo
+	 *
+	 * @param t tap number 0-7
+	 * @param div fraction of the quarter note, ie. MULTITAP_DIV_8TH_DOT
+	 */
+	void tap_division(uint8_t t, float32_t div)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		taps[t].div = div < 0.0f ? 0.0f : div;
+		tempo_update();
+	}
+	/**
+	 * @brief tap output level
+	 *
+	 * @param t tap number 0-7
+	 * @param l 0.0f-1.0f range
+	 */
+	void tap_level(uint8_t t, float32_t l)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		taps[t].level = constrain(l, 0.0f, 1.0f);
+		tap_gains(t);
+	}
+	/**
+	 * @brief tap panorama
+	 *
+	 * @param t tap number 0-7
+	 * @param p 0.0f = left, 0.5f = center, 1.0f = right
+	 */
+	void tap_pan(uint8_t t, float32_t p)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		taps[t].pan = constrain(p, 0.0f, 1.0f);
+		tap_gains(t);
+	}
+	/**
+	 * @brief tap lowpass filter
+	 *
+	 * @param t tap number 0-7
+	 * @param n 0.0f-1.0f range, 1.0f = filter off
+	 */
+	void tap_tone(uint8_t t, float32_t n)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		n = constrain(n, 0.0f, 1.0f);
+		n = map(n*n, 0.0f, 1.0f, onepole_coeff_fs(TONE_MIN_FREQ, fs), 1.0f);
+		__disable_irq();
+		taps[t].lp_k = n;
+		__enable_irq();
+	}
+	/**
+	 * @brief set the tempo in beats per minute (quarter notes)
+	 */
+	void tempo_bpm(float32_t bpm)
+	{
+		if (bpm <= 0.0f) return;
+		beat = (60.0f / bpm) * fs;
+		tempo_update();
+	}
+	float32_t tempo_bpm_get() { return beat > 0.0f ? 60.0f * fs / beat : 0.0f; }
+	/**
+	 * @brief tap tempo, to be called on each button press
+	 * 			The tempo is limited so the longest synced tap fits into the buffer
+	 *
+	 * @param avg average the taps
+	 * @return uint32_t new tempo in samples, 0 on the first tap
+	 */
+	uint32_t tap_tempo(bool avg=true)
+	{
+		uint32_t tempo_ticks;
+		float32_t d = div_max > 0.0f ? div_max : 1.0f;
+		if (tapTempo.tap(&tempo_ticks, (uint32_t)((float32_t)dly_time_max / d), avg))
+		{
+			beat = tempo_ticks;
+			tempo_update();
+		}
+		return tempo_ticks;
+	}
+	/**
+	 * @brief Amount of repeats
+	 *
+	 * @param n 0.0f-1.0f range
+	 */
+	void feedback(float n)
+    {
+		float32_t fb, attn;
+        n = constrain(n, 0.0f, 1.0f);
+	    fb = map(n, 0.0f, 1.0f, 0.0f, feedb_max);
+        attn = map(n*n*n, 0.0f, 1.0f, 1.0f, 0.4f);
+        __disable_irq();
+        feedb = fb;
+        inputGainSet = attn;
+		inputGain_tmp = attn;
+        __enable_irq();
+    }
+	/**
+	 * @brief select the tap sent back to the input
+	 *
+	 * @param t tap number 0-7
+	 */
+	void feedback_tap(uint8_t t)
+	{
+		if (t >= MULTITAP_MAX_TAPS) return;
+		__disable_irq();
+		fb_tap = t;
+		__enable_irq();
+	}
+	/**
+	 * @brief How fast the tap times are updated
+	 *
+	 * @param n 0.0f-1.0f range, 0 - fastest update
+	 */
+	void inertia(float n)
+	{
+		n = constrain(n, 0.0f, 1.0f);
+		n = 2.0f * n - (n*n);
+        n = map (n, 0.0f, 1.0f, 10.0f, 0.3f) * (fs / AUDIO_SAMPLE_RATE_EXACT);
+        __disable_irq();
+        dly_time_step = n;
+        __enable_irq();
+	}
+	/**
+	 * @brief Treble loss control (darkens the repeats)
+	 *
+	 * @param n 0.0f-1.0f range
+	 */
+    void treble_cut(float n)
+    {
+        n = 1.0f - constrain(n, 0.0f, 1.0f);
+		__disable_irq();
+        trebleCut_k = n;
+		__enable_irq();
+    }
+	/**
+	 * @brief Bass loss (repeats will loose low end)
+	 *
+	 * @param n 0.0f-1.0f range
+	 */
+    void bass_cut(float n)
+    {
+        n = constrain(n, 0.0f, 1.0f);
+        n = 2.0f * n - (n*n);
+        __disable_irq();
+        bassCut_k = -n;
+        __enable_irq();
+    }
+	/**
+	 * @brief dry/wet mixer
+	 * 		0 = dry only, 1=wet only
+	 *
+	 * @param m 0.0f-1-0f range
+	 */
+    void mix(float m)
+    {
+		float32_t dry, wet;
+		m = constrain(m, 0.0f, 1.0f);
+		mix_pwr(m, &wet, &dry);
+		__disable_irq();
+		wet_gain = wet;
+		dry_gain = dry;
+		__enable_irq();
+	}
+
+	void bypass_setMode(bypass_mode_t m)
+	{
+		if (m <= BYPASS_MODE_TRAILS) bp_mode = m;
+	}
+	bypass_mode_t bypass_geMode() {return bp_mode;}
+	bool bypass_get(void) {return bp;}
+    void bypass_set(bool state)
+	{
+		if (bp == state) return;
+		bp = state;
+		if (!bp)
+		{
+			__disable_irq();
+			inputGainSet = inputGain_tmp;
+			__enable_irq();
+		}
+	}
+    bool bypass_tgl(void)
+    {
+		bypass_set(bp ^ 1);
+        return bp;
+    }
+	bool is_initialized() {return initialized;}
+	/**
+	 * @brief allocate the delay buffers again with the constructor settings,
+	 * 			ie. after the memory arena was released
+	 */
+	bool mem_realloc()
+	{
+		begin(cfg_range_ms, cfg_psram, cfg_storage);
+		return initialized;
+	}
+private:
+	void bypass_update();
+	audio_block_f32_t *inputQueueArray[2];
+	static constexpr float32_t TONE_MIN_FREQ = 0.03f;	// one pole coeff at 44.1kHz
+	typedef struct
+	{
+		bool active;
+		float32_t div;				// tempo fraction, 0 = free time
+		float32_t dly_set;			// target delay in samples
+		float32_t dly;				// current delay
+		float32_t level;
+		float32_t pan;
+		float32_t gainL_set, gainR_set;
+		float32_t gainL, gainR;		// smoothed output gains
+		float32_t lp_k;				// lowpass coefficient
+		float32_t lp_reg;
+	}tap_t;
+	tap_t taps[MULTITAP_MAX_TAPS];
+
+	AudioBasicDelay dly;
+	uint32_t dly_length;
+	uint32_t dly_time_min;
+	uint32_t dly_time_max;
+	float32_t dly_time_step = 10.0f;
+	float32_t beat;					// tempo in samples
+	float32_t div_max = 1.0f;		// longest synced tap
+
+	// block buffers, internal RAM
+	float32_t tap_buf[MULTITAP_STAGE_LEN];		// staged read window
+	float32_t tap_out[AUDIO_BLOCK_SAMPLES];		// tap output
+	float32_t fb_buf[AUDIO_BLOCK_SAMPLES];		// feedback tap output
+	float32_t wr_buf[AUDIO_BLOCK_SAMPLES];		// new samples for the delay line
+	float32_t wetL[AUDIO_BLOCK_SAMPLES];
+	float32_t wetR[AUDIO_BLOCK_SAMPLES];
+
+	AudioFilterShelvingLPHP flt_fb;
+	float32_t trebleCut_k = 1.0f;
+	float32_t bassCut_k = 0.0f;
+
+	static constexpr float32_t feedb_max = 0.96f;
+	uint8_t fb_tap = MULTITAP_MAX_TAPS-1;
+	float32_t feedb = 0.0f;
+    float32_t wet_gain;
+    float32_t dry_gain;
+	float32_t inputGainSet = 1.0f;
+	float32_t inputGain = 1.0f;
+	float32_t inputGain_tmp = 1.0f;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
+
+	bool psram_mode;
+	bool bp = true;
+	bypass_mode_t bp_mode = BYPASS_MODE_TRAILS;
+	bool cleanup_done = false;
+	bool initialized = false;
+	uint32_t cfg_range_ms;
+	bool cfg_psram;
+	delay_storage_t cfg_storage;
+
+	AudioBasicTapTempo tapTempo;
+
+	void begin(uint32_t dly_range_ms, bool use_psram, delay_storage_t storage);
+	void tap_setDelay(uint8_t t, float32_t samples)
+	{
+		samples = constrain(samples, (float32_t)dly_time_min, (float32_t)dly_time_max);
+		__disable_irq();
+		taps[t].dly_set = samples;
+		__enable_irq();
+	}
+	void tap_gains(uint8_t t)
+	{
+		float32_t gL, gR;
+		mix_pwr(taps[t].pan, &gR, &gL);
+		gL *= taps[t].level;
+		gR *= taps[t].level;
+		__disable_irq();
+		taps[t].gainL_set = gL;
+		taps[t].gainR_set = gR;
+		__enable_irq();
+	}
+	void tempo_update();
+	void tap_render(tap_t *tp, float32_t *dst, uint32_t len);
+	static const uint32_t memCleanupStep = 4096*sizeof(float32_t);	// bytes cleared per update
+	AudioBasicMemCleaner memCleaner;
+};
+
+#endif // _EFFECT_MULTITAPDELAY_H_
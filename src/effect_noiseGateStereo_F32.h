@@ -8,6 +8,9 @@
  * 
  * 03.2024 - stereo version with optional side chain input via pointers
  * 	by Piotr Zapart (www.hexefx.com)
+ * 10.2024 - side chain inputs 2 and 3, no block allocation,
+ * 	block rate envelope with interpolated gain,
+ * 	expander mode, hysteresis and lookahead
  */
 
 #ifndef _AudioEffectNoiseGateStereo_F32_h
@@ -15,6 +18,12 @@
 
 #include <arm_math.h> //ARM DSP extensions.  for speed!
 #include <AudioStream_F32.h>
+#include "basic_denormal.h"
+#include "basic_DSPutils.h"
+#include "basic_fastMath.h"
+#include "basic_memArena.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
 
 // ranges used for normalized param settings
 #define NOISEGATE_THRES_MIN		(0.0f)
@@ -26,16 +35,33 @@
 #define NOISEGATE_CLOSET_MIN	(0.001f)
 #define NOISEGATE_CLOSET_MAX	(0.1f)
 
-class AudioEffectNoiseGateStereo_F32 : public AudioStream_F32
+#define NOISEGATE_ENV_DECIM		(8)		// samples per envelope step
+#define NOISEGATE_LOOKAHEAD_MAX_MS	(5.0f)
+
+/**
+ * @brief Stereo noise gate
+ * 		Inputs:	0, 1 - audio L, R
+ * 				2, 3 - side chain L, R, the blocks are read without copying,
+ * 						a single connected side chain input is used for both channels
+ * 		With no side chain input connected the gate uses the pointers passed to
+ * 		the constructor, with none of them it is keyed by the audio input.
+ * 		The envelope runs at the block rate / NOISEGATE_ENV_DECIM: side chain peak
+ * 		per NOISEGATE_ENV_DECIM samples -> threshold, hold -> opening/closing smoother,
+ * 		the gain is interpolated linearly between the envelope steps.
+ * 		The same detector pass drives the gate or the downward expander (setExpanderRatio),
+ * 		opening and closing thresholds are split by the hysteresis, optional lookahead
+ * 		delays the audio to let the gate open before the transient.
+ */
+class AudioEffectNoiseGateStereo_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
-	AudioEffectNoiseGateStereo_F32(float32_t* sideChainSrcL, float32_t* sideChainSrcR) : AudioStream_F32(2, inputQueueArray_f32)
+	AudioEffectNoiseGateStereo_F32(float32_t* sideChainSrcL=NULL, float32_t* sideChainSrcR=NULL) : AudioStream_F32(4, inputQueueArray_f32)
 	{
 		p_sideChain_inL = sideChainSrcL;
 		p_sideChain_inR = sideChainSrcR;
 		setDefaults();
 	};
-	AudioEffectNoiseGateStereo_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32) 
+	AudioEffectNoiseGateStereo_F32(const AudioSettings_F32 &settings) : AudioStream_F32(4, inputQueueArray_f32) 
 	{ 
 		fs = settings.sample_rate_Hz;
 		setDefaults(); 
@@ -43,66 +69,61 @@ public:
 
 	void update(void)
 	{
-		audio_block_f32_t *blockL, *blockR, *blockSideCh, *blockGain;
-		audio_block_f32_t *blockOutL, *blockOutR;
+		audio_block_f32_t *blockL, *blockR, *blockScL, *blockScR;
+		float32_t *scL, *scR;
 
-		blockL = AudioStream_F32::receiveReadOnly_f32(0);
-		blockR = AudioStream_F32::receiveReadOnly_f32(1);
-		// no input signal
-		if (!blockL || !blockR)
-		{
-			if (blockL) AudioStream_F32::release(blockL);
-			if (blockR) AudioStream_F32::release(blockR);
-			return;
-		}
+		blockScL = AudioStream_F32::receiveReadOnly_f32(2);
+		blockScR = AudioStream_F32::receiveReadOnly_f32(3);
 		if (bp)
 		{
+			if (blockScL) AudioStream_F32::release(blockScL);
+			if (blockScR) AudioStream_F32::release(blockScR);
+			blockL = AudioStream_F32::receiveReadOnly_f32(0);
+			blockR = AudioStream_F32::receiveReadOnly_f32(1);
+			bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
 			AudioStream_F32::transmit(blockL, 0);	
 			AudioStream_F32::transmit(blockR, 1);
 			AudioStream_F32::release(blockL);
 			AudioStream_F32::release(blockR);
 			return;
 		}
-
-		blockSideCh = AudioStream_F32::allocate_f32();			// allocate new block for summed L+R
-		blockGain = AudioStream_F32::allocate_f32();			// create a new audio block for the gain	
-		if (!p_sideChain_inL || !p_sideChain_inR || !blockSideCh || !blockGain) 
+		blockL = AudioStream_F32::receiveWritable_f32(0);
+		blockR = AudioStream_F32::receiveWritable_f32(1);
+		// no input signal
+		if (!blockL || !blockR)
 		{
-			if (blockSideCh) AudioStream_F32::release(blockSideCh);
-			if (blockGain) AudioStream_F32::release(blockGain);		
-			AudioStream_F32::transmit(blockL, 0);
-			AudioStream_F32::transmit(blockR, 1);
-			AudioStream_F32::release(blockL);
-			AudioStream_F32::release(blockR);
+			if (blockL) AudioStream_F32::release(blockL);
+			if (blockR) AudioStream_F32::release(blockR);
+			if (blockScL) AudioStream_F32::release(blockScL);
+			if (blockScR) AudioStream_F32::release(blockScR);
 			return;
 		}
-		blockOutL = AudioStream_F32::allocate_f32();
-		blockOutR = AudioStream_F32::allocate_f32();
-		if (!blockOutL || !blockOutR)
+		if (blockScL || blockScR)
 		{
-			if (blockOutL) AudioStream_F32::release(blockOutL);
-			if (blockOutR)  AudioStream_F32::release(blockOutR);
-			return;
-		}		
-		//sum L + R
-		arm_add_f32(p_sideChain_inL, p_sideChain_inR, blockSideCh->data, blockSideCh->length);
-		arm_scale_f32(blockSideCh->data, sideChain_gain * 0.5f, blockSideCh->data, blockSideCh->length); // divide by 2
-		
-		calcGain(blockSideCh, blockGain);
-		calcSmoothedGain(blockGain);
-
-		arm_mult_f32(blockGain->data, blockL->data, blockOutL->data, blockOutL->length);
-		arm_mult_f32(blockGain->data, blockR->data, blockOutR->data, blockOutR->length);
-
-		AudioStream_F32::release(blockGain);
-		AudioStream_F32::release(blockSideCh);
-
-		AudioStream_F32::transmit(blockOutL, 0);
-		AudioStream_F32::transmit(blockOutR, 1);
+			scL = blockScL ? blockScL->data : blockScR->data;
+			scR = blockScR ? blockScR->data : blockScL->data;
+		}
+		else
+		{
+			scL = p_sideChain_inL ? p_sideChain_inL : blockL->data;
+			scR = p_sideChain_inR ? p_sideChain_inR : blockR->data;
+		}
+		gate(blockL->data, blockR->data, scL, scR, blockL->length);
+		if (blockScL) AudioStream_F32::release(blockScL);
+		if (blockScR) AudioStream_F32::release(blockScR);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
 		AudioStream_F32::release(blockL);
 		AudioStream_F32::release(blockR);
-		AudioStream_F32::release(blockOutL);
-		AudioStream_F32::release(blockOutR);
+	}
+	/**
+	 * @brief in place processing, side chain from the pointers or the input itself
+	 */
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len)
+	{
+		if (bp) return;
+		gate(dataL, dataR, p_sideChain_inL ? p_sideChain_inL : dataL,
+						   p_sideChain_inR ? p_sideChain_inR : dataR, len);
 	}
 
 	/**
@@ -115,18 +136,21 @@ public:
 	{
 		if (dbfs < -99.0f) 	bp = true;
 		else 				bp = false;
-		// convert dbFS to linear value to comapre against later
-		linearThreshold = pow10f(dbfs / 20.0f);
+		threshold_dB = dbfs;
+		thresholds_update();
 	}
 	void setThreshold_normalized(float dbfs)
 	{
 		dbfs = map_sat(dbfs, 0.0f, 1.0f, NOISEGATE_THRES_MIN, NOISEGATE_THRES_MAX);
 		setThreshold(dbfs);
 	}
-
+	/**
+	 * @brief the smoothing coefficients are calculated for the envelope step,
+	 * 		the response time is the same as with per sample smoothing
+	 */
 	void setOpeningTime(float timeInSeconds)
 	{
-		openingTimeConst = expf(-1.0f / (timeInSeconds * fs));
+		openingTimeConst = expf(-(float32_t)NOISEGATE_ENV_DECIM / (timeInSeconds * fs));
 	}
 	void setOpeningTime_normalized(float time)
 	{
@@ -136,7 +160,7 @@ public:
 
 	void setClosingTime(float timeInSeconds)
 	{
-		closingTimeConst = expf(-1.0f / (timeInSeconds * fs));
+		closingTimeConst = expf(-(float32_t)NOISEGATE_ENV_DECIM / (timeInSeconds * fs));
 	}
 	void setClosingTime_normalized(float time)
 	{
@@ -157,17 +181,90 @@ public:
 	{
 		sideChain_gain = g;
 	}
+	/**
+	 * @brief hysteresis, the gate opens at the threshold and closes
+	 * 		at the threshold - hysteresis
+	 * 
+	 * @param dB hysteresis in dB, 0 = off (default)
+	 */
+	void setHysteresis_dB(float32_t dB)
+	{
+		hysteresis_dB = max(dB, 0.0f);
+		thresholds_update();
+	}
+	/**
+	 * @brief downward expander mode, the signal below the threshold is attenuated
+	 * 		by (ratio-1) dB per dB instead of muted
+	 * 
+	 * @param r expansion ratio >= 1.0, negative value = hard gate (default)
+	 */
+	void setExpanderRatio(float32_t r)
+	{
+		expRatio = r < 0.0f ? -1.0f : max(r, 1.0f);
+	}
+	/**
+	 * @brief lookahead time, the audio is delayed by the same amount
+	 * 		The delay lines are allocated on the first use and cleared
+	 * 		when the lookahead is switched on or changed.
+	 * 
+	 * @param ms lookahead time 0.0 (off) to NOISEGATE_LOOKAHEAD_MAX_MS
+	 * @return false if there is no memory for the delay lines
+	 */
+	bool setLookahead_ms(float32_t ms)
+	{
+		ms = constrain(ms, 0.0f, NOISEGATE_LOOKAHEAD_MAX_MS);
+		uint32_t samples = (uint32_t)(ms * 0.001f * fs + 0.5f);
+		if (samples && !la_dlyL)
+		{
+			// power of 2 size covering the maximum delay
+			uint32_t sz = 2;
+			while (sz < (uint32_t)(NOISEGATE_LOOKAHEAD_MAX_MS * 0.001f * fs) + 2) sz <<= 1;
+			AudioBasicMemArenaOwner memOwner(this, "NoiseGate");
+			float32_t *dly = (float32_t *)AudioBasicMemArena::alloc(sz * 2 * sizeof(float32_t), ARENA_RAM1);
+			if (!dly) return false;
+			__disable_irq();
+			la_mask = sz - 1;
+			la_dlyL = dly;
+			la_dlyR = dly + sz;
+			__enable_irq();
+		}
+		__disable_irq();
+		if (samples && samples != la_samples)
+		{
+			// new delay length, clear the old audio
+			memset(la_dlyL, 0, (la_mask + 1) * 2 * sizeof(float32_t));
+			la_idx = 0;
+		}
+		la_samples = samples;
+		la_ms = ms;
+		__enable_irq();
+		return true;
+	}
+	float32_t getLookahead_ms(void) { return la_ms; }
+	/**
+	 * @brief allocate the lookahead buffers again, ie. after the memory arena was released
+	 */
+	bool mem_realloc()
+	{
+		__disable_irq();
+		la_samples = 0;
+		AudioBasicMemArena::free(la_dlyL);
+		la_dlyL = la_dlyR = NULL;
+		__enable_irq();
+		return setLookahead_ms(la_ms);
+	}
 
 	bool infoIsOpen()
 	{
 		return _isOpenDisplay;
 	}
- void bypass_set(bool state) 
+	void bypass_set(bool state) 
 	{
 		__disable_irq();
 		bp = state;
 		__enable_irq();
 	}
+	bool bypass_get(void) {return bp;}
     bool bypass_tgl(void) 
     {
 		bool bp_new = bp ^ 1;
@@ -181,83 +278,121 @@ private:
 	float32_t* p_sideChain_inL = NULL;
 	float32_t* p_sideChain_inR = NULL;
 	float32_t sideChain_gain = 1.0f;;
-	float32_t linearThreshold;
-	float32_t prev_gain_dB = 0;
+	float32_t threshold_dB = -100.0f;
+	float32_t hysteresis_dB = 0.0f;
+	float32_t linearThreshold;				// opening threshold
+	float32_t linearThresholdClose;			// closing threshold
+	float32_t expRatio = -1.0f;				// expansion ratio, negative = gate
+	float32_t gain = 0.0f;					// smoothed gain at the last envelope step
 	float32_t openingTimeConst, closingTimeConst;
-	float32_t lastGainBlockValue = 0;
-	int32_t counter, holdTimeNumSamples = 0;
+	int32_t holdCounter = 0, holdTimeNumSamples = 0;
 	audio_block_f32_t *inputQueueArray_f32[4];
-	bool falling = false;
+	float32_t *la_dlyL = NULL;				// lookahead delay lines
+	float32_t *la_dlyR = NULL;
+	uint32_t la_samples = 0;				// lookahead delay, 0 = off
+	uint32_t la_mask = 0;					// buffer size - 1
+	uint32_t la_idx = 0;					// delay write index
+	float32_t la_ms = 0.0f;
 	bool bp = false;
-	bool _isOpen = false;
+	bool gateOpen = false;					// detector state
 	bool _isOpenDisplay = false;
 
+	void thresholds_update()
+	{
+		float32_t thrOpen = fast_dB2lin(threshold_dB);
+		float32_t thrClose = fast_dB2lin(threshold_dB - hysteresis_dB);
+		__disable_irq();
+		linearThreshold = thrOpen;
+		linearThresholdClose = thrClose;
+		__enable_irq();
+	}
+
 	void setDefaults()
 	{
 		setOpeningTime(0.01f);
 		setClosingTime(0.05f);
 		setHoldTime(0.01f);
+		thresholds_update();
 	}
 
-	void calcGain(audio_block_f32_t *input, audio_block_f32_t *gainBlock)
+	/**
+	 * @brief envelope and gain in a single pass, one envelope step per NOISEGATE_ENV_DECIM samples
+	 * 		the side chain can be the same buffer as the audio
+	 * 		gate: target gain 1 above the threshold or during the hold, 0 below
+	 * 		expander: below the threshold the target gain follows the side chain level
+	 */
+	void gate(float32_t *dataL, float32_t *dataR, const float32_t *scL, const float32_t *scR, uint32_t len)
 	{
-		_isOpen = false;
-		for (int i = 0; i < input->length; i++)
-		{
-			// take absolute value and compare it to the set threshold
-			bool isAboveThres = abs(input->data[i]) > linearThreshold;
-			_isOpen |= isAboveThres;
-			// if above the threshold set volume to 1 otherwise to 0, we did not account for holdtime
-			gainBlock->data[i] = isAboveThres ? 1 : 0;
+		AudioBasicDenormalGuard ftz;
+		const float32_t scale = fabsf(sideChain_gain * 0.5f);
+		const float32_t thrOpen = linearThreshold;
+		const float32_t thrClose = linearThresholdClose;
+		const float32_t expK = expRatio - 1.0f;
+		const float32_t thr_dB = threshold_dB;
+		const uint32_t D = la_samples;
+		const uint32_t mask = la_mask;
+		float32_t *dlyL = la_dlyL, *dlyR = la_dlyR;
+		float32_t peak, target, g, g_new, g_step, l, r;
+		uint32_t i = 0, j, n, idx = la_idx;
+		bool isOpen = false;
 
-			// if we are falling and are above the threshold, the level is not falling
-			if (falling & isAboveThres)
+		g = gain;
+		while (i < len)
+		{
+			n = min(len - i, (uint32_t)NOISEGATE_ENV_DECIM);
+			// side chain peak, (L+R)/2
+			peak = 0.0f;
+			for (j = i; j < i + n; j++) peak = max(peak, fabsf(scL[j] + scR[j]));
+			peak *= scale;
+			// threshold with hysteresis and hold
+			gateOpen = peak > (gateOpen ? thrClose : thrOpen);
+			if (gateOpen)
+			{
+				holdCounter = holdTimeNumSamples;
+				isOpen = true;
+				target = 1.0f;
+			}
+			else if (holdCounter > 0)
 			{
-				falling = false;
+				holdCounter -= n;
+				target = 1.0f;
 			}
-			// if we have a falling signal
-			if (falling || lastGainBlockValue > gainBlock->data[i])
+			else if (expK < 0.0f) target = 0.0f;
+			else target = fast_dB2lin((fast_lin2dB(peak) - thr_dB) * expK);
+			// opening/closing smoother, one step
+			if (target > g)	g_new = openingTimeConst * g + (1.0f - openingTimeConst) * target;
+			else			g_new = denormal_bias(closingTimeConst * g + (1.0f - closingTimeConst) * target);
+			// interpolated gain
+			g_step = (g_new - g) / (float32_t)n;
+			if (D)
 			{
-				// check whether the hold time is not reached
-				if (counter < holdTimeNumSamples)
+				for (j = i; j < i + n; j++)
 				{
-					// signal is (still) falling
-					falling = true;
-					counter++;
-					gainBlock->data[i] = 1.0f;
+					g += g_step;
+					dlyL[idx] = dataL[j];
+					dlyR[idx] = dataR[j];
+					l = dlyL[(idx - D) & mask];
+					r = dlyR[(idx - D) & mask];
+					idx = (idx + 1) & mask;
+					dataL[j] = l * g;
+					dataR[j] = r * g;
 				}
-				// otherwise the signal is already muted due to the line: "gainBlock->data[i] = isAboveThres ? 1 : 0;"
-			}
-			// note the last gain value, so we can compare it if the signal is falling in the next sample
-			lastGainBlockValue = gainBlock->data[i];
-		}
-		// note the display value
-		_isOpenDisplay = _isOpen;
-	};
-
-	// this method applies the "opening" and "closing" constants to smooth the
-	// target gain level through time.
-	void calcSmoothedGain(audio_block_f32_t *gain_block)
-	{
-		float32_t gain;
-		float32_t one_minus_opening_const = 1.0f - openingTimeConst;
-		float32_t one_minus_closing_const = 1.0f - closingTimeConst;
-		for (int i = 0; i < gain_block->length; i++)
-		{
-			gain = gain_block->data[i];
-			// smooth the gain using the opening or closing constants
-			if (gain > prev_gain_dB)
-			{ // are we in the opening phase?
-				gain_block->data[i] = openingTimeConst * prev_gain_dB + one_minus_opening_const * gain;
 			}
 			else
-			{ // or, we're in the closing phase
-				gain_block->data[i] = closingTimeConst * prev_gain_dB + one_minus_closing_const * gain;
+			{
+				for (j = i; j < i + n; j++)
+				{
+					g += g_step;
+					dataL[j] *= g;
+					dataR[j] *= g;
+				}
 			}
-			// save value for the next time through this loop
-			prev_gain_dB = gain_block->data[i];
+			g = g_new;
+			i += n;
 		}
-		return; // the output here is gain_block
+		gain = g;
+		la_idx = idx;
+		_isOpenDisplay = isOpen;
 	}
 };
 
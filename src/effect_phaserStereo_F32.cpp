@@ -42,10 +42,8 @@ extern const uint16_t AudioWaveformHyperTri[];
 
 AudioEffectPhaserStereo_F32::AudioEffectPhaserStereo_F32() : AudioStream_F32(3, inputQueueArray_f32)
 {
-	memset(allpass_x, 0, PHASER_STEREO_STAGES * sizeof(float32_t) * 2);
-	memset(allpass_y, 0, PHASER_STEREO_STAGES * sizeof(float32_t) * 2);
+	memset(&hot, 0, sizeof(hot));
     bps = false;
-    lfo_phase_acc = 0;
     lfo_add = 0;
     lfo_lrphase = 0.0f;
     lfo_lroffset = 0;
@@ -61,12 +59,13 @@ AudioEffectPhaserStereo_F32::~AudioEffectPhaserStereo_F32()
 void AudioEffectPhaserStereo_F32::update()
 {
 #if defined(__IMXRT1062__)
+    AudioBasicDenormalGuard ftz;
     audio_block_f32_t *blockL, *blockR; 
     const audio_block_f32_t *blockMod;    // inputs
     bool internalLFO = false;                    // use internal LFO of no modulation input
     uint16_t i = 0;
     float32_t modSigL, modSigR;
-    uint32_t phaseAcc = lfo_phase_acc;
+    uint32_t phaseAcc = hot.lfo_phase_acc;
     uint32_t phaseAdd = lfo_add;
     float32_t _lfo_scaler = lfo_scaler;
     float32_t _lfo_bias = lfo_bias;
@@ -75,24 +74,29 @@ void AudioEffectPhaserStereo_F32::update()
     float32_t inSigL, drySigL, inSigR, drySigR;
     float32_t fdb = feedb;
 
-    blockL = AudioStream_F32::receiveWritable_f32(0);       // audio data
-    blockR = AudioStream_F32::receiveWritable_f32(1);       // audio data
     blockMod = AudioStream_F32::receiveReadOnly_f32(2);      // bipolar/int16_t control input
-    
-    if (!blockL || !blockR)
-    {
-        if (blockMod) AudioStream_F32::release((audio_block_f32_t *)blockMod);
-        return;
-    }
     if (!blockMod)  internalLFO = true;         // no modulation input provided -> use internal LFO
-    if (bps)
+    if (bps)    // pass the read only blocks
     {
+        blockL = AudioStream_F32::receiveReadOnly_f32(0);
+        blockR = AudioStream_F32::receiveReadOnly_f32(1);
+        bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);
         AudioStream_F32::transmit((audio_block_f32_t *)blockL,0);
         AudioStream_F32::transmit((audio_block_f32_t *)blockR,1);
         AudioStream_F32::release((audio_block_f32_t *)blockL);
         AudioStream_F32::release((audio_block_f32_t *)blockR);
         if (blockMod) AudioStream_F32::release((audio_block_f32_t *)blockMod);
         return;
+    }
+    blockL = AudioStream_F32::receiveWritable_f32(0);       // audio data
+    blockR = AudioStream_F32::receiveWritable_f32(1);       // audio data
+    
+    if (!blockL || !blockR)
+    {
+        if (blockL) AudioStream_F32::release(blockL);
+        if (blockR) AudioStream_F32::release(blockR);
+        if (blockMod) AudioStream_F32::release((audio_block_f32_t *)blockMod);
+        return;
     }
 	for (i=0; i < blockL->length; i++) 
     {
@@ -128,33 +132,33 @@ void AudioEffectPhaserStereo_F32::update()
         modSigR = modSigR * _lfo_scaler + _lfo_bias;
 
         drySigL = blockL->data[i] * (1.0f - abs(fdb)*0.25f);  // attenuate the input if using feedback
-        inSigL = drySigL + last_sampleL * fdb;
+        inSigL = denormal_bias(drySigL + hot.last_sampleL * fdb);
         drySigR = blockR->data[i] * (1.0f - abs(fdb)*0.25f);
-        inSigR = drySigR + last_sampleR * fdb;
+        inSigR = denormal_bias(drySigR + hot.last_sampleR * fdb);
 
         y0 = stg;
         while (y0)  // process allpass filters in pairs
         {
             y0--;
-		    allpass_y[0][y0] = modSigL * (allpass_y[0][y0] + inSigL) - allpass_x[0][y0];    // left channel
-		    allpass_x[0][y0] = inSigL;
-		    allpass_y[1][y0] = modSigR * (allpass_y[1][y0] + inSigR) - allpass_x[1][y0];    // right channel
-		    allpass_x[1][y0] = inSigR;
+		    hot.allpass_y[0][y0] = modSigL * (hot.allpass_y[0][y0] + inSigL) - hot.allpass_x[0][y0];    // left channel
+		    hot.allpass_x[0][y0] = inSigL;
+		    hot.allpass_y[1][y0] = modSigR * (hot.allpass_y[1][y0] + inSigR) - hot.allpass_x[1][y0];    // right channel
+		    hot.allpass_x[1][y0] = inSigR;
             y0--;
-		    allpass_y[0][y0] = modSigL * (allpass_y[0][y0] + allpass_y[0][y0+1]) - allpass_x[0][y0];
-		    allpass_x[0][y0] = allpass_y[0][y0+1];
-            inSigL = allpass_y[0][y0];
-            allpass_y[1][y0] = modSigR * (allpass_y[1][y0] + allpass_y[1][y0+1]) - allpass_x[1][y0];
-		    allpass_x[1][y0] = allpass_y[1][y0+1];
-            inSigR = allpass_y[1][y0];
+		    hot.allpass_y[0][y0] = modSigL * (hot.allpass_y[0][y0] + hot.allpass_y[0][y0+1]) - hot.allpass_x[0][y0];
+		    hot.allpass_x[0][y0] = hot.allpass_y[0][y0+1];
+            inSigL = hot.allpass_y[0][y0];
+            hot.allpass_y[1][y0] = modSigR * (hot.allpass_y[1][y0] + hot.allpass_y[1][y0+1]) - hot.allpass_x[1][y0];
+		    hot.allpass_x[1][y0] = hot.allpass_y[1][y0+1];
+            inSigR = hot.allpass_y[1][y0];
         }
-        last_sampleL = inSigL;
-        last_sampleR = inSigR;
-        blockL->data[i] = drySigL * (1.0f - mix_ratio) + last_sampleL * mix_ratio;     // dry/wet mixer
-        blockR->data[i] = drySigR * (1.0f - mix_ratio) + last_sampleR * mix_ratio;     // dry/wet mixer
+        hot.last_sampleL = inSigL;
+        hot.last_sampleR = inSigR;
+        blockL->data[i] = drySigL * (1.0f - mix_ratio) + hot.last_sampleL * mix_ratio;     // dry/wet mixer
+        blockR->data[i] = drySigR * (1.0f - mix_ratio) + hot.last_sampleR * mix_ratio;     // dry/wet mixer
 
     }
-    lfo_phase_acc = phaseAcc;
+    hot.lfo_phase_acc = phaseAcc;
     AudioStream_F32::transmit(blockL, 0);
     AudioStream_F32::transmit(blockR, 1);
 	AudioStream_F32::release(blockL);
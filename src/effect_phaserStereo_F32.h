@@ -32,6 +32,9 @@
 #include "AudioStream.h"
 #include "AudioStream_F32.h"
 #include "arm_math.h"
+#include "basic_denormal.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_memArena.h"
 
 #define PHASER_STEREO_STAGES	12
 
@@ -39,6 +42,10 @@ class AudioEffectPhaserStereo_F32 : public AudioStream_F32
 {
     public:
     AudioEffectPhaserStereo_F32();
+    AudioEffectPhaserStereo_F32(const AudioSettings_F32 &settings) : AudioEffectPhaserStereo_F32()
+    {
+        fs = settings.sample_rate_Hz;
+    }
     ~AudioEffectPhaserStereo_F32();
     virtual void update();
 
@@ -108,9 +115,9 @@ class AudioEffectPhaserStereo_F32 : public AudioStream_F32
         b = constrain(btm, 0.0f, 1.0f);
         c = abs(a - b); // scaler
         a = min(a, b);  // bias
-        f_Hz = constrain(f_Hz, 0.0f, AUDIO_SAMPLE_RATE_EXACT/2);
+        f_Hz = constrain(f_Hz, 0.0f, fs/2);
         phase = constrain(phase, 0.0f, 1.0f);
-        add = f_Hz * (4294967296.0f / AUDIO_SAMPLE_RATE_EXACT);
+        add = f_Hz * (4294967296.0f / fs);
         bs = (uint8_t)(phase * 128.0f);
         __disable_irq();
         lfo_scaler = c;
@@ -138,8 +145,8 @@ class AudioEffectPhaserStereo_F32 : public AudioStream_F32
     {
         float32_t c;
         uint32_t add;
-        c = constrain(f_Hz, 0.0f, AUDIO_SAMPLE_RATE_EXACT/2);
-        add = c * (4294967296.0 / AUDIO_SAMPLE_RATE_EXACT);
+        c = constrain(f_Hz, 0.0f, fs/2);
+        add = c * (4294967296.0f / fs);
         __disable_irq();
         lfo_add = add;
         __enable_irq();
@@ -188,13 +195,17 @@ private:
     uint8_t stg;                                    // number of stages
     bool bps;                                       // bypass
     audio_block_f32_t *inputQueueArray_f32[3];      
-    float32_t allpass_x[2][PHASER_STEREO_STAGES];      // allpass inputs
-	float32_t allpass_y[2][PHASER_STEREO_STAGES];      // allpass outputs
+    // per sample state, one cache line aligned block separate from the parameters
+    struct ARENA_ALIGNED
+    {
+        float32_t allpass_x[2][PHASER_STEREO_STAGES];  // allpass inputs
+        float32_t allpass_y[2][PHASER_STEREO_STAGES];  // allpass outputs
+        float32_t last_sampleL;
+        float32_t last_sampleR;
+        uint32_t lfo_phase_acc;                     // interfnal lfo 
+    }hot;
 	float32_t mix_ratio;                            // 0 = dry. 1.0 = wet
     float32_t feedb;                                // feedback 
-    float32_t last_sampleL;
-    float32_t last_sampleR;
-    uint32_t lfo_phase_acc;                         // interfnal lfo 
     uint32_t lfo_add;
     float32_t lfo_lrphase;
     uint32_t lfo_lroffset;
@@ -202,6 +213,7 @@ private:
     float32_t lfo_bias;
 	float32_t lfo_top;
 	float32_t lfo_btm;
+    float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 };
 
 #endif // _EFFECT_PHASER_H
@@ -43,6 +43,8 @@
 
 bool AudioEffectPlateReverb_F32::begin()
 {
+	AudioBasicMemArenaOwner memOwner(this, "PlateReverb");
+	initialised = false;
 	inputGainSet = 0.5f;
     inputGain = 0.5f;
 	inputGain_tmp = 0.5f;
@@ -54,46 +56,60 @@ bool AudioEffectPlateReverb_F32::begin()
 	rv_time_k = 0.2f;
 	pitch_semit = 0;
 	pitchShim_semit = 0;
+	fs_k = fs / AUDIO_SAMPLE_RATE_EXACT;
 
-	if(!in_allp_1L.init(&in_allp_k)) return false;
-	if(!in_allp_2L.init(&in_allp_k)) return false;
-	if(!in_allp_3L.init(&in_allp_k)) return false;
-	if(!in_allp_4L.init(&in_allp_k)) return false;
+	if(!in_allp_1L.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_2L.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_3L.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_4L.init(&in_allp_k, fs_k)) return false;
 
-	if(!in_allp_1R.init(&in_allp_k)) return false;
-	if(!in_allp_2R.init(&in_allp_k)) return false;
-	if(!in_allp_3R.init(&in_allp_k)) return false;
-	if(!in_allp_4R.init(&in_allp_k)) return false;
+	if(!in_allp_1R.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_2R.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_3R.init(&in_allp_k, fs_k)) return false;
+	if(!in_allp_4R.init(&in_allp_k, fs_k)) return false;
 
 	in_allp_out_L = 0.0f;
     in_allp_out_R = 0.0f;
 
-	if(!lp_allp_1.init(&loop_allp_k)) return false;
-	if(!lp_allp_2.init(&loop_allp_k)) return false;
-	if(!lp_allp_3.init(&loop_allp_k)) return false;
-	if(!lp_allp_4.init(&loop_allp_k)) return false;
+	if(!lp_allp_1.init(&loop_allp_k, fs_k)) return false;
+	if(!lp_allp_2.init(&loop_allp_k, fs_k)) return false;
+	if(!lp_allp_3.init(&loop_allp_k, fs_k)) return false;
+	if(!lp_allp_4.init(&loop_allp_k, fs_k)) return false;
 
     lp_allp_out = 0.0f;
-
-	if(!lp_dly1.init(LP_DLY1_BUF_LEN)) return false;
-	if(!lp_dly2.init(LP_DLY2_BUF_LEN)) return false;
-	if(!lp_dly3.init(LP_DLY3_BUF_LEN)) return false;
-	if(!lp_dly4.init(LP_DLY4_BUF_LEN)) return false;
+	lp_dly1_offset_L = LP_DLY1_OFFSET_L * fs_k;
+	lp_dly2_offset_L = LP_DLY2_OFFSET_L * fs_k;
+	lp_dly3_offset_L = LP_DLY3_OFFSET_L * fs_k;
+	lp_dly4_offset_L = LP_DLY4_OFFSET_L * fs_k;
+	lp_dly1_offset_R = LP_DLY1_OFFSET_R * fs_k;
+	lp_dly2_offset_R = LP_DLY2_OFFSET_R * fs_k;
+	lp_dly3_offset_R = LP_DLY3_OFFSET_R * fs_k;
+	lp_dly4_offset_R = LP_DLY4_OFFSET_R * fs_k;
+	lfo1.setSampleRate(fs);
+	lfo2.setSampleRate(fs);
+	LFO_AMPL = LFO_AMPLset = LFO_AMPL_DEFAULT * fs_k;
+	lfo1.setDepth(LFO_AMPL);
+	lfo2.setDepth(LFO_AMPL);
+
+	if(!lp_dly1.init(LP_DLY1_BUF_LEN * fs_k)) return false;
+	if(!lp_dly2.init(LP_DLY2_BUF_LEN * fs_k)) return false;
+	if(!lp_dly3.init(LP_DLY3_BUF_LEN * fs_k)) return false;
+	if(!lp_dly4.init(LP_DLY4_BUF_LEN * fs_k)) return false;
 
     lp_hidamp_k = 1.0f;
     lp_lodamp_k = 0.0f;
-	flt1.init(BASS_LOSS_FREQ, &lp_lodamp_k, TREBLE_LOSS_FREQ, &lp_hidamp_k);
-	flt2.init(BASS_LOSS_FREQ, &lp_lodamp_k, TREBLE_LOSS_FREQ, &lp_hidamp_k);
-	flt3.init(BASS_LOSS_FREQ, &lp_lodamp_k, TREBLE_LOSS_FREQ, &lp_hidamp_k);
-	flt4.init(BASS_LOSS_FREQ, &lp_lodamp_k, TREBLE_LOSS_FREQ, &lp_hidamp_k);
+	flt1.init(onepole_coeff_fs(BASS_LOSS_FREQ, fs), &lp_lodamp_k, onepole_coeff_fs(TREBLE_LOSS_FREQ, fs), &lp_hidamp_k);
+	flt2.init(onepole_coeff_fs(BASS_LOSS_FREQ, fs), &lp_lodamp_k, onepole_coeff_fs(TREBLE_LOSS_FREQ, fs), &lp_hidamp_k);
+	flt3.init(onepole_coeff_fs(BASS_LOSS_FREQ, fs), &lp_lodamp_k, onepole_coeff_fs(TREBLE_LOSS_FREQ, fs), &lp_hidamp_k);
+	flt4.init(onepole_coeff_fs(BASS_LOSS_FREQ, fs), &lp_lodamp_k, onepole_coeff_fs(TREBLE_LOSS_FREQ, fs), &lp_hidamp_k);
 
 	master_lp_k = 1.0f;
 	master_hp_k = 0.0f;
-	flt_masterL.init(0.08f, &master_hp_k, 0.1f, &master_lp_k);
-	flt_masterR.init(0.08f, &master_hp_k, 0.1f, &master_lp_k);
+	flt_masterL.init(onepole_coeff_fs(0.08f, fs), &master_hp_k, onepole_coeff_fs(0.1f, fs), &master_lp_k);
+	flt_masterR.init(onepole_coeff_fs(0.08f, fs), &master_hp_k, onepole_coeff_fs(0.1f, fs), &master_lp_k);
 
-	if(!pitchL.init()) return false;
-	if(!pitchR.init()) return false;
+	if(!pitchL.init(fs)) return false;
+	if(!pitchR.init(fs)) return false;
 	pitchL.setPitch(1.0f); //natural pitch
 	pitchR.setPitch(1.0f); //natural pitch
 	pitchL.setTone(0.36f);
@@ -102,8 +118,8 @@ bool AudioEffectPlateReverb_F32::begin()
 	pitchR.setMix(0.0f);
 
 	shimmerRatio = 0.0f;
-	if(!pitchShimL.init()) return false;
-	if(!pitchShimR.init()) return false;
+	if(!pitchShimL.init(fs)) return false;
+	if(!pitchShimR.init(fs)) return false;
 	pitchShimL.setPitch(2.0f);
 	pitchShimR.setPitch(2.0f);
 	pitchShimL.setTone(0.26f);
@@ -111,6 +127,29 @@ bool AudioEffectPlateReverb_F32::begin()
 	pitchShimL.setMix(0.0f);
 	pitchShimR.setMix(0.0f);
 
+	// buffers cleared in the background when the bypass is engaged
+	memCleaner.clear();
+	memCleaner.add(in_allp_1L);
+	memCleaner.add(in_allp_2L);
+	memCleaner.add(in_allp_3L);
+	memCleaner.add(in_allp_4L);
+	memCleaner.add(in_allp_1R);
+	memCleaner.add(in_allp_2R);
+	memCleaner.add(in_allp_3R);
+	memCleaner.add(in_allp_4R);
+	memCleaner.add(lp_allp_1);
+	memCleaner.add(lp_allp_2);
+	memCleaner.add(lp_allp_3);
+	memCleaner.add(lp_allp_4);
+	memCleaner.add(lp_dly1);
+	memCleaner.add(lp_dly2);
+	memCleaner.add(lp_dly3);
+	memCleaner.add(lp_dly4);
+	memCleaner.add(pitchL);
+	memCleaner.add(pitchR);
+	memCleaner.add(pitchShimL);
+	memCleaner.add(pitchShimR);
+
 	flags.bypass = 1;
     flags.freeze = 0;
 	initialised = true;
@@ -122,54 +161,85 @@ void AudioEffectPlateReverb_F32::update()
 #if defined(__IMXRT1062__)	
 	if (!initialised) return;
     audio_block_f32_t *blockL, *blockR;
-	int16_t i;
-	float acc;
-    float rv_time;
-	uint32_t offset;
-	float lfo_fr;
 
+    // handle bypass, 1st call will clean the buffers to avoid continuing the previous reverb tail
+	// read only blocks are passed through, TRAILS mode keeps processing the silent input
+    if (flags.bypass && bp_mode != BYPASS_MODE_TRAILS)
+    {
+		bypass_update();
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, bp_mode);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
 	blockL = AudioStream_F32::receiveWritable_f32(0);
 	blockR = AudioStream_F32::receiveWritable_f32(1);
 	if (!bypass_process(&blockL, &blockR, bp_mode, (bool)flags.bypass))
 		return;
+	process(blockL->data, blockR->data, blockL->length);
+    AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+	#endif
+}
 
-    // handle bypass, 1st call will clean the buffers to avoid continuing the previous reverb tail
-    if (flags.bypass)
-    {
-		if (!flags.cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
-		{
-			in_allp_1L.reset();
-			in_allp_2L.reset();
-			in_allp_3L.reset();
-			in_allp_4L.reset();
-			in_allp_1R.reset();
-			in_allp_2R.reset();
-			in_allp_3R.reset();
-			in_allp_4R.reset();
-			lp_allp_1.reset();
-			lp_allp_2.reset();
-			lp_allp_3.reset();
-			lp_allp_4.reset();
-			lp_dly1.reset();
-			lp_dly2.reset();
-			lp_dly3.reset();
-			lp_dly4.reset();
-			flags.cleanup_done = 1;
-		}
-		if (bp_mode != BYPASS_MODE_TRAILS)
-		{
-			AudioStream_F32::transmit(blockL, 0);
-			AudioStream_F32::transmit(blockR, 1);
-			AudioStream_F32::release(blockL);
-			AudioStream_F32::release(blockR);
-			return;
-		}
+/**
+ * @brief bypass housekeeping, the buffers are cleared in PASS and OFF modes
+ */
+void AudioEffectPlateReverb_F32::bypass_update()
+{
+	if (bp_mode == BYPASS_MODE_TRAILS) return;
+	if (!flags.cleanup_done)
+	{
+		memCleaner.start();		// clear the buffers in portions over the next updates
+		shimActiveL = false;
+		shimActiveR = false;
+		flags.cleanup_done = 1;
+	}
+	memCleaner.process();
+}
+
+void AudioEffectPlateReverb_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+#if defined(__IMXRT1062__)	
+	AudioBasicDenormalGuard ftz;
+	if (!initialised) return;
+	uint32_t i;
+	float acc;
+    float rv_time;
+	uint32_t offset;
+	float lfo_fr;
+	float32_t shim_mix;
+
+	if (flags.bypass)
+	{
+		bypass_update();
+		if (bp_mode == BYPASS_MODE_PASS) return;
+		// OFF mutes the output, TRAILS processes the silent input
+		memset(dataL, 0, len * sizeof(float32_t));
+		memset(dataR, 0, len * sizeof(float32_t));
+		if (bp_mode == BYPASS_MODE_OFF) return;
+	}
+
+	// bypass released before the buffers were cleared, output the dry signal only
+	if (memCleaner.busy())
+	{
+		memCleaner.process();
+		arm_scale_f32(dataL, dry_gain, dataL, len);
+		arm_scale_f32(dataR, dry_gain, dataR, len);
+		return;
 	}
 	
 	flags.cleanup_done = 0;
     rv_time = rv_time_k;
+	shim_mix = pitchShimL.getMix();
 
-	for (i=0; i < blockL->length; i++) 
+	for (i=0; i < len; i++) 
     {
         // do the LFOs
 		lfo1.update();
@@ -177,7 +247,7 @@ void AudioEffectPlateReverb_F32::update()
 
 		inputGain += (inputGainSet - inputGain) * 0.25f;
 
-		acc = blockL->data[i] * inputGain;
+		acc = dataL[i] * inputGain;
 
         // chained input allpasses, channel L
 		acc = in_allp_1L.process(acc);
@@ -187,14 +257,17 @@ void AudioEffectPlateReverb_F32::update()
 		in_allp_out_L = pitchL.process(in_allp_out_L); 
 
 		// chained input allpasses, channel R
-        acc = blockR->data[i] * inputGain;
+        acc = dataR[i] * inputGain;
 
 		acc = in_allp_1R.process(acc);
 		acc = in_allp_2R.process(acc);
 		acc = in_allp_3R.process(acc);
 		in_allp_out_R = in_allp_4R.process(acc);
 
-		acc = pitchShimR.process(lp_allp_out + in_allp_out_R); // shimmer
+		// shimmer, pitch shifted signal rendered in the previous update
+		acc = lp_allp_out + in_allp_out_R;
+		shimInR[i] = acc;
+		if (shimActiveR) acc += (shimOutR[i] - acc) * shim_mix;
 
 	   	acc = lp_dly1.process(acc);
 		acc = flt1.process(acc) * rv_time * rv_time_scaler;
@@ -203,7 +276,9 @@ void AudioEffectPlateReverb_F32::update()
 		acc = lp_dly2.process(acc);
 		acc = flt2.process(acc) * rv_time * rv_time_scaler;
 
-		acc = pitchShimL.process(acc + in_allp_out_R); // shimmer
+		acc += in_allp_out_R;
+		shimInL[i] = acc;
+		if (shimActiveL) acc += (shimOutL[i] - acc) * shim_mix;
 
 		acc = lp_allp_3.process(acc);
 	   	acc = lp_dly3.process(acc);
@@ -222,7 +297,7 @@ void AudioEffectPlateReverb_F32::update()
         // Master lowpass filter
 		acc = flt_masterL.process(acc);
 
-		blockL->data[i] = acc * wet_gain + blockL->data[i] * dry_gain; 
+		dataL[i] = acc * wet_gain + dataL[i] * dry_gain; 
         // ChannelR
 		acc  = lp_dly1.getTap(lp_dly1_offset_R) * 0.8f;
 		acc += lp_dly2.getTap(lp_dly2_offset_R) * 0.7f;
@@ -230,7 +305,7 @@ void AudioEffectPlateReverb_F32::update()
 		acc += lp_dly4.getTap(lp_dly4_offset_R) * 0.5f;
         // Master lowpass filter
 		acc = flt_masterR.process(acc);
-		blockR->data[i] = acc * wet_gain + blockR->data[i] * dry_gain;
+		dataR[i] = acc * wet_gain + dataR[i] * dry_gain;
 
 		// modulate the delay lines
 		// delay 1
@@ -257,15 +332,14 @@ void AudioEffectPlateReverb_F32::update()
 		lp_dly4.write_toOffset(acc, LFO_AMPL*2);
 		lp_dly4.updateIndex();		
 	}
+	// render the shimmer for the next block
+	shimActiveR = pitchShimR.processBlock(shimInR, shimOutR, len, true);
+	shimActiveL = pitchShimL.processBlock(shimInL, shimOutL, len, true);
 	if (LFO_AMPL != LFO_AMPLset) 
 	{
 		lfo1.setDepth(LFO_AMPL);
 		lfo2.setDepth(LFO_AMPL);
 		LFO_AMPL = LFO_AMPLset;
 	}
-    AudioStream_F32::transmit(blockL, 0);
-	AudioStream_F32::transmit(blockR, 1);
-	AudioStream_F32::release(blockL);
-	AudioStream_F32::release(blockR);
 	#endif
 }
@@ -40,19 +40,26 @@
 #include "basic_components.h"
 
 
-class AudioEffectPlateReverb_F32 : public AudioStream_F32
+class AudioEffectPlateReverb_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
     AudioEffectPlateReverb_F32() : AudioStream_F32(2, inputQueueArray_f32) { begin();}
 	AudioEffectPlateReverb_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32)
 	{
 		block_size = settings.audio_block_samples;
+		fs = settings.sample_rate_Hz;
 		begin();			
 	}
 	~AudioEffectPlateReverb_F32(){};
     virtual void update();
+    void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 
     bool begin(void);
+	/**
+	 * @brief allocate the buffers again, ie. after the memory arena was released
+	 * 			all parameters are set to defaults, same as begin()
+	 */
+	bool mem_realloc() { return begin(); }
 
 	/**
 	 * @brief sets the reverb time
@@ -294,7 +301,7 @@ public:
 	 */
 	void chorus(float c)
 	{
-		c = map(c, 0.0f, 1.0f, 1.0f, 100.0f);
+		c = map(c, 0.0f, 1.0f, 1.0f, 100.0f) * fs_k;
 		__disable_irq();
 		LFO_AMPLset = (uint32_t)c; 
 		__enable_irq();
@@ -402,6 +409,7 @@ public:
 	}
 
 private:
+	void bypass_update();
     struct flags_t
     {
         unsigned bypass:            1;
@@ -411,6 +419,7 @@ private:
     }flags;
 	bypass_mode_t bp_mode = BYPASS_MODE_PASS;
     audio_block_f32_t *inputQueueArray_f32[2];
+	AudioBasicMemCleaner memCleaner;
 
 	static const uint16_t IN_ALLP1_BUFL_LEN = 224u;
 	static const uint16_t IN_ALLP2_BUFL_LEN = 420u;
@@ -432,15 +441,19 @@ private:
 	static const uint16_t LP_DLY3_BUF_LEN   = 4365u;
 	static const uint16_t LP_DLY4_BUF_LEN   = 3698u;
 
-    const uint16_t lp_dly1_offset_L = 201;
-    const uint16_t lp_dly2_offset_L = 145;
-    const uint16_t lp_dly3_offset_L = 1897;
-    const uint16_t lp_dly4_offset_L = 280;
+	// output tap offsets at 44.1kHz
+	static const uint16_t LP_DLY1_OFFSET_L = 201u;
+	static const uint16_t LP_DLY2_OFFSET_L = 145u;
+	static const uint16_t LP_DLY3_OFFSET_L = 1897u;
+	static const uint16_t LP_DLY4_OFFSET_L = 280u;
 
-    const uint16_t lp_dly1_offset_R = 1897;
-    const uint16_t lp_dly2_offset_R = 1245;
-    const uint16_t lp_dly3_offset_R = 487;
-    const uint16_t lp_dly4_offset_R = 780;  
+	static const uint16_t LP_DLY1_OFFSET_R = 1897u;
+	static const uint16_t LP_DLY2_OFFSET_R = 1245u;
+	static const uint16_t LP_DLY3_OFFSET_R = 487u;
+	static const uint16_t LP_DLY4_OFFSET_R = 780u;
+	// offsets scaled to the used sample rate
+	uint32_t lp_dly1_offset_L, lp_dly2_offset_L, lp_dly3_offset_L, lp_dly4_offset_L;
+	uint32_t lp_dly1_offset_R, lp_dly2_offset_R, lp_dly3_offset_R, lp_dly4_offset_R;
 
 	AudioFilterAllpass<IN_ALLP1_BUFL_LEN> in_allp_1L;
 	AudioFilterAllpass<IN_ALLP2_BUFL_LEN> in_allp_2L;
@@ -457,8 +470,9 @@ private:
 	AudioFilterAllpass<LP_ALLP3_BUF_LEN> lp_allp_3;
 	AudioFilterAllpass<LP_ALLP4_BUF_LEN> lp_allp_4;
 
-	uint16_t LFO_AMPL = 20u;
-	uint16_t LFO_AMPLset = 20u;
+	static const uint16_t LFO_AMPL_DEFAULT = 20u;		// at 44.1kHz
+	uint16_t LFO_AMPL = LFO_AMPL_DEFAULT;
+	uint16_t LFO_AMPLset = LFO_AMPL_DEFAULT;
 	AudioBasicLfo lfo1 = AudioBasicLfo(1.35f, LFO_AMPL);
 	AudioBasicLfo lfo2 = AudioBasicLfo(1.57f, LFO_AMPL);
 
@@ -499,6 +513,13 @@ private:
 	float shimmerRatio = 0.0f;
 	AudioBasicPitch	pitchShimL;
 	AudioBasicPitch	pitchShimR;
+	// shimmer is rendered per block, the output is used in the next update
+	ARENA_ALIGNED float32_t shimInL[AUDIO_BLOCK_SAMPLES];
+	ARENA_ALIGNED float32_t shimInR[AUDIO_BLOCK_SAMPLES];
+	ARENA_ALIGNED float32_t shimOutL[AUDIO_BLOCK_SAMPLES];
+	ARENA_ALIGNED float32_t shimOutR[AUDIO_BLOCK_SAMPLES];
+	bool shimActiveL = false;
+	bool shimActiveR = false;
 
 	const int8_t semitoneTable[9] = {-12, -7, -5, -3, 0, 3, 5, 7, 12};
 	int8_t pitch_semit;
@@ -514,6 +535,8 @@ private:
 
 	bool initialised = false;
 	uint16_t block_size = AUDIO_BLOCK_SAMPLES;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
+	float32_t fs_k = 1.0f;		// fs / 44100, scales the delay lengths
 
 };
 
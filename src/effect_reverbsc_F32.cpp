@@ -34,19 +34,37 @@ extern uint8_t external_psram_size;
 
 AudioEffectReverbSc_F32::AudioEffectReverbSc_F32(bool use_psram) : AudioStream_F32(2, inputQueueArray_f32)
 {
-	sample_rate_ = AUDIO_SAMPLE_RATE_EXACT;
+	init(AUDIO_SAMPLE_RATE_EXACT, use_psram);
+}
+
+AudioEffectReverbSc_F32::AudioEffectReverbSc_F32(const AudioSettings_F32 &settings, bool use_psram) : AudioStream_F32(2, inputQueueArray_f32)
+{
+	init(settings.sample_rate_Hz, use_psram);
+}
+
+void AudioEffectReverbSc_F32::init(float32_t sample_rate, bool use_psram)
+{
+	AudioBasicMemArenaOwner memOwner(this, "ReverbSc");
+	initialised = false;
+	psram_mode = use_psram;
+	AudioBasicMemArena::free(aux_);
+	aux_ = NULL;
+	memCleaner.clear();
+	sample_rate_ = sample_rate;
 	feedback_ = 0.7f;
 	lpfreq_ = 10000;
 	i_pitch_mod_ = 1;
-	damp_fact_ = 0.195847f; // ~16kHz
+	damp_fact_ = powf(0.195847f, AUDIO_SAMPLE_RATE_EXACT / sample_rate_); // ~16kHz
 	flags.mem_fail = 0;
 	flags.bypass = 0;
 	flags.freeze = 0;
 	flags.cleanup_done = 1;
-	flags.memsetup_done = 0;
 	bp_mode = BYPASS_MODE_PASS;
-	int i, n_bytes = 0;
-	n_bytes = 0;
+	int i, n_samples = 0;
+	// delay line lengths depend on the sample rate
+	aux_size_bytes = 0;
+	for (i = 0; i < 8; i++)
+		aux_size_bytes += DelayLineBytesAlloc(sample_rate_, 1, i);
 	if (use_psram)	
 	{
 		#if ARDUINO_TEENSY41 
@@ -57,17 +75,16 @@ AudioEffectReverbSc_F32::AudioEffectReverbSc_F32(bool use_psram) : AudioStream_F
 			initialised = true;
 			return;
 		}
-		aux_ = (float32_t *) extmem_malloc(aux_size_bytes);
+		aux_ = (float32_t *) AudioBasicMemArena::alloc(aux_size_bytes, ARENA_PSRAM);
 		#else
 			flags.mem_fail = 1;
-			flags.memsetup_done = 1; // nothing to setup, make it ready
 			initialised = true;
 			return;
 		#endif
 	}
 	else			
 	{
-		aux_ = (float32_t *) malloc(aux_size_bytes);
+		aux_ = (float32_t *) AudioBasicMemArena::alloc(aux_size_bytes, ARENA_RAM2);
 	}
 	if (!aux_) 
 	{
@@ -77,13 +94,15 @@ AudioEffectReverbSc_F32::AudioEffectReverbSc_F32(bool use_psram) : AudioStream_F
 
 	for (i = 0; i < 8; i++)
 	{
-		if (n_bytes > REVERBSC_DLYBUF_SIZE)
-			return;
-		delay_lines_[i].buf = (aux_) + n_bytes;
+		delay_lines_[i].buf = aux_ + n_samples;
 		InitDelayLine(&delay_lines_[i], i);
-		n_bytes += DelayLineBytesAlloc(AUDIO_SAMPLE_RATE_EXACT, 1, i);
+		n_samples += DelayLineMaxSamples(sample_rate_, 1, i);
 	}
 	mix(0.5f);
+	// PSRAM contents are cleared in portions in the update() function
+	memCleaner.setBudget(memCleanupStep);
+	memCleaner.addRegion(aux_, aux_size_bytes, use_psram);
+	memCleaner.start();
 
 	initialised = true;
 }
@@ -162,16 +181,40 @@ void AudioEffectReverbSc_F32::update()
 {
 #if defined(__IMXRT1062__)
 	audio_block_f32_t *blockL, *blockR;
-	int16_t i;
-	float32_t a_in_l, a_in_r, a_out_l, a_out_r, dryL, dryR;
-	float32_t vm1, v0, v1, v2, am1, a0, a1, a2, frac;
-	ReverbScDl_t *lp;
-	int read_pos;
-	uint32_t n;
-	int buffer_size; /* Local copy */
-	float32_t damp_fact = damp_fact_;
 	
 	if (!initialised) return;
+	// bypass or buffers not cleared yet: read only blocks are passed through (or silence)
+	if (bypass_update())
+	{
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, flags.bypass ? bp_mode : BYPASS_MODE_PASS);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+	}
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!bypass_process(&blockL, &blockR, bp_mode, false))
+		return;
+	process(blockL->data, blockR->data, blockL->length);
+    AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);	
+#endif	
+}
+
+/**
+ * @brief bypass housekeeping, the buffers are cleared in PASS and OFF modes
+ * 
+ * @return true 	reverb bypassed or the buffers are still being cleared, do not process
+ * @return false 	reverb active
+ */
+bool AudioEffectReverbSc_F32::bypass_update()
+{
 	// special case if memory allocation failed, pass the input signal directly to the output
 	if (flags.mem_fail) 
 	{
@@ -179,30 +222,53 @@ void AudioEffectReverbSc_F32::update()
 		flags.bypass = 1;
 	}
 	
-	blockL = AudioStream_F32::receiveWritable_f32(0);
-	blockR = AudioStream_F32::receiveWritable_f32(1);
-	
-	if (!bypass_process(&blockL, &blockR, bp_mode, (bool)flags.bypass))
-		return;
+	if (flags.bypass && !flags.cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
+	{
+		memCleaner.start();		// clear the buffers in portions over the next updates
+		for (uint32_t n = 0; n < 8; n++) delay_lines_[n].filter_state = 0.0f;
+		flags.cleanup_done = 1;
+	}
+	if (flags.bypass || memCleaner.busy())
+	{
+		memCleaner.process();
+		return true;
+	}
+	return false;
+}
 
-	if (flags.bypass || !flags.memsetup_done)
+void AudioEffectReverbSc_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+#if defined(__IMXRT1062__)
+	AudioBasicDenormalGuard ftz;
+	uint32_t i;
+	float32_t a_in_l, a_in_r, a_out_l, a_out_r, dryL, dryR;
+	float32_t vm1, v0, v1, v2, am1, a0, a1, a2, frac;
+	ReverbScDl_t *lp;
+	int read_pos;
+	uint32_t n;
+	int buffer_size; /* Local copy */
+	float32_t damp_fact = damp_fact_;
+	
+	if (!initialised) return;
+	if (bypass_update())
 	{
-		if ( !flags.memsetup_done)	flags.memsetup_done  = memCleanup();
-		AudioStream_F32::transmit(blockL, 0);
-		AudioStream_F32::transmit(blockR, 1);
-		AudioStream_F32::release(blockL);
-		AudioStream_F32::release(blockR);
+		// OFF and TRAILS modes mute the output
+		if (flags.bypass && bp_mode != BYPASS_MODE_PASS)
+		{
+			memset(dataL, 0, len * sizeof(float32_t));
+			memset(dataR, 0, len * sizeof(float32_t));
+		}
 		return;
 	}
 
 	flags.cleanup_done = 0;
-	for (i = 0; i < blockL->length; i++)
+	for (i = 0; i < len; i++)
 	{
 		input_gain += (input_gain_set - input_gain) * 0.25f;
 		/* calculate "resultant junction pressure" and mix to input signals */
 		a_in_l = a_out_l = a_out_r = 0.0f;
-		dryL = blockL->data[i] * input_gain;
-		dryR = blockR->data[i] * input_gain;
+		dryL = dataL[i] * input_gain;
+		dryR = dataR[i] * input_gain;
 
 		for (n = 0; n < 8; n++)
 		{
@@ -278,7 +344,7 @@ void AudioEffectReverbSc_F32::update()
 			else		a_out_l += v0;
 
 			v0 *= (float32_t)feedback_; // apply feedback
-			lp->filter_state = v0;	// save filter - this will make the reverb volume constant
+			lp->filter_state = denormal_bias(v0);	// save filter - this will make the reverb volume constant
 
 			/* start next random line segment if current one has reached endpoint */
 			if (--(lp->rand_line_cnt) <= 0)
@@ -286,13 +352,9 @@ void AudioEffectReverbSc_F32::update()
 				NextRandomLineseg(lp, n);
 			}
 		}
-		blockL->data[i] = a_out_l * wet_gain + blockL->data[i] * dry_gain;
-		blockR->data[i] = a_out_r * wet_gain + blockR->data[i] * dry_gain;
+		dataL[i] = a_out_l * wet_gain + dataL[i] * dry_gain;
+		dataR[i] = a_out_r * wet_gain + dataR[i] * dry_gain;
 	} // end block processing
-    AudioStream_F32::transmit(blockL, 0);
-	AudioStream_F32::transmit(blockR, 1);
-	AudioStream_F32::release(blockL);
-	AudioStream_F32::release(blockR);	
 #endif	
 }
 
@@ -322,32 +384,3 @@ void AudioEffectReverbSc_F32::freeze(bool state)
 		__enable_irq();
 	}
 }
-
-/**
- * @brief Partial memory clear
- * 	Clearing all the delay buffers at once, esp. if 
- * 	the PSRAM is used takes too long for the audio ISR.
- *  Hence the buffer clear is done in configurable portions
- *  spread over a few audio update routines.
- * 
- * @return true 	Memory clean is complete
- * @return false 	Memory clean still in progress
- */
-bool AudioEffectReverbSc_F32::memCleanup()
-{
-	bool result = false;
-	if (memCleanupEnd > REVERBSC_DLYBUF_SIZE) // last segment
-	{
-		memCleanupEnd = REVERBSC_DLYBUF_SIZE;
-		result = true;	
-	}
-	uint32_t l = (memCleanupEnd - memCleanupStart) * sizeof(float32_t);
-	uint8_t* memPtr = (uint8_t *)&aux_[0]+(memCleanupStart*sizeof(float32_t));
-	memset(memPtr, 0, l);
-	arm_dcache_flush_delete(memPtr, l);
-
-	memCleanupStart = memCleanupEnd;
-	memCleanupEnd += memCleanupStep;
-	
-	return result;
-}
@@ -22,15 +22,18 @@
 #include "arm_math.h"
 #include "basic_DSPutils.h"
 #include "basic_bypassStereo_F32.h"
+#include "basic_memArena.h"
+#include "basic_memCleaner.h"
+#include "basic_effectKernel_F32.h"
 
-#define REVERBSC_DLYBUF_SIZE 98936
-
-class AudioEffectReverbSc_F32 : public AudioStream_F32
+class AudioEffectReverbSc_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
 	AudioEffectReverbSc_F32(bool use_psram = false);
+	AudioEffectReverbSc_F32(const AudioSettings_F32 &settings, bool use_psram = false);
 	~AudioEffectReverbSc_F32(){};
 	virtual void update();
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 
 	typedef struct
 	{
@@ -64,6 +67,7 @@ public:
 		if (flags.freeze) return;
 		val = constrain(val, 0.0f, 0.96f);
 		val = val*val*val;
+		if (sample_rate_ != AUDIO_SAMPLE_RATE_EXACT) val = powf(val, AUDIO_SAMPLE_RATE_EXACT / sample_rate_); // keep the cutoff freq
 		if (damp_fact_ != val)
 		{
 			damp_fact_tmp = val;
@@ -122,10 +126,6 @@ public:
 		{
 			if (bp_mode == BYPASS_MODE_TRAILS) input_gain_set = 0.0f;
 			freeze(false);       // disable freeze in bypass mode
-			__disable_irq();
-			memCleanupStart = 0;
-			memCleanupEnd = memCleanupStep;
-			__enable_irq();
 		}
 		else input_gain_set = input_gain_tmp;
     }
@@ -134,22 +134,32 @@ public:
 		bypass_set(flags.bypass^1);
         return flags.bypass;
     }
+	/**
+	 * @brief allocate the delay lines again, ie. after the memory arena was released
+	 * 			all parameters are set to defaults
+	 */
+	bool mem_realloc()
+	{
+		init(sample_rate_, psram_mode);
+		return initialised && !flags.mem_fail;
+	}
 	uint32_t getBfAddr()
 	{
 		float32_t *addr = aux_;
-		return (uint32_t)addr;
+		return (uint32_t)(uintptr_t)addr;
 	}
 private:
+	bool bypass_update();
     struct flags_t
     {
         unsigned bypass:            1;
         unsigned freeze:            1;
 		unsigned cleanup_done:		1;
-		unsigned memsetup_done:		1;
 		unsigned mem_fail:			1;
     }flags;
 	bypass_mode_t bp_mode;
 	audio_block_f32_t *inputQueueArray_f32[2];
+	void init(float32_t sample_rate, bool use_psram);
     void NextRandomLineseg(ReverbScDl_t *lp, int n);
     void InitDelayLine(ReverbScDl_t *lp, int n);
 	//void bypass_process();
@@ -161,7 +171,8 @@ private:
     bool initialised = false;
     ReverbScDl_t delay_lines_[8];
     float32_t *aux_ = NULL; // main delay line storage buffer, placed either in RAM2 or PSRAM
-	const uint32_t aux_size_bytes = REVERBSC_DLYBUF_SIZE*sizeof(float32_t);
+	bool psram_mode = false;
+	uint32_t aux_size_bytes = 0;	// depends on the sample rate
 	float32_t dry_gain = 0.5f;
 	float32_t wet_gain = 0.5f;
 
@@ -171,10 +182,8 @@ private:
 	float32_t freeze_ingain = 0.05f;
 	static constexpr float32_t feedb_max = 0.99f;
 
-	bool memCleanup(void);
-	const uint32_t memCleanupStep = 512;
-	uint32_t memCleanupStart = 0;
-	uint32_t memCleanupEnd = memCleanupStep;
+	static const uint32_t memCleanupStep = 2048;	// bytes cleared per update
+	AudioBasicMemCleaner memCleaner;
 
 
 };
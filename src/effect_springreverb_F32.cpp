@@ -37,105 +37,198 @@
 #define TREBLE_LOSS_FREQ    (0.55f)
 #define BASS_LOSS_FREQ      (0.36f)
 
+static const uint8_t chrp_len44k1[SPRVB_CHIRP_STAGES] = 
+{
+	SPRVB_CHIRP1_LEN, SPRVB_CHIRP2_LEN, SPRVB_CHIRP3_LEN, SPRVB_CHIRP4_LEN
+};
+// chrp_allp_k index pattern for the L and R chain, repeated every 4 allpasses
+static const uint8_t chrp_k_patternL[SPRVB_CHIRP_STAGES][4] = 
+{
+	{0, 1, 2, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 1, 1, 3}
+};
+static const uint8_t chrp_k_patternR[4] = {3, 2, 1, 0};
+
 AudioEffectSpringReverb_F32::AudioEffectSpringReverb_F32() : AudioStream_F32(2, inputQueueArray)
 {
+	begin(AUDIO_SAMPLE_RATE_EXACT);
+}
+
+AudioEffectSpringReverb_F32::AudioEffectSpringReverb_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+{
+	begin(settings.sample_rate_Hz);
+}
+
+void AudioEffectSpringReverb_F32::begin(float32_t fs)
+{
+	AudioBasicMemArenaOwner memOwner(this, "SpringReverb");
+	initialized = false;
+	fs_set = fs;
+	memCleaner.clear();
+	float32_t fs_k = fs / AUDIO_SAMPLE_RATE_EXACT; // all delay lengths are tuned for 44.1kHz
     inputGain = 0.5f;
 	rv_time_k = 0.8f;
     in_allp_k = INP_ALLP_COEFF;
 	bool memOK = true;
-	if(!sp_lp_allp1a.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp1b.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp1c.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp1d.init(&in_allp_k)) memOK = false;
+	if(!sp_lp_allp1a.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp1b.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp1c.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp1d.init(&in_allp_k, fs_k)) memOK = false;
 
-	if(!sp_lp_allp2a.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp2b.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp2c.init(&in_allp_k)) memOK = false;
-	if(!sp_lp_allp2d.init(&in_allp_k)) memOK = false;	
-	if(!lp_dly1.init(SPRVB_DLY1_LEN)) memOK = false;
-	if(!lp_dly2.init(SPRVB_DLY2_LEN)) memOK = false;
+	if(!sp_lp_allp2a.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp2b.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp2c.init(&in_allp_k, fs_k)) memOK = false;
+	if(!sp_lp_allp2d.init(&in_allp_k, fs_k)) memOK = false;	
+	if(!lp_dly1.init(SPRVB_DLY1_LEN * fs_k)) memOK = false;
+	if(!lp_dly2.init(SPRVB_DLY2_LEN * fs_k)) memOK = false;
 	// chirp allpass chain
-	sp_chrp_alp1_buf = (float *)malloc(SPRVB_CHIRP_AMNT*SPRVB_CHIRP1_LEN*sizeof(float));
-	sp_chrp_alp2_buf = (float *)malloc(SPRVB_CHIRP_AMNT*SPRVB_CHIRP2_LEN*sizeof(float));
-	sp_chrp_alp3_buf = (float *)malloc(SPRVB_CHIRP_AMNT*SPRVB_CHIRP3_LEN*sizeof(float));
-	sp_chrp_alp4_buf = (float *)malloc(SPRVB_CHIRP_AMNT*SPRVB_CHIRP4_LEN*sizeof(float));
-	if (!sp_chrp_alp1_buf) memOK = false;
-	if (!sp_chrp_alp2_buf) memOK = false;
-	if (!sp_chrp_alp3_buf) memOK = false;
-	if (!sp_chrp_alp4_buf) memOK = false;
-	memset(&sp_chrp_alp1_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP1_LEN*sizeof(float));
-	memset(&sp_chrp_alp2_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP2_LEN*sizeof(float));
-	memset(&sp_chrp_alp3_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP3_LEN*sizeof(float));
-	memset(&sp_chrp_alp4_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP4_LEN*sizeof(float));
+	chrp_buf_len = 0;
+	for (int s = 0; s < SPRVB_CHIRP_STAGES; s++)
+	{
+		chrp_len[s] = (uint8_t)(chrp_len44k1[s] * fs_k + 0.5f);
+		if (!chrp_len[s]) chrp_len[s] = 1;
+		chrp_buf_len += chrp_len[s] * SPRVB_CHIRP_AMNT;
+	}
+	AudioBasicMemArena::free(sp_chrp_buf);
+	sp_chrp_buf = (float32_t *)AudioBasicMemArena::alloc(chrp_buf_len*sizeof(float32_t), ARENA_RAM1);
+	if (!sp_chrp_buf) memOK = false;
+	else chirp_init();
+	lfo_ampl = SPRVB_LFO_AMPL * fs_k;
+	lfo.setSampleRate(fs);
+	lfo.setDepth(lfo_ampl);
 	in_BassCut_k = 0.0f;
 	in_TrebleCut_k = 0.95f;
 	lp_BassCut_k = 0.0f;
 	lp_TrebleCut_k = 1.0f;
-	flt_in.init(BASS_LOSS_FREQ, &in_BassCut_k, TREBLE_LOSS_FREQ, &in_TrebleCut_k);
-	flt_lp1.init(BASS_LOSS_FREQ, &lp_BassCut_k, TREBLE_LOSS_FREQ, &lp_TrebleCut_k);
-	flt_lp2.init(BASS_LOSS_FREQ, &lp_BassCut_k, TREBLE_LOSS_FREQ, &lp_TrebleCut_k);
+	float32_t bassLoss = onepole_coeff_fs(BASS_LOSS_FREQ, fs);
+	float32_t trebleLoss = onepole_coeff_fs(TREBLE_LOSS_FREQ, fs);
+	flt_in.init(bassLoss, &in_BassCut_k, trebleLoss, &in_TrebleCut_k);
+	flt_lp1.init(bassLoss, &lp_BassCut_k, trebleLoss, &lp_TrebleCut_k);
+	flt_lp2.init(bassLoss, &lp_BassCut_k, trebleLoss, &lp_TrebleCut_k);
 	mix(0.5f);
+	// buffers cleared in the background when the bypass is engaged
+	memCleaner.add(sp_lp_allp1a);
+	memCleaner.add(sp_lp_allp1b);
+	memCleaner.add(sp_lp_allp1c);
+	memCleaner.add(sp_lp_allp1d);
+	memCleaner.add(sp_lp_allp2a);
+	memCleaner.add(sp_lp_allp2b);
+	memCleaner.add(sp_lp_allp2c);
+	memCleaner.add(sp_lp_allp2d);
+	memCleaner.add(lp_dly1);
+	memCleaner.add(lp_dly2);
+	memCleaner.addRegion(sp_chrp_buf, chrp_buf_len*sizeof(float32_t));
 	cleanup_done = true;
 	if (memOK) initialized = true;
 }
 
+void AudioEffectSpringReverb_F32::chirp_init(void)
+{
+	float32_t *p = sp_chrp_buf;
+	for (int s = 0; s < SPRVB_CHIRP_STAGES; s++)
+	{
+		sp_chrp_stage[s] = p;
+		p += chrp_len[s] * SPRVB_CHIRP_AMNT;
+		for (int j = 0; j < SPRVB_CHIRP_AMNT; j += 2)
+		{
+			chrp_k[s][j] = chrp_allp_k[chrp_k_patternL[s][(j>>1) & 0x03]];
+			chrp_k[s][j+1] = chrp_allp_k[chrp_k_patternR[(j>>1) & 0x03]];
+		}
+	}
+	chirp_reset();
+}
+
+void AudioEffectSpringReverb_F32::chirp_reset(void)
+{
+	memset(sp_chrp_buf, 0, chrp_buf_len*sizeof(float32_t));
+	memset(chrp_idx, 0, sizeof(chrp_idx));
+}
+
 void AudioEffectSpringReverb_F32::update()
 {   
 #if defined(__IMXRT1062__)
 	audio_block_f32_t *blockL, *blockR;
-	int i, j;
+    if (!initialized) return;
+
+	// read only blocks are passed through, TRAILS mode keeps processing the silent input
+    if (bp && bp_mode != BYPASS_MODE_TRAILS)
+    {
+		bypass_update();
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, bp_mode);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::release(blockR);
+		return;
+    }
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!bypass_process(&blockL, &blockR, bp_mode, bp))
+		return;
+	process(blockL->data, blockR->data, blockL->length);
+    AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::release(blockR);
+#endif
+}
+
+/**
+ * @brief bypass housekeeping, the buffers are cleared in PASS and OFF modes
+ */
+void AudioEffectSpringReverb_F32::bypass_update()
+{
+	if (bp_mode == BYPASS_MODE_TRAILS) return;
+	if (!cleanup_done)
+	{
+		memCleaner.start();		// clear the buffers in portions over the next updates
+		cleanup_done = true;
+	}
+	memCleaner.process();
+}
+
+void AudioEffectSpringReverb_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+#if defined(__IMXRT1062__)
+	AudioBasicDenormalGuard ftz;
+	uint32_t i;
+	int j;
 	float32_t inL, inR, dryL, dryR;
 	float32_t acc;
     float32_t lp_out1, lp_out2, mono_in, dry_in;
     float32_t rv_time;
-	uint32_t allp_idx;
 	uint32_t offset;
 	float lfo_fr;	
     if (!initialized) return;
 
-	blockL = AudioStream_F32::receiveWritable_f32(0);
-	blockR = AudioStream_F32::receiveWritable_f32(1);
-	if (!bypass_process(&blockL, &blockR, bp_mode, bp))
-		return;
+	if (bp)
+	{
+		bypass_update();
+		if (bp_mode == BYPASS_MODE_PASS) return;
+		// OFF mutes the output, TRAILS processes the silent input
+		memset(dataL, 0, len * sizeof(float32_t));
+		memset(dataR, 0, len * sizeof(float32_t));
+		if (bp_mode == BYPASS_MODE_OFF) return;
+	}
 
-    if (bp)
-    {
-		if (!cleanup_done && bp_mode != BYPASS_MODE_TRAILS)
-		{
-			sp_lp_allp1a.reset();
-			sp_lp_allp1b.reset();
-			sp_lp_allp1c.reset();
-			sp_lp_allp1d.reset();
-			sp_lp_allp2a.reset();
-			sp_lp_allp2b.reset();
-			sp_lp_allp2c.reset();
-			sp_lp_allp2d.reset();
-			lp_dly1.reset();
-			lp_dly2.reset();
-			memset(&sp_chrp_alp1_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP1_LEN*sizeof(float));
-			memset(&sp_chrp_alp2_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP2_LEN*sizeof(float));
-			memset(&sp_chrp_alp3_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP3_LEN*sizeof(float));
-			memset(&sp_chrp_alp4_buf[0], 0, SPRVB_CHIRP_AMNT*SPRVB_CHIRP4_LEN*sizeof(float));			
-			cleanup_done = true;
-		}
-		if (bp_mode != BYPASS_MODE_TRAILS)
-		{
-			AudioStream_F32::transmit(blockL, 0);
-			AudioStream_F32::transmit(blockR, 1);
-			AudioStream_F32::release(blockL);
-			AudioStream_F32::release(blockR);
-			return;
-		}
-    }
+	// bypass released before the buffers were cleared, output the dry signal only
+	if (memCleaner.busy())
+	{
+		memCleaner.process();
+		arm_scale_f32(dataL, dry_gain, dataL, len);
+		arm_scale_f32(dataR, dry_gain, dataR, len);
+		return;
+	}
 	
 	cleanup_done = false;
     rv_time = rv_time_k;
-	for (i=0; i < blockL->length; i++) 
+	for (i=0; i < len; i++) 
     {  
 		lfo.update();
 		inputGain += (inputGainSet - inputGain) * 0.25f;
-		dryL = blockL->data[i];
-		dryR = blockR->data[i];
+		dryL = dataL[i];
+		dryR = dataR[i];
 		dry_in = (dryL + dryR) * inputGain;
 
 		mono_in = flt_in.process(dry_in)* (1.0f + in_BassCut_k*-2.5f);
@@ -159,216 +252,11 @@ void AudioEffectSpringReverb_F32::update()
 		
 		inL = inR = (lp_out1 + lp_out2);
 
-		j = 0;
-        while(j < SPRVB_CHIRP_AMNT)
-        {
-			// 1st 4 are left channel
-			allp_idx = j*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j];
-			acc = sp_chrp_alp1_buf[allp_idx] + inL * chrp_allp_k[0];
-			sp_chrp_alp1_buf[allp_idx] = inL - chrp_allp_k[0] * acc;
-            inL = acc;
-            if (++chrp_alp1_idx[j] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j] = 0;   
-            
-			allp_idx = (j+1)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+1];
-            acc = sp_chrp_alp1_buf[allp_idx]  + inL * chrp_allp_k[1];  
-            sp_chrp_alp1_buf[allp_idx] = inL - chrp_allp_k[1] * acc;			
-            inL = acc;
-            if (++chrp_alp1_idx[j+1] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+1] = 0; 
-            
-			allp_idx = (j+2)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+2];
-			acc = sp_chrp_alp1_buf[allp_idx]  + inL * chrp_allp_k[2];  
-            sp_chrp_alp1_buf[allp_idx] = inL - chrp_allp_k[2] * acc;
-            inL = acc;
-            if (++chrp_alp1_idx[j+2] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+2] = 0; 
-
-			allp_idx = (j+3)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+3];
-            acc = sp_chrp_alp1_buf[allp_idx]  + inL * chrp_allp_k[3];  
-            sp_chrp_alp1_buf[allp_idx] = inL - chrp_allp_k[3] * acc;
-            inL = acc;
-            if (++chrp_alp1_idx[j+3] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+3] = 0; 
-			// channel R
-			allp_idx = (j+4)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+4];
-            acc = sp_chrp_alp1_buf[allp_idx]  + inR * chrp_allp_k[3];  
-            sp_chrp_alp1_buf[allp_idx] = inR - chrp_allp_k[3] * acc;
-            inR = acc;
-            if (++chrp_alp1_idx[j+4] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+4] = 0; 
-
-			allp_idx = (j+5)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+5];
-            acc = sp_chrp_alp1_buf[allp_idx]  + inR * chrp_allp_k[2];  
-            sp_chrp_alp1_buf[allp_idx] = inR - chrp_allp_k[2] * acc;
-            inR = acc;
-            if (++chrp_alp1_idx[j+5] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+5] = 0; 
-
-			allp_idx = (j+6)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+6];
-            acc = sp_chrp_alp1_buf[allp_idx]  + inR * chrp_allp_k[1];  
-            sp_chrp_alp1_buf[allp_idx] = inR - chrp_allp_k[1] * acc;
-            inR = acc;
-            if (++chrp_alp1_idx[j+6] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+6] = 0; 
-
-			allp_idx = (j+7)*SPRVB_CHIRP1_LEN + chrp_alp1_idx[j+7];
-			acc = sp_chrp_alp1_buf[allp_idx]  + inR * chrp_allp_k[0];  
-            sp_chrp_alp1_buf[allp_idx] = inR - chrp_allp_k[0] * acc;			
-            inR = acc;
-            if (++chrp_alp1_idx[j+7] >= SPRVB_CHIRP1_LEN) chrp_alp1_idx[j+7] = 0; 
-
-            j = j + 8;
-        }
-        j = 0;
-        while(j < SPRVB_CHIRP_AMNT)
-        {	// channel L
-			allp_idx = j*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j];
-            acc = sp_chrp_alp2_buf[allp_idx]  + inL * chrp_allp_k[0];  
-            sp_chrp_alp2_buf[allp_idx] = inL - chrp_allp_k[0] * acc;
-            inL = acc;
-            if (++chrp_alp2_idx[j] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j] = 0;   
-            
-			allp_idx = (j+1)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+1];
-            acc = sp_chrp_alp2_buf[allp_idx]  + inL * chrp_allp_k[1];  
-            sp_chrp_alp2_buf[allp_idx] = inL - chrp_allp_k[1] * acc;			
-            inL = acc;
-            if (++chrp_alp2_idx[j+1] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+1] = 0; 
-            
-			allp_idx = (j+2)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+2];
-            acc = sp_chrp_alp2_buf[allp_idx]  + inL * chrp_allp_k[2];  
-            sp_chrp_alp2_buf[allp_idx] = inL - chrp_allp_k[2] * acc;			
-            inL = acc;
-            if (++chrp_alp2_idx[j+2] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+2] = 0; 
-            
-			allp_idx = (j+3)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+3];
-            acc = sp_chrp_alp2_buf[allp_idx]  + inL * chrp_allp_k[3];  
-            sp_chrp_alp2_buf[allp_idx] = inL - chrp_allp_k[3] * acc;			
-            inL = acc;
-            if (++chrp_alp2_idx[j+3] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+3] = 0; 
-			// channel R
-			allp_idx = (j+4)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+4];
-			acc = sp_chrp_alp2_buf[allp_idx]  + inR * chrp_allp_k[3];  
-            sp_chrp_alp2_buf[allp_idx] = inR - chrp_allp_k[3] * acc;
-            inR = acc;
-            if (++chrp_alp2_idx[j+4] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+4] = 0; 
-    
-			allp_idx = (j+5)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+5];
-			acc = sp_chrp_alp2_buf[allp_idx]  + inR * chrp_allp_k[2];  
-            sp_chrp_alp2_buf[allp_idx] = inR - chrp_allp_k[2] * acc;
-            inR = acc;
-            if (++chrp_alp2_idx[j+5] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+5] = 0; 
-
-			allp_idx = (j+6)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+6];
-			acc = sp_chrp_alp2_buf[allp_idx]  + inR * chrp_allp_k[1];  
-            sp_chrp_alp2_buf[allp_idx] = inR - chrp_allp_k[1] * acc;
-            inR = acc;
-            if (++chrp_alp2_idx[j+6] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+6] = 0; 
-
-			allp_idx = (j+7)*SPRVB_CHIRP2_LEN + chrp_alp2_idx[j+7];
-			acc = sp_chrp_alp2_buf[allp_idx]  + inR * chrp_allp_k[0];  
-            sp_chrp_alp2_buf[allp_idx] = inR - chrp_allp_k[0] * acc;
-            inR = acc;
-            if (++chrp_alp2_idx[j+7] >= SPRVB_CHIRP2_LEN) chrp_alp2_idx[j+7] = 0; 
-            j = j + 8;
-        }
-        j = 0;
-        while(j < SPRVB_CHIRP_AMNT)
-        {	// channel L
-			allp_idx = j*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inL * chrp_allp_k[0];  
-            sp_chrp_alp3_buf[allp_idx] = inL - chrp_allp_k[0] * acc;
-            inL = acc;
-            if (++chrp_alp3_idx[j] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j] = 0;   
-  
-			allp_idx = (j+1)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+1];
-			acc = sp_chrp_alp3_buf[allp_idx]  + inL * chrp_allp_k[1];  
-            sp_chrp_alp3_buf[allp_idx] = inL - chrp_allp_k[1] * acc;    
-            inL = acc;
-            if (++chrp_alp3_idx[j+1] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+1] = 0; 
-            
-			allp_idx = (j+2)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+2];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inL * chrp_allp_k[2];  
-            sp_chrp_alp3_buf[allp_idx] = inL - chrp_allp_k[2] * acc;			
-            inL = acc;
-            if (++chrp_alp3_idx[j+2] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+2] = 0; 
-
-			allp_idx = (j+3)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+3];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inL * chrp_allp_k[3];  
-            sp_chrp_alp3_buf[allp_idx] = inL - chrp_allp_k[3] * acc;			
-            inL = acc;
-            if (++chrp_alp3_idx[j+3] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+3] = 0; 
-			// channel R
-			allp_idx = (j+4)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+4];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inR * chrp_allp_k[3];  
-            sp_chrp_alp3_buf[allp_idx] = inR - chrp_allp_k[3] * acc;			
-            inR = acc;
-            if (++chrp_alp3_idx[j+4] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+4] = 0; 
-    
-			allp_idx = (j+5)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+5];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inR * chrp_allp_k[2];  
-            sp_chrp_alp3_buf[allp_idx] = inR - chrp_allp_k[2] * acc;			
-            inR = acc;
-            if (++chrp_alp3_idx[j+5] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+5] = 0; 
-
-			allp_idx = (j+6)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+6];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inR * chrp_allp_k[1];  
-            sp_chrp_alp3_buf[allp_idx] = inR - chrp_allp_k[1] * acc;			
-            inR = acc;
-            if (++chrp_alp3_idx[j+6] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+6] = 0; 
-
-			allp_idx = (j+7)*SPRVB_CHIRP3_LEN + chrp_alp3_idx[j+7];
-            acc = sp_chrp_alp3_buf[allp_idx]  + inR * chrp_allp_k[0];  
-            sp_chrp_alp3_buf[allp_idx] = inR - chrp_allp_k[0] * acc;			
-            inR = acc;
-            if (++chrp_alp3_idx[j+7] >= SPRVB_CHIRP3_LEN) chrp_alp3_idx[j+7] = 0; 
-            j = j + 8;
-        }
-		j = 0;
-        while(j < SPRVB_CHIRP_AMNT)
-        {	// channel L
-			allp_idx = j*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inL * chrp_allp_k[0];  
-            sp_chrp_alp4_buf[allp_idx] = inL - chrp_allp_k[0] * acc;
-            inL = acc;
-            if (++chrp_alp4_idx[j] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j] = 0;   
-            
-			allp_idx = (j+1)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+1];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inL * chrp_allp_k[1];  
-            sp_chrp_alp4_buf[allp_idx] = inL - chrp_allp_k[1] * acc;			
-            inL = acc;
-            if (++chrp_alp4_idx[j+1] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+1] = 0; 
-
-	        allp_idx = (j+2)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+2];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inL * chrp_allp_k[1];  
-            sp_chrp_alp4_buf[allp_idx] = inL - chrp_allp_k[1] * acc;			
-            inL = acc;
-            if (++chrp_alp4_idx[j+2] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+2] = 0; 
-
-			allp_idx = (j+3)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+3];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inL * chrp_allp_k[3];  
-            sp_chrp_alp4_buf[allp_idx] = inL - chrp_allp_k[3] * acc;			
-            inL = acc;
-            if (++chrp_alp4_idx[j+3] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+3] = 0; 
-			// channel R
-			allp_idx = (j+4)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+4];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inR * chrp_allp_k[3];  
-            sp_chrp_alp4_buf[allp_idx] = inR - chrp_allp_k[3] * acc;			
-            inR = acc;
-            if (++chrp_alp4_idx[j+4] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+4] = 0; 
-
-			allp_idx = (j+5)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+5];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inR * chrp_allp_k[2];  
-            sp_chrp_alp4_buf[allp_idx] = inR - chrp_allp_k[2] * acc;			
-            inR = acc;
-            if (++chrp_alp4_idx[j+5] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+5] = 0; 
-
-			allp_idx = (j+6)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+6];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inR * chrp_allp_k[1];  
-            sp_chrp_alp4_buf[allp_idx] = inR - chrp_allp_k[1] * acc;			
-            inR = acc;
-            if (++chrp_alp4_idx[j+6] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+6] = 0; 
-
-			allp_idx = (j+7)*SPRVB_CHIRP4_LEN + chrp_alp4_idx[j+7];
-            acc = sp_chrp_alp4_buf[allp_idx]  + inR * chrp_allp_k[0];  
-            sp_chrp_alp4_buf[allp_idx] = inR - chrp_allp_k[0] * acc;			
-            inR = acc;
-            if (++chrp_alp4_idx[j+7] >= SPRVB_CHIRP4_LEN) chrp_alp4_idx[j+7] = 0; 
-            j = j + 8;
-        }
+		for (j = 0; j < SPRVB_CHIRP_STAGES; j++)
+		{
+			chirp_process(sp_chrp_stage[j] + chrp_idx[j]*SPRVB_CHIRP_AMNT, chrp_k[j], inL, inR);
+			if (++chrp_idx[j] >= chrp_len[j]) chrp_idx[j] = 0;
+		}
 
 		// modulate the allpass filters
 		lfo.get(BASIC_LFO_PHASE_0, &offset, &lfo_fr); 
@@ -378,12 +266,8 @@ void AudioEffectSpringReverb_F32::update()
 		acc = sp_lp_allp2d.getTap(offset+1, lfo_fr);
 		sp_lp_allp2d.write_toOffset(acc, (lfo_ampl<<1)+1);
 
-        blockL->data[i] = inL * wet_gain + dryL * dry_gain; 
-		blockR->data[i] = inR * wet_gain + dryR * dry_gain;
+        dataL[i] = inL * wet_gain + dryL * dry_gain; 
+		dataR[i] = inR * wet_gain + dryR * dry_gain;
 	}
-    AudioStream_F32::transmit(blockL, 0);
-	AudioStream_F32::transmit(blockR, 1);
-	AudioStream_F32::release(blockL);
-	AudioStream_F32::release(blockR);
 #endif
 }
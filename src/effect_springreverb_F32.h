@@ -37,12 +37,19 @@
 #include "basic_components.h"
 
 // Chirp allpass params
-#define SPRVB_CHIRP_AMNT   16      //must be mult of 8
+// amount of chirp allpasses per stage, L+R channel, must be even
+// lower values reduce the CPU load at the cost of less pronounced dispersion
+#ifndef SPRVB_CHIRP_AMNT
+	#define SPRVB_CHIRP_AMNT   16
+#endif
+#define SPRVB_CHIRP_STAGES	4
 #define SPRVB_CHIRP1_LEN    3
 #define SPRVB_CHIRP2_LEN    5
 #define SPRVB_CHIRP3_LEN    6
 #define SPRVB_CHIRP4_LEN    7
 
+static_assert(SPRVB_CHIRP_AMNT >= 2 && (SPRVB_CHIRP_AMNT & 1) == 0, "SPRVB_CHIRP_AMNT must be an even number");
+
 #define SPRVB_ALLP1A_LEN	(224)
 #define SPRVB_ALLP1B_LEN	(420)
 #define SPRVB_ALLP1C_LEN	(856)
@@ -56,13 +63,17 @@
 #define SPRVB_DLY1_LEN	(1945)
 #define SPRVB_DLY2_LEN	(1363)
 
-class AudioEffectSpringReverb_F32 : public AudioStream_F32
+#define SPRVB_LFO_AMPL	(10)	// at 44.1kHz
+
+class AudioEffectSpringReverb_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
     AudioEffectSpringReverb_F32();
+	AudioEffectSpringReverb_F32(const AudioSettings_F32 &settings);
 	~AudioEffectSpringReverb_F32(){};
 
     virtual void update();
+    void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 
     void time(float n)
     {
@@ -140,7 +151,17 @@ public:
 		bypass_set(bp^1);
         return bp;
     } 
+	/**
+	 * @brief allocate the buffers again, ie. after the memory arena was released
+	 * 			mix and reverb parameters are set to defaults
+	 */
+	bool mem_realloc()
+	{
+		begin(fs_set);
+		return initialized;
+	}
 private:
+	void bypass_update();
     audio_block_f32_t *inputQueueArray[2];
 
 	float32_t inputGainSet = 0.5f;
@@ -154,10 +175,13 @@ private:
     bool bp = false;
 	bypass_mode_t bp_mode = BYPASS_MODE_PASS;
 	bool cleanup_done = false;
-    uint16_t chrp_alp1_idx[SPRVB_CHIRP_AMNT] = {0};
-    uint16_t chrp_alp2_idx[SPRVB_CHIRP_AMNT] = {0};
-    uint16_t chrp_alp3_idx[SPRVB_CHIRP_AMNT] = {0};
-    uint16_t chrp_alp4_idx[SPRVB_CHIRP_AMNT] = {0};
+	AudioBasicMemCleaner memCleaner;
+	// all chirp allpasses in a stage have the same length and share one index
+	uint8_t chrp_idx[SPRVB_CHIRP_STAGES] = {0};
+	uint8_t chrp_len[SPRVB_CHIRP_STAGES];	// stage lengths scaled to the sample rate
+	uint32_t chrp_buf_len;
+	// coefficients per stage, interleaved L/R the same way as the buffers
+	float32_t chrp_k[SPRVB_CHIRP_STAGES][SPRVB_CHIRP_AMNT];
 
     static constexpr float32_t rv_time_k_max = 0.97f;
     float32_t rv_time_k;
@@ -172,10 +196,37 @@ private:
 	AudioFilterAllpass<SPRVB_ALLP2D_LEN> sp_lp_allp2c;
 	AudioFilterAllpass<SPRVB_ALLP2D_LEN> sp_lp_allp2d;	
 
-    float32_t *sp_chrp_alp1_buf;
-    float32_t *sp_chrp_alp2_buf;
-    float32_t *sp_chrp_alp3_buf;
-    float32_t *sp_chrp_alp4_buf;
+	// single buffer for the whole chirp network, layout: [stage][position][allpass]
+	// allpasses of the L and R chain are interleaved: L0, R0, L1, R1 ...
+	float32_t *sp_chrp_buf = NULL;
+	float32_t *sp_chrp_stage[SPRVB_CHIRP_STAGES];
+	void begin(float32_t fs);
+	float32_t fs_set = AUDIO_SAMPLE_RATE_EXACT;
+	void chirp_init(void);
+	void chirp_reset(void);
+	/**
+	 * @brief process one sample of both L and R chirp chains in one stage
+	 * 
+	 * @param row buffer row for the current stage index
+	 * @param k interleaved L/R coefficients
+	 */
+	static inline void chirp_process(float32_t *row, const float32_t *k, float32_t &inL, float32_t &inR)
+	{
+		float32_t l = inL;
+		float32_t r = inR;
+		float32_t accL, accR;
+		for (int j = 0; j < SPRVB_CHIRP_AMNT; j += 2)
+		{
+			accL = row[j] + l * k[j];
+			accR = row[j+1] + r * k[j+1];
+			row[j] = l - k[j] * accL;
+			row[j+1] = r - k[j+1] * accR;
+			l = accL;
+			r = accR;
+		}
+		inL = l;
+		inR = r;
+	}
 
 	AudioBasicDelay lp_dly1;
 	AudioBasicDelay lp_dly2;
@@ -190,7 +241,7 @@ private:
 	AudioFilterShelvingLPHP flt_lp1;
 	AudioFilterShelvingLPHP flt_lp2;
 
-	static const uint8_t lfo_ampl = 10;
+	uint8_t lfo_ampl = SPRVB_LFO_AMPL;
 	AudioBasicLfo lfo = AudioBasicLfo(1.35f, lfo_ampl);
 
 	bool initialized = false;
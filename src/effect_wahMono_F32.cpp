@@ -41,21 +41,15 @@ const AudioEffectWahMono_F32::wah_componentValues_t AudioEffectWahMono_F32::comp
 
 void AudioEffectWahMono_F32::update()
 {
+	AudioBasicDenormalGuard ftz;
 	audio_block_f32_t *blockL, *blockR, *blockMod;
 	float32_t a0, a1, a2, ax, drySig;
 	uint16_t i;
-	if (bp) // handle bypass
+	if (bpx.passThrough()) // fully bypassed, pass the read only blocks
 	{
 		blockL = AudioStream_F32::receiveReadOnly_f32(0);
 		blockR = AudioStream_F32::receiveReadOnly_f32(1);
-		if (!blockL || !blockR)
-		{
-			if (blockL)
-				AudioStream_F32::release(blockL);
-			if (blockR)
-				AudioStream_F32::release(blockR);
-			return;
-		}
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
 		AudioStream_F32::transmit(blockL, 0);
 		AudioStream_F32::transmit(blockR, 1);
 		AudioStream_F32::release(blockL);
@@ -73,6 +67,7 @@ void AudioEffectWahMono_F32::update()
 		return;
 	}
 	blockMod = AudioStream_F32::receiveReadOnly_f32(2);
+	bpx.storeDry(blockL->data, blockR->data, blockL->length);	// only during the bypass crossfade
 
 	arm_add_f32(blockL->data, blockR->data, blockL->data, blockL->length); // add two channels
 	arm_scale_f32(blockL->data, input_gain, blockL->data, blockL->length);
@@ -104,7 +99,7 @@ void AudioEffectWahMono_F32::update()
 		//run it through the 1-pole HPF and gain first
 		float32_t hpf = ghpf * (drySig - xh1) - a1p*yh1;
 		xh1 = drySig;
-		yh1 = hpf;
+		yh1 = denormal_bias(hpf);
 
 		//Apply modulated biquad
 		float32_t y0 = b0*hpf + b1*x1 + b2*x2 + a1*y1 + a2*y2;
@@ -114,15 +109,24 @@ void AudioEffectWahMono_F32::update()
 		x2 = x1;
 		x1 = hpf;
 		y2 = y1;
-		y1 = y0;
+		y1 = denormal_bias(y0);
 		
 		out = out * wet_gain + drySig * dry_gain;
 
 		blockL->data[i] = out;
 		blockR->data[i] = out;
 	}
-	AudioStream_F32::transmit(blockL, 0); // send blockL on both output channels
-	AudioStream_F32::transmit(blockL, 1);
+	if (bpx.xfadeActive()) // bypass crossfade, mix the mono wet signal with the stereo dry input
+	{
+		bpx.process(blockL->data, blockR->data, blockL->length);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::transmit(blockR, 1);
+	}
+	else
+	{
+		AudioStream_F32::transmit(blockL, 0); // send blockL on both output channels
+		AudioStream_F32::transmit(blockL, 1);
+	}
 	AudioStream_F32::release(blockL);
 	AudioStream_F32::release(blockR);
 	if (blockMod) AudioStream_F32::release(blockMod);
@@ -25,6 +25,7 @@
 #include <Arduino.h>
 #include "AudioStream_F32.h"
 #include "basic_DSPutils.h"
+#include "basic_bypassStereo_F32.h"
 
 typedef enum
 {
@@ -80,15 +81,15 @@ public:
 		wet_gain = wet;
 		__enable_irq();
 	}
-    bool bypass_get(void) {return bp;}
-    void bypass_set(bool state) {bp = state;}
-    bool bypass_tgl(void) 
-    {
-        bp ^= 1; 
-        return bp;
-    }	
+    bool bypass_get(void) {return bpx.get();}
+    void bypass_set(bool state) {bpx.set(state);}
+    bool bypass_tgl(void) {return bpx.tgl();}
+    /**
+     * @brief bypass crossfade length in audio blocks
+     */
+    void bypass_setFade(uint16_t blocks) {bpx.setFadeBlocks(blocks);}
 private:
-	bool bp = true; // bypass flag
+	AudioBasicBypassXfade bpx;	// crossfading bypass, starts bypassed
 	audio_block_f32_t *inputQueueArray_f32[3];
 	uint16_t block_size = AUDIO_BLOCK_SAMPLES;
 	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
@@ -24,6 +24,8 @@
 #include "AudioStream_F32.h"
 #include "arm_math.h"
 #include "mathDSP_F32.h"
+#include "basic_denormal.h"
+#include "basic_bypassStereo_F32.h"
 
 class AudioFilterEqualizer3band_F32 : public AudioStream_F32
 {
@@ -32,10 +34,15 @@ public:
 	{
 		setBands(500.0f, 3000.0f);
 	}
+	AudioFilterEqualizer3band_F32(const AudioSettings_F32 &settings) : AudioStream_F32(1, inputQueueArray)
+	{
+		fs = settings.sample_rate_Hz;
+		setBands(500.0f, 3000.0f);
+	}
 	void setBands(float32_t bassF, float32_t trebleF)
 	{
-		trebleF = 2.0f * sinf(M_PI * (trebleF / AUDIO_SAMPLE_RATE_EXACT));
-		bassF = 2.0f * sinf(M_PI * (bassF / AUDIO_SAMPLE_RATE_EXACT));
+		trebleF = 2.0f * sinf(M_PI * (trebleF / fs));
+		bassF = 2.0f * sinf(M_PI * (bassF / fs));
 
 		__disable_irq();
 		lowpass_f = bassF;
@@ -71,6 +78,7 @@ public:
 	}
 	void update()
 	{
+		AudioBasicDenormalGuard ftz;
 		audio_block_f32_t *block;
 		int i;
 		block = AudioStream_F32::receiveWritable_f32();
@@ -148,6 +156,7 @@ private:
 	float32_t hipass_f;
 	float32_t treble_g = 1.0f;
 	float32_t mid_g = 1.0f;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 };
 
 class AudioFilterEqualizer3bandStereo_F32 : public AudioStream_F32
@@ -157,10 +166,15 @@ public:
 	{
 		setBands(500.0f, 3000.0f);
 	}
+	AudioFilterEqualizer3bandStereo_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray)
+	{
+		fs = settings.sample_rate_Hz;
+		setBands(500.0f, 3000.0f);
+	}
 	void setBands(float32_t bassF, float32_t trebleF)
 	{
-		trebleF = 2.0f * sinf(M_PI * (trebleF / AUDIO_SAMPLE_RATE_EXACT));
-		bassF = 2.0f * sinf(M_PI * (bassF / AUDIO_SAMPLE_RATE_EXACT));
+		trebleF = 2.0f * sinf(M_PI * (trebleF / fs));
+		bassF = 2.0f * sinf(M_PI * (bassF / fs));
 
 		__disable_irq();
 		lowpass_f = bassF;
@@ -196,20 +210,14 @@ public:
 	}
 	void update()
 	{
+		AudioBasicDenormalGuard ftz;
 		audio_block_f32_t *blockL, *blockR;
 		int i;
 		if (bp) // bypass mode
 		{
 			blockL = AudioStream_F32::receiveReadOnly_f32(0);
 			blockR = AudioStream_F32::receiveReadOnly_f32(1);
-			if (!blockL || !blockR)
-			{
-				if (blockL)
-					AudioStream_F32::release(blockL);
-				if (blockR)
-					AudioStream_F32::release(blockR);
-				return;
-			}
+			bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
 			AudioStream_F32::transmit(blockL, 0);
 			AudioStream_F32::transmit(blockR, 1);
 			AudioStream_F32::release(blockL);
@@ -327,6 +335,7 @@ private:
 	float32_t hipass_f;
 	float32_t treble_g = 1.0f;
 	float32_t mid_g = 1.0f;
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 };
 
 #endif
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include <AudioStream_F32.h>
 #include "basic_DSPutils.h"
+#include "basic_bypassStereo_F32.h"
 #include <arm_math.h>
 
 //   y = x - xm1 + 0.995 * ym1;
@@ -44,6 +45,7 @@ public:
 
 	void update()
 	{
+		AudioBasicDenormalGuard ftz;
 		audio_block_f32_t *blockL, *blockR;
 		uint16_t i;
 		float32_t tmpf32;
@@ -52,14 +54,7 @@ public:
 		{
 			blockL = AudioStream_F32::receiveReadOnly_f32(0);
 			blockR = AudioStream_F32::receiveReadOnly_f32(1);
-			if (!blockL || !blockR)
-			{
-				if (blockL)
-					AudioStream_F32::release(blockL);
-				if (blockR)
-					AudioStream_F32::release(blockR);
-				return;
-			}
+			bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);	// missing input replaced with silence
 			AudioStream_F32::transmit(blockL, 0);
 			AudioStream_F32::transmit(blockR, 1);
 			AudioStream_F32::release(blockL);
@@ -85,42 +80,42 @@ public:
 		for (i=0; i<blockSize; i=i+4)
 		{
 			tmpf32 = blockL->data[i] - _xRegL + k * _yRegL;
-			_yRegL = tmpf32;
+			_yRegL = denormal_bias(tmpf32);
 			_xRegL = blockL->data[i];
 			blockL->data[i] = _yRegL;
 
 			tmpf32 = blockL->data[i+1] - _xRegL + k * _yRegL;
-			_yRegL = tmpf32;
+			_yRegL = denormal_bias(tmpf32);
 			_xRegL = blockL->data[i+1];
 			blockL->data[i+1] = _yRegL;
 
 			tmpf32 = blockL->data[i+2] - _xRegL + k * _yRegL;
-			_yRegL = tmpf32;
+			_yRegL = denormal_bias(tmpf32);
 			_xRegL = blockL->data[i+2];
 			blockL->data[i+2] = _yRegL;
 
 			tmpf32 = blockL->data[i+3] - _xRegL + k * _yRegL;
-			_yRegL = tmpf32;
+			_yRegL = denormal_bias(tmpf32);
 			_xRegL = blockL->data[i+3];
 			blockL->data[i+3] = _yRegL;
 
 			tmpf32 = blockR->data[i] - _xRegR + k * _yRegR;
-			_yRegR = tmpf32;
+			_yRegR = denormal_bias(tmpf32);
 			_xRegR = blockR->data[i];
 			blockR->data[i] = _yRegR;
 
 			tmpf32 = blockR->data[i+1] - _xRegR + k * _yRegR;
-			_yRegR = tmpf32;
+			_yRegR = denormal_bias(tmpf32);
 			_xRegR = blockR->data[i+1];
 			blockR->data[i+1] = _yRegR;
 
 			tmpf32 = blockR->data[i+2] - _xRegR + k * _yRegR;
-			_yRegR = tmpf32;
+			_yRegR = denormal_bias(tmpf32);
 			_xRegR = blockR->data[i+2];
 			blockR->data[i+2] = _yRegR;
 
 			tmpf32 = blockR->data[i+3] - _xRegR + k * _yRegR;
-			_yRegR = tmpf32;
+			_yRegR = denormal_bias(tmpf32);
 			_xRegR = blockR->data[i+3];
 			blockR->data[i+3] = _yRegR;
 		}
@@ -2,6 +2,7 @@
 
 void AudioFilterBiquadStereo_F32::update(void)
 {
+	AudioBasicDenormalGuard ftz;
 	audio_block_f32_t *blockL, *blockR, *blockOutL, *blockOutR;
 	blockL = AudioStream_F32::receiveWritable_f32(0);
 	blockR = AudioStream_F32::receiveWritable_f32(1);
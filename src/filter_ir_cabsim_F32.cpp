@@ -22,13 +22,57 @@
  */
 #include "filter_ir_cabsim_F32.h"
 
+const float32_t AudioFilterIRCabsim_F32::FIRk_preL[nfir] = {
+	 0.000894872763f,  0.00020902598f,  0.000285242248f,  0.000503875781f,  0.00207542209f,  0.0013392308f, 
+	-0.00476867426f,  -0.0112718018f,  -0.00560652791f,   0.0158470348f,    0.0319586769f,   0.0108086104f, 
+	-0.0470990688f,   -0.0834295526f,  -0.0208595414f,    0.154734746f,     0.35352844f,     0.441179603f, 
+	 0.35352844f,      0.154734746f,   -0.0208595414f,   -0.0834295526f,   -0.0470990688f,   0.0108086104f, 
+	 0.0319586769f,    0.0158470348f,  -0.00560652791f,  -0.0112718018f,   -0.00476867426f,  0.0013392308f };
+const float32_t AudioFilterIRCabsim_F32::FIRk_preR[nfir] = {
+	 0.00020902598f,   0.000285242248f, 0.000503875781f,  0.00207542209f,   0.0013392308f,  -0.00476867426f, 
+	-0.0112718018f,   -0.00560652791f,  0.0158470348f,    0.0319586769f,    0.0108086104f,  -0.0470990688f,
+	-0.0834295526f,   -0.0208595414f,   0.154734746f,     0.35352844f,      0.441179603f,    0.35352844f, 
+	 0.154734746f,    -0.0208595414f,  -0.0834295526f,   -0.0470990688f,    0.0108086104f,   0.0319586769f, 
+	 0.0158470348f,   -0.00560652791f, -0.0112718018f,   -0.00476867426f,   0.0013392308f,   0.00207542209f };
+const float32_t AudioFilterIRCabsim_F32::FIRk_postL[nfir] = {
+	 0.000285242248f,  0.000503875781f, 0.00207542209f,   0.0013392308f,   -0.00476867426f, -0.0112718018f,
+	-0.00560652791f,   0.0158470348f,   0.0319586769f,    0.0108086104f,   -0.0470990688f,  -0.0834295526f,
+	-0.0208595414f,    0.154734746f,    0.35352844f,      0.441179603f,     0.35352844f,     0.154734746f,
+	-0.0208595414f,   -0.0834295526f,  -0.0470990688f,    0.0108086104f,    0.0319586769f,   0.0158470348f,
+	-0.00560652791f,  -0.0112718018f,  -0.00476867426f,   0.0013392308f,    0.00207542209f,  0.000503875781f };
+const float32_t AudioFilterIRCabsim_F32::FIRk_postR[nfir] = {
+	 0.000503875781f,  0.00207542209f,  0.0013392308f,   -0.00476867426f,  -0.0112718018f,  -0.00560652791f, 
+	 0.0158470348f,    0.0319586769f,   0.0108086104f,   -0.0470990688f,   -0.0834295526f,  -0.0208595414f, 
+	 0.154734746f,     0.35352844f,     0.441179603f,     0.35352844f,      0.154734746f,   -0.0208595414f,
+	-0.0834295526f,   -0.0470990688f,   0.0108086104f,    0.0319586769f,    0.0158470348f,  -0.00560652791f, 
+	-0.0112718018f,   -0.00476867426f,  0.0013392308f,    0.00207542209f,   0.000503875781f, 0.0f };
+
 AudioFilterIRCabsim_F32::AudioFilterIRCabsim_F32() : AudioStream_F32(2, inputQueueArray_f32)
 {
-	if (!delay.init(delay_l)) return;
-	last_sample_buffer_L = (float32_t*)malloc(IR_BUFFER_SIZE * IR_N_B * sizeof(float32_t));
-	last_sample_buffer_R = (float32_t*)malloc(IR_BUFFER_SIZE * IR_N_B * sizeof(float32_t));
-	maskgen = (float32_t*)malloc(IR_FFT_LENGTH * 2 * sizeof(float32_t));
-	fftout = (float32_t*)malloc(IR_NFORMAX * IR_FFT_LENGTH * 2 * sizeof(float32_t));
+	init();
+}
+
+AudioFilterIRCabsim_F32::AudioFilterIRCabsim_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32)
+{
+	block_size = settings.audio_block_samples;
+	fs = settings.sample_rate_Hz;
+	init();
+}
+
+void AudioFilterIRCabsim_F32::init()
+{
+	AudioBasicMemArenaOwner memOwner(this, "IRCabsim");
+	initialized = false;
+	ir_loaded = 0;
+	AudioBasicMemArena::free(last_sample_buffer_L);
+	AudioBasicMemArena::free(last_sample_buffer_R);
+	AudioBasicMemArena::free(maskgen);
+	AudioBasicMemArena::free(fftout);
+	if (!delay.init(delay_time_s * fs)) return;
+	last_sample_buffer_L = (float32_t*)AudioBasicMemArena::alloc(IR_BUFFER_SIZE * IR_N_B * sizeof(float32_t), ARENA_RAM1);
+	last_sample_buffer_R = (float32_t*)AudioBasicMemArena::alloc(IR_BUFFER_SIZE * IR_N_B * sizeof(float32_t), ARENA_RAM1);
+	maskgen = (float32_t*)AudioBasicMemArena::alloc(IR_FFT_LENGTH * 2 * sizeof(float32_t));
+	fftout = (float32_t*)AudioBasicMemArena::alloc(IR_NFORMAX * IR_FFT_LENGTH * 2 * sizeof(float32_t));
 	if (!last_sample_buffer_L || !last_sample_buffer_R || !maskgen || !fftout) return;
 
 	memset(maskgen, 0, IR_FFT_LENGTH * 2 * sizeof(float32_t));
@@ -41,12 +85,37 @@ AudioFilterIRCabsim_F32::AudioFilterIRCabsim_F32() : AudioStream_F32(2, inputQue
 	initialized = true;
 }
 
+/**
+ * @brief allocate the buffers again, ie. after the memory arena was released
+ * 			the current IR is loaded again
+ */
+bool AudioFilterIRCabsim_F32::mem_realloc()
+{
+	uint8_t idx = ir_idx;
+	init();
+	ir_idx = 0xFF;
+	if (initialized) ir_load(idx);
+	return initialized;
+}
+
 void AudioFilterIRCabsim_F32::update()
 {
 #if defined(__IMXRT1062__)
 	if (!initialized) return;
 	audio_block_f32_t *blockL, *blockR;
 
+	if (!ir_loaded || bp) // ir not loaded yet or bypass mode
+	{
+		// bypass clean signal, read only blocks
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);
+		AudioStream_F32::transmit(blockL, 0);
+		AudioStream_F32::release(blockL);
+		AudioStream_F32::transmit(blockR, 1);
+		AudioStream_F32::release(blockR);
+		return;
+	}
 	blockL = AudioStream_F32::receiveWritable_f32(0);
 	blockR = AudioStream_F32::receiveWritable_f32(1);
 	if (!blockL || !blockR)
@@ -55,42 +124,46 @@ void AudioFilterIRCabsim_F32::update()
 		if (blockR) AudioStream_F32::release(blockR);
 		return;
 	}
-	if (!ir_loaded) // ir not loaded yet or bypass mode
-	{
-		// bypass clean signal
-		AudioStream_F32::transmit(blockL, 0);
-		AudioStream_F32::release(blockL);
-		AudioStream_F32::transmit(blockR, 1);
-		AudioStream_F32::release(blockR);
-		return;
-	}
 
+	process(blockL->data, blockR->data, blockL->length);
+	AudioStream_F32::transmit(blockL, 0);
+	AudioStream_F32::release(blockL);
+	AudioStream_F32::transmit(blockR, 1);
+	AudioStream_F32::release(blockR);
+#endif
+}
+
+void AudioFilterIRCabsim_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+#if defined(__IMXRT1062__)
+	if (!initialized || !ir_loaded || bp) return;
 	if (first_block) // fill real & imaginaries with zeros for the first BLOCKSIZE samples
 	{
-		memset(&fftin[0], 0, blockL->length*sizeof(float32_t)*4);
+		memset(&fftin[0], 0, len*sizeof(float32_t)*4);
+		memset(ptr_fftout, 0, nfor*512*4);	// no old tail after the bypass
 		first_block = 0;
 	}
 	else
 	{
-		memcpyInterleave_f32(last_sample_buffer_L, last_sample_buffer_R, fftin, blockL->length);
+		memcpyInterleave_f32(last_sample_buffer_L, last_sample_buffer_R, fftin, len);
 	}
 	if (doubleTrack)
 	{
-		arm_fir_f32(&FIR_preL, blockL->data, blockL->data, blockL->length);
-		arm_fir_f32(&FIR_preR, blockR->data, blockR->data, blockR->length);
+		arm_fir_f32(&FIR_preL, dataL, dataL, len);
+		arm_fir_f32(&FIR_preR, dataR, dataR, len);
 		// invert phase for channel R
-		arm_scale_f32(blockR->data, -1.0f, blockR->data, blockR->length);
+		arm_scale_f32(dataR, -1.0f, dataR, len);
 		// run channelR delay
-		for (int i=0; i<blockR->length; i++)
+		for (uint32_t i=0; i<len; i++)
 		{
-			blockR->data[i] = delay.process(blockR->data[i]);
+			dataR[i] = delay.process(dataR[i]);
 			delay.updateIndex();
 		}
 	}
-	arm_copy_f32(blockL->data, last_sample_buffer_L, blockL->length);
-	arm_copy_f32(blockR->data, last_sample_buffer_R, blockR->length);
+	arm_copy_f32(dataL, last_sample_buffer_L, len);
+	arm_copy_f32(dataR, last_sample_buffer_R, len);
 
-	memcpyInterleave_f32(last_sample_buffer_L, last_sample_buffer_R, fftin + FFT_L, blockL->length); // interleave copy it to fftin at offset FFT_L
+	memcpyInterleave_f32(last_sample_buffer_L, last_sample_buffer_R, fftin + FFT_L, len); // interleave copy it to fftin at offset FFT_L
 	arm_cfft_f32(S, fftin, 0, 1);
 
 	uint32_t buffidx512 = buffidx * 512;
@@ -127,23 +200,19 @@ void AudioFilterIRCabsim_F32::update()
 
 	arm_cfft_f32(iS, accum, 1, 1);
 
-	for (int i = 0; i < blockL->length; i++)
+	for (uint32_t i = 0; i < len; i++)
 	{
-		blockL->data[i] = accum[i * 2 + 0];
-		blockR->data[i] = accum[i * 2 + 1];
+		dataL[i] = accum[i * 2 + 0];
+		dataR[i] = accum[i * 2 + 1];
 	}
 	// apply post EQ, restore the channel R phase, reduce the gain a bit
 	if (doubleTrack)  
 	{
-		arm_fir_f32(&FIR_postL, blockL->data, blockL->data, blockL->length);
-		arm_fir_f32(&FIR_postR, blockR->data, blockR->data, blockR->length);
-		arm_scale_f32(blockR->data, -doubler_gainR, blockR->data, blockR->length);
-		arm_scale_f32(blockL->data, doubler_gainL, blockL->data, blockL->length);		
+		arm_fir_f32(&FIR_postL, dataL, dataL, len);
+		arm_fir_f32(&FIR_postR, dataR, dataR, len);
+		arm_scale_f32(dataR, -doubler_gainR, dataR, len);
+		arm_scale_f32(dataL, doubler_gainL, dataL, len);		
 	}
-	AudioStream_F32::transmit(blockL, 0);
-	AudioStream_F32::release(blockL);
-	AudioStream_F32::transmit(blockR, 1);
-	AudioStream_F32::release(blockR);
 #endif
 }
 
@@ -177,7 +246,7 @@ void AudioFilterIRCabsim_F32::ir_load(uint8_t idx)
 	nc = newIrPtr[0];
 	nfor = nc / IR_BUFFER_SIZE;
 	if (nfor > nforMax) nfor = nforMax;
-	ir_length_ms =  (1000.0f * nfor * (float32_t)AUDIO_BLOCK_SAMPLES) / AUDIO_SAMPLE_RATE_EXACT;
+	ir_length_ms =  (1000.0f * nfor * (float32_t)AUDIO_BLOCK_SAMPLES) / fs;
 	ptr_fmask = &fmask[0][0];
 	ptr_fftout = &fftout[0];
 	memset(ptr_fftout, 0, nfor*512*4);  // clear fftout array
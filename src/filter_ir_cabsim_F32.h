@@ -33,6 +33,8 @@
 #include "basic_delay.h"
 #include "basic_shelvFilter.h"
 #include "basic_DSPutils.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
 #include <arm_const_structs.h>
 
 
@@ -43,11 +45,13 @@
 #define IR_MAX_REG_NUM  11       // max number of registered IRs
 
 
-class AudioFilterIRCabsim_F32 : public AudioStream_F32
+class AudioFilterIRCabsim_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
     AudioFilterIRCabsim_F32();
+	AudioFilterIRCabsim_F32(const AudioSettings_F32 &settings);
     virtual void update(void);
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
     void ir_register(const float32_t *irPtr, uint8_t position);
     void ir_load(uint8_t idx);
     uint8_t ir_get(void) {return ir_idx;} 
@@ -77,7 +81,25 @@ public:
 		return doubleTrack;
 	}
 	bool doubler_get() {return doubleTrack;}
+	/**
+	 * @brief bypass the speaker simulation, the loaded IR is kept
+	 * 			the convolution restarts from silence when switched on
+	 */
+	void bypass_set(bool state)
+	{
+		__disable_irq();
+		if (bp && !state) first_block = 1;
+		bp = state;
+		__enable_irq();
+	}
+	bool bypass_get(void) {return bp;}
+	bool bypass_tgl(void)
+	{
+		bypass_set(bp ^ 1);
+		return bp;
+	}
 	bool init_done() {return initialized;}
+	bool mem_realloc();
 private:
     audio_block_f32_t *inputQueueArray_f32[2];
 	uint16_t block_size = AUDIO_BLOCK_SAMPLES;
@@ -88,20 +110,22 @@ private:
     const uint32_t FFT_L = IR_FFT_LENGTH;
     uint8_t first_block = 1;
     uint8_t ir_loaded = 0;  
+	bool bp = false;
     uint8_t ir_idx = 0xFF;
     uint32_t nfor = 0;
     const uint32_t nforMax = IR_NFORMAX;
 
     int buffidx = 0;
     int k = 0;
-	float32_t fmask[IR_NFORMAX][IR_FFT_LENGTH * 2];
-	float32_t ac2[512];
-	float32_t accum[IR_FFT_LENGTH * 2];
-	float32_t fftin[IR_FFT_LENGTH * 2];
-	float32_t* last_sample_buffer_R;
-	float32_t* last_sample_buffer_L;
-	float32_t* maskgen;
-	float32_t* fftout;
+	// per block FFT working buffers, cache line aligned
+	ARENA_ALIGNED float32_t fmask[IR_NFORMAX][IR_FFT_LENGTH * 2];
+	ARENA_ALIGNED float32_t ac2[512];
+	ARENA_ALIGNED float32_t accum[IR_FFT_LENGTH * 2];
+	ARENA_ALIGNED float32_t fftin[IR_FFT_LENGTH * 2];
+	float32_t* last_sample_buffer_R = NULL;
+	float32_t* last_sample_buffer_L = NULL;
+	float32_t* maskgen = NULL;
+	float32_t* fftout = NULL;
 
 	float32_t* ptr_fftout;
 	float32_t* ptr_fmask;
@@ -115,7 +139,8 @@ private:
 	
     uint32_t N_BLOCKS = IR_N_B;
 
-	static const uint32_t delay_l = AUDIO_SAMPLE_RATE * 0.01277f; 	//15ms delay
+	static constexpr float32_t delay_time_s = 0.01277f; 	//12.77ms doubler delay
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 	AudioBasicDelay delay;
 
 	float32_t ir_length_ms = 0.0f;
@@ -125,6 +150,7 @@ private:
         ir_1_guitar, ir_2_guitar, ir_3_guitar, ir_4_guitar, ir_10_guitar, ir_11_guitar, ir_6_guitar, ir_7_bass,  ir_8_bass, ir_9_bass, NULL
     };
     void init_partitioned_filter_masks(const float32_t *irPtr);
+	void init();
 	bool initialized = false;
 	
 	// stereo doubler
@@ -133,31 +159,12 @@ private:
 	bool doubleTrack = false;
 	static const uint8_t nfir = 30;	// fir taps
 	arm_fir_instance_f32 FIR_preL, FIR_preR, FIR_postL, FIR_postR;
-	float32_t FIRstate[4][AUDIO_BLOCK_SAMPLES + nfir];
-	float32_t FIRk_preL[30] = {
-		 0.000894872763f,  0.00020902598f,  0.000285242248f,  0.000503875781f,  0.00207542209f,  0.0013392308f, 
-		-0.00476867426f,  -0.0112718018f,  -0.00560652791f,   0.0158470348f,    0.0319586769f,   0.0108086104f, 
-		-0.0470990688f,   -0.0834295526f,  -0.0208595414f,    0.154734746f,     0.35352844f,     0.441179603f, 
-		 0.35352844f,      0.154734746f,   -0.0208595414f,   -0.0834295526f,   -0.0470990688f,   0.0108086104f, 
-		 0.0319586769f,    0.0158470348f,  -0.00560652791f,  -0.0112718018f,   -0.00476867426f,  0.0013392308f };
-	float32_t FIRk_preR[30] = {
-		 0.00020902598f,   0.000285242248f, 0.000503875781f,  0.00207542209f,   0.0013392308f,  -0.00476867426f, 
-		-0.0112718018f,   -0.00560652791f,  0.0158470348f,    0.0319586769f,    0.0108086104f,  -0.0470990688f,
-		-0.0834295526f,   -0.0208595414f,   0.154734746f,     0.35352844f,      0.441179603f,    0.35352844f, 
-		 0.154734746f,    -0.0208595414f,  -0.0834295526f,   -0.0470990688f,    0.0108086104f,   0.0319586769f, 
-		 0.0158470348f,   -0.00560652791f, -0.0112718018f,   -0.00476867426f,   0.0013392308f,   0.00207542209f };
-	float32_t FIRk_postL[30] = {
-		 0.000285242248f,  0.000503875781f, 0.00207542209f,   0.0013392308f,   -0.00476867426f, -0.0112718018f,
-		-0.00560652791f,   0.0158470348f,   0.0319586769f,    0.0108086104f,   -0.0470990688f,  -0.0834295526f,
-		-0.0208595414f,    0.154734746f,    0.35352844f,      0.441179603f,     0.35352844f,     0.154734746f,
-		-0.0208595414f,   -0.0834295526f,  -0.0470990688f,    0.0108086104f,    0.0319586769f,   0.0158470348f,
-		-0.00560652791f,  -0.0112718018f,  -0.00476867426f,   0.0013392308f,    0.00207542209f,  0.000503875781f };
-	float32_t FIRk_postR[30] = {
-		 0.000503875781f,  0.00207542209f,  0.0013392308f,   -0.00476867426f,  -0.0112718018f,  -0.00560652791f, 
-		 0.0158470348f,    0.0319586769f,   0.0108086104f,   -0.0470990688f,   -0.0834295526f,  -0.0208595414f, 
-		 0.154734746f,     0.35352844f,     0.441179603f,     0.35352844f,      0.154734746f,   -0.0208595414f,
-		-0.0834295526f,   -0.0470990688f,   0.0108086104f,    0.0319586769f,    0.0158470348f,  -0.00560652791f, 
-		-0.0112718018f,   -0.00476867426f,  0.0013392308f,    0.00207542209f,   0.000503875781f, 0.0f };
+	ARENA_ALIGNED float32_t FIRstate[4][AUDIO_BLOCK_SAMPLES + nfir];
+	// stereo doubler filter kernels, shared by all instances
+	static const float32_t FIRk_preL[nfir];
+	static const float32_t FIRk_preR[nfir];
+	static const float32_t FIRk_postL[nfir];
+	static const float32_t FIRk_postR[nfir];
 
 }; 
 
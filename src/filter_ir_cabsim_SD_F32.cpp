@@ -540,18 +540,56 @@ const char* AudioFilterIRCabsim_SD_F32::default_conf_path = default_conf_path_da
 
 const char* const* AudioFilterIRCabsim_SD_F32::err_msg = err_msg_data;
 
+const float32_t AudioFilterIRCabsim_SD_F32::FIRk_preL[nfir] = {
+	 0.000894872763f,  0.00020902598f,  0.000285242248f,  0.000503875781f,  0.00207542209f,  0.0013392308f, 
+	-0.00476867426f,  -0.0112718018f,  -0.00560652791f,   0.0158470348f,    0.0319586769f,   0.0108086104f, 
+	-0.0470990688f,   -0.0834295526f,  -0.0208595414f,    0.154734746f,     0.35352844f,     0.441179603f, 
+	 0.35352844f,      0.154734746f,   -0.0208595414f,   -0.0834295526f,   -0.0470990688f,   0.0108086104f, 
+	 0.0319586769f,    0.0158470348f,  -0.00560652791f,  -0.0112718018f,   -0.00476867426f,  0.0013392308f };
+const float32_t AudioFilterIRCabsim_SD_F32::FIRk_preR[nfir] = {
+	 0.00020902598f,   0.000285242248f, 0.000503875781f,  0.00207542209f,   0.0013392308f,  -0.00476867426f, 
+	-0.0112718018f,   -0.00560652791f,  0.0158470348f,    0.0319586769f,    0.0108086104f,  -0.0470990688f,
+	-0.0834295526f,   -0.0208595414f,   0.154734746f,     0.35352844f,      0.441179603f,    0.35352844f, 
+	 0.154734746f,    -0.0208595414f,  -0.0834295526f,   -0.0470990688f,    0.0108086104f,   0.0319586769f, 
+	 0.0158470348f,   -0.00560652791f, -0.0112718018f,   -0.00476867426f,   0.0013392308f,   0.00207542209f };
+const float32_t AudioFilterIRCabsim_SD_F32::FIRk_postL[nfir] = {
+	 0.000285242248f,  0.000503875781f, 0.00207542209f,   0.0013392308f,   -0.00476867426f, -0.0112718018f,
+	-0.00560652791f,   0.0158470348f,   0.0319586769f,    0.0108086104f,   -0.0470990688f,  -0.0834295526f,
+	-0.0208595414f,    0.154734746f,    0.35352844f,      0.441179603f,     0.35352844f,     0.154734746f,
+	-0.0208595414f,   -0.0834295526f,  -0.0470990688f,    0.0108086104f,    0.0319586769f,   0.0158470348f,
+	-0.00560652791f,  -0.0112718018f,  -0.00476867426f,   0.0013392308f,    0.00207542209f,  0.000503875781f };
+const float32_t AudioFilterIRCabsim_SD_F32::FIRk_postR[nfir] = {
+	 0.000503875781f,  0.00207542209f,  0.0013392308f,   -0.00476867426f,  -0.0112718018f,  -0.00560652791f, 
+	 0.0158470348f,    0.0319586769f,   0.0108086104f,   -0.0470990688f,   -0.0834295526f,  -0.0208595414f, 
+	 0.154734746f,     0.35352844f,     0.441179603f,     0.35352844f,      0.154734746f,   -0.0208595414f,
+	-0.0834295526f,   -0.0470990688f,   0.0108086104f,    0.0319586769f,    0.0158470348f,  -0.00560652791f, 
+	-0.0112718018f,   -0.00476867426f,  0.0013392308f,    0.00207542209f,   0.000503875781f, 0.0f };
+
 AudioFilterIRCabsim_SD_F32::AudioFilterIRCabsim_SD_F32() : AudioStream_F32(2, inputQueueArray_f32)
 {
-	if (!delay.init(delay_l)) 
+	init();
+}
+
+AudioFilterIRCabsim_SD_F32::AudioFilterIRCabsim_SD_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32)
+{
+	block_size = settings.audio_block_samples;
+	fs = settings.sample_rate_Hz;
+	init();
+}
+
+void AudioFilterIRCabsim_SD_F32::init()
+{
+	AudioBasicMemArenaOwner memOwner(this, "IRCabsimSD");
+	if (!delay.init(delay_time_s * fs)) 
 	{
 		return;
 	}
-	last_sample_buffer_L = (float32_t*)malloc(TCAB_BUFFER_SIZE * TCAB_N_B * sizeof(float32_t));
-	last_sample_buffer_R = (float32_t*)malloc(TCAB_BUFFER_SIZE * TCAB_N_B * sizeof(float32_t));
-	maskgen = (float32_t*)malloc(TCAB_FFT_LENGTH * 2 * sizeof(float32_t));
-	fftout = (float32_t*)malloc(TCAB_NFORMAX * TCAB_FFT_LENGTH * 2 * sizeof(float32_t));
-	wav_ir_data = (float32_t*)malloc(TCAB_IR_LEN_MAX_SAMPLES * sizeof(float32_t));
-	ir_file_name = (char*)malloc(TCAB_IR_NAME_SIZE_BYTES);
+	last_sample_buffer_L = (float32_t*)AudioBasicMemArena::alloc(TCAB_BUFFER_SIZE * TCAB_N_B * sizeof(float32_t), ARENA_RAM1);
+	last_sample_buffer_R = (float32_t*)AudioBasicMemArena::alloc(TCAB_BUFFER_SIZE * TCAB_N_B * sizeof(float32_t), ARENA_RAM1);
+	maskgen = (float32_t*)AudioBasicMemArena::alloc(TCAB_FFT_LENGTH * 2 * sizeof(float32_t));
+	fftout = (float32_t*)AudioBasicMemArena::alloc(TCAB_NFORMAX * TCAB_FFT_LENGTH * 2 * sizeof(float32_t));
+	wav_ir_data = (float32_t*)AudioBasicMemArena::alloc(TCAB_IR_LEN_MAX_SAMPLES * sizeof(float32_t));
+	ir_file_name = (char*)AudioBasicMemArena::alloc(TCAB_IR_NAME_SIZE_BYTES);
 
 	if (!last_sample_buffer_L || !last_sample_buffer_R || !maskgen || 
 		!fftout || !wav_ir_data || !ir_file_name)
@@ -645,23 +683,26 @@ void AudioFilterIRCabsim_SD_F32::update()
 	if (!initialized) return;
 	audio_block_f32_t *blockL, *blockR;
 
-	blockL = AudioStream_F32::receiveWritable_f32(0);
-	blockR = AudioStream_F32::receiveWritable_f32(1);
-	if (!blockL || !blockR)
-	{
-		if (blockL) AudioStream_F32::release(blockL);
-		if (blockR) AudioStream_F32::release(blockR);
-		return;
-	}
 	if (!ir_loaded) // ir not loaded yet or bypass mode
 	{
-		// bypass clean signal
+		// bypass clean signal, read only blocks
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);
 		AudioStream_F32::transmit(blockL, 0);
 		AudioStream_F32::release(blockL);
 		AudioStream_F32::transmit(blockR, 1);
 		AudioStream_F32::release(blockR);
 		return;
 	}
+	blockL = AudioStream_F32::receiveWritable_f32(0);
+	blockR = AudioStream_F32::receiveWritable_f32(1);
+	if (!blockL || !blockR)
+	{
+		if (blockL) AudioStream_F32::release(blockL);
+		if (blockR) AudioStream_F32::release(blockR);
+		return;
+	}
 	// scale the input signal 
 	if (audio_gain != 1.0f)
 	{
@@ -928,7 +969,7 @@ FLASHMEM AudioFilterIRCabsim_SD_F32::ir_wav_result_t AudioFilterIRCabsim_SD_F32:
 bool AudioFilterIRCabsim_SD_F32::ir_load(float32_t* dataPtr, size_t dataLength)
 {
 	if ( dataLength > TCAB_IR_LEN_MAX_SAMPLES ) dataLength = TCAB_IR_LEN_MAX_SAMPLES;
-	ir_length_ms =  (1000.0f * dataLength) / AUDIO_SAMPLE_RATE_EXACT;
+	ir_length_ms =  (1000.0f * dataLength) / fs;
 	AudioNoInterrupts();
 	nfor = dataLength / TCAB_BUFFER_SIZE;
 	ptr_fmask = &fmask[0][0];
@@ -1058,7 +1099,7 @@ FLASHMEM AudioFilterIRCabsim_SD_F32::ir_wav_result_t AudioFilterIRCabsim_SD_F32:
 		uint8_t bytes_per_sample = (uint8_t)sd_read_u16(file);
 		bitdepth = (uint8_t)sd_read_u16(file);
 
-		if (sample_rate != (uint32_t)AUDIO_SAMPLE_RATE)
+		if (sample_rate != (uint32_t)fs)
 		{
 			return IR_WAV_ERR_BAD_FS;
 		}
@@ -31,6 +31,7 @@
 #include "basic_delay.h"
 #include "basic_shelvFilter.h"
 #include "basic_DSPutils.h"
+#include "basic_bypassStereo_F32.h"
 #include <arm_const_structs.h>
 
 
@@ -48,6 +49,7 @@ class AudioFilterIRCabsim_SD_F32 : public AudioStream_F32
 {
 public:
     AudioFilterIRCabsim_SD_F32();
+	AudioFilterIRCabsim_SD_F32(const AudioSettings_F32 &settings);
 	void begin();
     virtual void update(void);
 	
@@ -163,10 +165,11 @@ private:
     int buffidx = 0;
     int k = 0;
 	uint8_t fmask_idx = 0;
-	float32_t fmask[TCAB_NFORMAX][TCAB_FFT_LENGTH * 2];
-	float32_t ac2[512];
-	float32_t accum[TCAB_FFT_LENGTH * 2];
-	float32_t fftin[TCAB_FFT_LENGTH * 2];
+	// per block FFT working buffers, cache line aligned
+	ARENA_ALIGNED float32_t fmask[TCAB_NFORMAX][TCAB_FFT_LENGTH * 2];
+	ARENA_ALIGNED float32_t ac2[512];
+	ARENA_ALIGNED float32_t accum[TCAB_FFT_LENGTH * 2];
+	ARENA_ALIGNED float32_t fftin[TCAB_FFT_LENGTH * 2];
 	float32_t* last_sample_buffer_R;
 	float32_t* last_sample_buffer_L;
 	float32_t* maskgen;
@@ -185,12 +188,14 @@ private:
 	const arm_cfft_instance_f32 *S = &arm_cfft_sR_f32_len256;
 	const arm_cfft_instance_f32 *iS = &arm_cfft_sR_f32_len256;
 	
-	static const uint32_t delay_l = AUDIO_SAMPLE_RATE * 0.01277f; 	//12ms delay
+	static constexpr float32_t delay_time_s = 0.01277f; 	//12.77ms doubler delay
+	float32_t fs = AUDIO_SAMPLE_RATE_EXACT;
 	AudioBasicDelay delay;
 
 	float32_t ir_length_ms = 0.0f;
 	uint8_t ir_bitdepth = 24;
     void init_partitioned_filter_masks(const float32_t *irPtr);
+	void init();
 	bool initialized = false;
 	
 	// stereo doubler
@@ -199,31 +204,12 @@ private:
 	bool doubleTrack = false;
 	static const uint8_t nfir = 30;	// fir taps
 	arm_fir_instance_f32 FIR_preL, FIR_preR, FIR_postL, FIR_postR;
-	float32_t FIRstate[4][AUDIO_BLOCK_SAMPLES + nfir];
-	float32_t FIRk_preL[30] = {
-		 0.000894872763f,  0.00020902598f,  0.000285242248f,  0.000503875781f,  0.00207542209f,  0.0013392308f, 
-		-0.00476867426f,  -0.0112718018f,  -0.00560652791f,   0.0158470348f,    0.0319586769f,   0.0108086104f, 
-		-0.0470990688f,   -0.0834295526f,  -0.0208595414f,    0.154734746f,     0.35352844f,     0.441179603f, 
-		 0.35352844f,      0.154734746f,   -0.0208595414f,   -0.0834295526f,   -0.0470990688f,   0.0108086104f, 
-		 0.0319586769f,    0.0158470348f,  -0.00560652791f,  -0.0112718018f,   -0.00476867426f,  0.0013392308f };
-	float32_t FIRk_preR[30] = {
-		 0.00020902598f,   0.000285242248f, 0.000503875781f,  0.00207542209f,   0.0013392308f,  -0.00476867426f, 
-		-0.0112718018f,   -0.00560652791f,  0.0158470348f,    0.0319586769f,    0.0108086104f,  -0.0470990688f,
-		-0.0834295526f,   -0.0208595414f,   0.154734746f,     0.35352844f,      0.441179603f,    0.35352844f, 
-		 0.154734746f,    -0.0208595414f,  -0.0834295526f,   -0.0470990688f,    0.0108086104f,   0.0319586769f, 
-		 0.0158470348f,   -0.00560652791f, -0.0112718018f,   -0.00476867426f,   0.0013392308f,   0.00207542209f };
-	float32_t FIRk_postL[30] = {
-		 0.000285242248f,  0.000503875781f, 0.00207542209f,   0.0013392308f,   -0.00476867426f, -0.0112718018f,
-		-0.00560652791f,   0.0158470348f,   0.0319586769f,    0.0108086104f,   -0.0470990688f,  -0.0834295526f,
-		-0.0208595414f,    0.154734746f,    0.35352844f,      0.441179603f,     0.35352844f,     0.154734746f,
-		-0.0208595414f,   -0.0834295526f,  -0.0470990688f,    0.0108086104f,    0.0319586769f,   0.0158470348f,
-		-0.00560652791f,  -0.0112718018f,  -0.00476867426f,   0.0013392308f,    0.00207542209f,  0.000503875781f };
-	float32_t FIRk_postR[30] = {
-		 0.000503875781f,  0.00207542209f,  0.0013392308f,   -0.00476867426f,  -0.0112718018f,  -0.00560652791f, 
-		 0.0158470348f,    0.0319586769f,   0.0108086104f,   -0.0470990688f,   -0.0834295526f,  -0.0208595414f, 
-		 0.154734746f,     0.35352844f,     0.441179603f,     0.35352844f,      0.154734746f,   -0.0208595414f,
-		-0.0834295526f,   -0.0470990688f,   0.0108086104f,    0.0319586769f,    0.0158470348f,  -0.00560652791f, 
-		-0.0112718018f,   -0.00476867426f,  0.0013392308f,    0.00207542209f,   0.000503875781f, 0.0f };
+	ARENA_ALIGNED float32_t FIRstate[4][AUDIO_BLOCK_SAMPLES + nfir];
+	// stereo doubler filter kernels, shared by all instances
+	static const float32_t FIRk_preL[nfir];
+	static const float32_t FIRk_preR[nfir];
+	static const float32_t FIRk_postL[nfir];
+	static const float32_t FIRk_postR[nfir];
 
 	// ------------------- SD CARD -------------------------------------
 	static const char* off_msg;
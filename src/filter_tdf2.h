@@ -36,6 +36,7 @@
 #define _FILTER_TDF2_H_
 
 #include "arm_math.h"
+#include "basic_denormal.h"
 
 template <int N>
 class AudioFilterTDF2
@@ -74,7 +75,7 @@ public:
 			for (uint16_t j = 1; j < N; ++j)
 				h[j - 1] = h[j] + b[j] * in- a[j] * y;
 
-			h[N - 1] = b[N] * in - a[N] * y;
+			h[N - 1] = denormal_bias(b[N] * in - a[N] * y);
 			*dst++ = y;
 		}
 	}
@@ -67,17 +67,21 @@ AudioFilterToneStackStereo_F32 :: AudioFilterToneStackStereo_F32() : AudioStream
 	setModel(TONESTACK_OFF);
 }
 
+AudioFilterToneStackStereo_F32 :: AudioFilterToneStackStereo_F32(const AudioSettings_F32 &settings) : AudioStream_F32(2, inputQueueArray_f32)
+{
+	c = 2.0f * settings.sample_rate_Hz;
+	gain = 1.0f;
+	setModel(TONESTACK_OFF);
+}
+
 void AudioFilterToneStackStereo_F32::setModel(toneStack_presets_e m)
 {
 	if (m >= TONE_STACK_MAX_MODELS) return;
 	if (m == TONESTACK_OFF)
 	{
-		bp = true;
-		filterL.reset();
-		filterR.reset();
+		bypass_set(true);	// filters fade out, reset when switched on again
 		return;
 	}
-	bp = false;
 	currentModel = m - 1; 
 
 	float32_t 	R1 = presets[currentModel].R1, \
@@ -124,14 +128,25 @@ void AudioFilterToneStackStereo_F32::setModel(toneStack_presets_e m)
 	filterL.reset();
 	filterR.reset();
 	setTone(bass, mid, treble);
+	bypass_set(false);	// crossfade in with the new coefficients
 }
 
 void AudioFilterToneStackStereo_F32::update()
 {
 #if defined(__IMXRT1062__)
 	audio_block_f32_t *blockL, *blockR; 
-	float32_t g;
 
+	if (bpx.passThrough()) // bypass mode, pass the read only blocks
+	{
+		blockL = AudioStream_F32::receiveReadOnly_f32(0);
+		blockR = AudioStream_F32::receiveReadOnly_f32(1);
+		bypass_passThrough(&blockL, &blockR, BYPASS_MODE_PASS);
+        AudioStream_F32::transmit((audio_block_f32_t *)blockL,0);
+        AudioStream_F32::transmit((audio_block_f32_t *)blockR,1);
+        AudioStream_F32::release((audio_block_f32_t *)blockL);
+        AudioStream_F32::release((audio_block_f32_t *)blockR);
+		return;		
+	}
     blockL = AudioStream_F32::receiveWritable_f32(0);       // audio data
     blockR = AudioStream_F32::receiveWritable_f32(1);       // audio data
     if (!blockL || !blockR)
@@ -140,25 +155,28 @@ void AudioFilterToneStackStereo_F32::update()
         if (blockR) release((audio_block_f32_t *)blockR);		
         return;
     }
-	if (bp) // bypass mode
-	{
-        AudioStream_F32::transmit((audio_block_f32_t *)blockL,0);
-        AudioStream_F32::transmit((audio_block_f32_t *)blockR,1);
-        AudioStream_F32::release((audio_block_f32_t *)blockL);
-        AudioStream_F32::release((audio_block_f32_t *)blockR);
-		return;		
-	}
-	filterL.process(blockL->data, blockL->data, blockL->length);
-	filterR.process(blockR->data, blockR->data, blockR->length);
-	g = gain * gain_k;
-	if (g != 1.0f)
-	{
-		arm_scale_f32(blockL->data, gain, blockL->data, blockL->length);
-		arm_scale_f32(blockR->data, gain, blockR->data, blockR->length);
-	}
+	process(blockL->data, blockR->data, blockL->length);
     AudioStream_F32::transmit(blockL, 0);
     AudioStream_F32::transmit(blockR, 1);
 	AudioStream_F32::release(blockL);
     AudioStream_F32::release(blockR);	
 #endif
 }
+
+void AudioFilterToneStackStereo_F32::process(float32_t *dataL, float32_t *dataR, uint32_t len)
+{
+	AudioBasicDenormalGuard ftz;
+	float32_t g;
+
+	if (bpx.passThrough()) return;
+	bpx.storeDry(dataL, dataR, len);	// only during the bypass crossfade
+	filterL.process(dataL, dataL, len);
+	filterR.process(dataR, dataR, len);
+	g = gain * gain_k;
+	if (g != 1.0f)
+	{
+		arm_scale_f32(dataL, gain, dataL, len);
+		arm_scale_f32(dataR, gain, dataR, len);
+	}
+	bpx.process(dataL, dataR, len);
+}
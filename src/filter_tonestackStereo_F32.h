@@ -38,6 +38,9 @@
 #include "AudioStream_F32.h"
 #include "filter_tdf2.h"
 #include "arm_math.h"
+#include "basic_denormal.h"
+#include "basic_bypassStereo_F32.h"
+#include "basic_effectKernel_F32.h"
 
 #define TONE_STACK_MAX_MODELS (10)
 
@@ -55,12 +58,14 @@ typedef enum
 	TONESTACK_PIGNOSE
 }toneStack_presets_e;
 
-class AudioFilterToneStackStereo_F32 : public AudioStream_F32
+class AudioFilterToneStackStereo_F32 : public AudioStream_F32, public AudioEffectKernel_F32
 {
 public:
 	AudioFilterToneStackStereo_F32();
+	AudioFilterToneStackStereo_F32(const AudioSettings_F32 &settings);
 	~AudioFilterToneStackStereo_F32(){};
 	virtual void update(void);
+	void process(float32_t *dataL, float32_t *dataR, uint32_t len);
 
 	typedef struct
 	{
@@ -88,7 +93,7 @@ public:
 	 */
 	const char *getName()
 	{ 
-		if (bp) return "OFF";
+		if (bpx.get()) return "OFF";
 		else 	return presets[currentModel].name;
 	}
 
@@ -177,16 +182,39 @@ public:
 		gain = g;
 		__enable_irq();
 	}
-	bool getBypass() {return bp;}
+	bool getBypass() {return bpx.get();}
+	/**
+	 * @brief bypass the tone stack, the last model is restored when switched on
+	 * 			Switching is crossfaded over a number of audio blocks.
+	 */
+	bool bypass_get(void) {return bpx.get();}
+	void bypass_set(bool state)
+	{
+		if (!state && bpx.passThrough())	// filters were idle, start from zero state
+		{
+			filterL.reset();
+			filterR.reset();
+		}
+		bpx.set(state);
+	}
+	bool bypass_tgl(void) 
+	{
+		bypass_set(bpx.get() ^ 1);
+		return bpx.get();
+	}
+	/**
+	 * @brief bypass crossfade length in audio blocks
+	 */
+	void bypass_setFade(uint16_t blocks) {bpx.setFadeBlocks(blocks);}
 
 private:
 	static const uint8_t order = 3;
 	AudioFilterTDF2<order> filterL;
 	AudioFilterTDF2<order> filterR;
 	audio_block_f32_t *inputQueueArray_f32[2];
-	bool bp = false;		// bypass
+	AudioBasicBypassXfade bpx;	// crossfading bypass, the constructor sets TONESTACK_OFF
 	uint8_t currentModel;
-	float32_t c = 2.0f * AUDIO_SAMPLE_RATE;
+	float32_t c = 2.0f * AUDIO_SAMPLE_RATE_EXACT;	// bilinear transform constant, 2*fs
 	float32_t b1t, b1m, b1l, b1d,
 		b2t, b2m2, b2m, b2l, b2lm, b2d,
 		b3lm, b3m2, b3m, b3t, b3tm, b3tl,
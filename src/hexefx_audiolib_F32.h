@@ -32,9 +32,12 @@
 #include "effect_phaserStereo_F32.h"
 #include "effect_noiseGateStereo_F32.h"
 #include "effect_delaystereo_F32.h"
+#include "effect_multitapDelay_F32.h"
 #include "effect_compressorStereo_F32.h"
+#include "effect_compressorMultibandStereo_F32.h"
 #include "effect_guitarBooster_F32.h"
 #include "effect_xfaderStereo_F32.h"
 #include "effect_wahMono_F32.h"
+#include "effect_chain_F32.h"
 
 #endif // _HEXEFX_AUDIOLIB_F32_H